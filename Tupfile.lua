@@ -356,7 +356,7 @@ src = {
 for module, enabled in pairs(config.modules) do
   if enabled then
     override = {
-      audio = 'src/modules/audio/audio.c',
+      audio = { 'src/modules/audio/audio.c', 'src/modules/audio/resampler.c' },
       headset = 'src/modules/headset/headset.c'
     }
     src += override[module] or ('src/modules/%s/*.c'):format(module)
@@ -183,7 +183,6 @@ function lovr.run()
       lovr.graphics.present()
     end
     if lovr.headset then lovr.headset.submit() end
-    if lovr.math then lovr.math.drain() end
   end
 end
 
@@ -284,8 +283,6 @@ function lovr.errhand(message)
         lovr.graphics.present()
       end
     end
-
-    lovr.math.drain()
   end
 end
 
@@ -326,6 +323,7 @@ return coroutine.create(function()
 
   while true do
     local ok, result, cookie = xpcall(thread, onerror)
+    if lovr.math then lovr.math.drain() end
     if not ok then thread = result
     elseif result then return result, cookie end
     coroutine.yield()
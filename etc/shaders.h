@@ -11,6 +11,9 @@
 #include "shaders/animator.comp.h"
 #include "shaders/blender.comp.h"
 #include "shaders/tallymerge.comp.h"
+#include "shaders/pyramid.comp.h"
+#include "shaders/cull.comp.h"
+#include "shaders/frustum.comp.h"
 
 #include "shaders/lovr.glsl.h"
 
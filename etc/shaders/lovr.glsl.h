@@ -0,0 +1,2 @@
+const unsigned char etc_shaders_lovr_glsl[] = {0x2f,0x2f,0x20,0x46,0x6c,0x61,0x67,0x73,0x0a,0x23,0x69,0x66,0x6e,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x43,0x4f,0x4d,0x50,0x55,0x54,0x45,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x30,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x66,0x6c,0x61,0x67,0x5f,0x70,0x6f,0x69,0x6e,0x74,0x53,0x69,0x7a,0x65,0x20,0x3d,0x20,0x31,0x2e,0x66,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x32,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x70,0x61,0x73,0x73,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x33,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x6d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x34,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x76,0x65,0x72,0x74,0x65,0x78,0x43,0x6f,0x6c,0x6f,0x72,0x73,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x35,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x75,0x76,0x54,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x36,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x61,0x6c,0x70,0x68,0x61,0x43,0x75,0x74,0x6f,0x66,0x66,0x20,0x3d,0x20,0x66,0x61,0x6c,0x73,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x37,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x67,0x6c,0x6f,0x77,0x20,0x3d,0x20,0x66,0x61,0x6c,0x73,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x38,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x4d,0x61,0x70,0x20,0x3d,0x20,0x66,0x61,0x6c,0x73,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x30,0x39,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x76,0x65,0x72,0x74,0x65,0x78,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x73,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x31,0x30,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x31,0x31,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x67,0x6c,0x6f,0x77,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x31,0x32,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x31,0x33,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x31,0x34,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x61,0x6d,0x62,0x69,0x65,0x6e,0x74,0x4f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x74,0x72,0x75,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x31,0x35,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x20,0x3d,0x20,0x66,0x61,0x6c,0x73,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x5f,0x69,0x64,0x20,0x3d,0x20,0x31,0x30,0x31,0x36,0x29,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x66,0x6c,0x61,0x67,0x5f,0x74,0x6f,0x6e,0x65,0x6d,0x61,0x70,0x20,0x3d,0x20,0x66,0x61,0x6c,0x73,0x65,0x3b,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x2f,0x2f,0x20,0x52,0x65,0x73,0x6f,0x75,0x72,0x63,0x65,0x73,0x0a,0x23,0x69,0x66,0x6e,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x43,0x4f,0x4d,0x50,0x55,0x54,0x45,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x20,0x7b,0x0a,0x20,0x20,0x6d,0x61,0x74,0x34,0x20,0x76,0x69,0x65,0x77,0x3b,0x0a,0x20,0x20,0x6d,0x61,0x74,0x34,0x20,0x70,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x6d,0x61,0x74,0x34,0x20,0x76,0x69,0x65,0x77,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x6d,0x61,0x74,0x34,0x20,0x69,0x6e,0x76,0x65,0x72,0x73,0x65,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x44,0x72,0x61,0x77,0x20,0x7b,0x0a,0x20,0x20,0x6d,0x61,0x74,0x34,0x78,0x33,0x20,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x30,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x30,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x47,0x6c,0x6f,0x62,0x61,0x6c,0x73,0x20,0x7b,0x20,0x76,0x65,0x63,0x32,0x20,0x52,0x65,0x73,0x6f,0x6c,0x75,0x74,0x69,0x6f,0x6e,0x3b,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x54,0x69,0x6d,0x65,0x3b,0x20,0x7d,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x30,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x31,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x42,0x75,0x66,0x66,0x65,0x72,0x20,0x7b,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x73,0x5b,0x36,0x5d,0x3b,0x20,0x7d,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x30,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x32,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x44,0x72,0x61,0x77,0x42,0x75,0x66,0x66,0x65,0x72,0x20,0x7b,0x20,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,0x72,0x29,0x20,0x44,0x72,0x61,0x77,0x20,0x44,0x72,0x61,0x77,0x73,0x5b,0x32,0x35,0x36,0x5d,0x3b,0x20,0x7d,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x30,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x33,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x44,0x61,0x74,0x61,0x20,0x7b,0x0a,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x67,0x6c,0x6f,0x77,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,0x53,0x68,0x69,0x66,0x74,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,0x53,0x63,0x61,0x6c,0x65,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x73,0x64,0x66,0x52,0x61,0x6e,0x67,0x65,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x53,0x74,0x72,0x65,0x6e,0x67,0x74,0x68,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x53,0x63,0x61,0x6c,0x65,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x61,0x6c,0x70,0x68,0x61,0x43,0x75,0x74,0x6f,0x66,0x66,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x31,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x30,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x42,0x75,0x66,0x66,0x65,0x72,0x20,0x7b,0x0a,0x20,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x44,0x61,0x74,0x61,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x31,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x31,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x31,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x32,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x20,0x47,0x6c,0x6f,0x77,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x31,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x33,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x20,0x4d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x31,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x34,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x20,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x31,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x35,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x20,0x43,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x31,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x36,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x20,0x4f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x73,0x65,0x74,0x20,0x3d,0x20,0x31,0x2c,0x20,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x37,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x20,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x3b,0x0a,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x70,0x75,0x73,0x68,0x5f,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x50,0x75,0x73,0x68,0x43,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x73,0x20,0x7b,0x0a,0x20,0x20,0x75,0x69,0x6e,0x74,0x20,0x44,0x72,0x61,0x77,0x49,0x44,0x3b,0x0a,0x7d,0x3b,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x2f,0x2f,0x20,0x41,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x73,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x56,0x45,0x52,0x54,0x45,0x58,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x30,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x31,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x33,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x32,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x55,0x56,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x33,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x34,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x3b,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x2f,0x2f,0x20,0x46,0x72,0x61,0x6d,0x65,0x62,0x75,0x66,0x66,0x65,0x72,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x46,0x52,0x41,0x47,0x4d,0x45,0x4e,0x54,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,0x20,0x50,0x69,0x78,0x65,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x2f,0x2f,0x20,0x56,0x61,0x72,0x79,0x69,0x6e,0x67,0x73,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x56,0x45,0x52,0x54,0x45,0x58,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x30,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x33,0x20,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x31,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x33,0x20,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x32,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x32,0x20,0x55,0x56,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x33,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x34,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,0x20,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x3b,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x46,0x52,0x41,0x47,0x4d,0x45,0x4e,0x54,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x30,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x33,0x20,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x31,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x33,0x20,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x32,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x55,0x56,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x33,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x34,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x3b,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x2f,0x2f,0x20,0x42,0x75,0x69,0x6c,0x74,0x69,0x6e,0x73,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x43,0x4f,0x4d,0x50,0x55,0x54,0x45,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x53,0x75,0x62,0x67,0x72,0x6f,0x75,0x70,0x43,0x6f,0x75,0x6e,0x74,0x20,0x67,0x6c,0x5f,0x4e,0x75,0x6d,0x53,0x75,0x62,0x67,0x72,0x6f,0x75,0x70,0x73,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x57,0x6f,0x72,0x6b,0x67,0x72,0x6f,0x75,0x70,0x43,0x6f,0x75,0x6e,0x74,0x20,0x67,0x6c,0x5f,0x4e,0x75,0x6d,0x57,0x6f,0x72,0x6b,0x47,0x72,0x6f,0x75,0x70,0x73,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x57,0x6f,0x72,0x6b,0x67,0x72,0x6f,0x75,0x70,0x53,0x69,0x7a,0x65,0x20,0x67,0x6c,0x5f,0x57,0x6f,0x72,0x6b,0x47,0x72,0x6f,0x75,0x70,0x53,0x69,0x7a,0x65,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x57,0x6f,0x72,0x6b,0x67,0x72,0x6f,0x75,0x70,0x49,0x44,0x20,0x67,0x6c,0x5f,0x57,0x6f,0x72,0x6b,0x47,0x72,0x6f,0x75,0x70,0x49,0x44,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x47,0x6c,0x6f,0x62,0x61,0x6c,0x54,0x68,0x72,0x65,0x61,0x64,0x49,0x44,0x20,0x67,0x6c,0x5f,0x47,0x6c,0x6f,0x62,0x61,0x6c,0x49,0x6e,0x76,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x49,0x44,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x4c,0x6f,0x63,0x61,0x6c,0x54,0x68,0x72,0x65,0x61,0x64,0x49,0x44,0x20,0x67,0x6c,0x5f,0x4c,0x6f,0x63,0x61,0x6c,0x49,0x6e,0x76,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x49,0x44,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x4c,0x6f,0x63,0x61,0x6c,0x54,0x68,0x72,0x65,0x61,0x64,0x49,0x6e,0x64,0x65,0x78,0x20,0x67,0x6c,0x5f,0x4c,0x6f,0x63,0x61,0x6c,0x49,0x6e,0x76,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x49,0x6e,0x64,0x65,0x78,0x0a,0x23,0x65,0x6c,0x73,0x65,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x43,0x6c,0x69,0x70,0x44,0x69,0x73,0x74,0x61,0x6e,0x63,0x65,0x20,0x67,0x6c,0x5f,0x43,0x6c,0x69,0x70,0x44,0x69,0x73,0x74,0x61,0x6e,0x63,0x65,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x43,0x75,0x6c,0x6c,0x44,0x69,0x73,0x74,0x61,0x6e,0x63,0x65,0x20,0x67,0x6c,0x5f,0x43,0x75,0x6c,0x6c,0x44,0x69,0x73,0x74,0x61,0x6e,0x63,0x65,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x50,0x72,0x69,0x6d,0x69,0x74,0x69,0x76,0x65,0x49,0x44,0x20,0x67,0x6c,0x5f,0x50,0x72,0x69,0x6d,0x69,0x74,0x69,0x76,0x65,0x49,0x44,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x56,0x69,0x65,0x77,0x49,0x6e,0x64,0x65,0x78,0x20,0x67,0x6c,0x5f,0x56,0x69,0x65,0x77,0x49,0x6e,0x64,0x65,0x78,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x56,0x45,0x52,0x54,0x45,0x58,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x42,0x61,0x73,0x65,0x49,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x20,0x67,0x6c,0x5f,0x42,0x61,0x73,0x65,0x49,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x42,0x61,0x73,0x65,0x56,0x65,0x72,0x74,0x65,0x78,0x20,0x67,0x6c,0x5f,0x42,0x61,0x73,0x65,0x56,0x65,0x72,0x74,0x65,0x78,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x44,0x72,0x61,0x77,0x49,0x6e,0x64,0x65,0x78,0x20,0x67,0x6c,0x5f,0x44,0x72,0x61,0x77,0x49,0x6e,0x64,0x65,0x78,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x49,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x49,0x6e,0x64,0x65,0x78,0x20,0x67,0x6c,0x5f,0x49,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x49,0x6e,0x64,0x65,0x78,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x50,0x6f,0x69,0x6e,0x74,0x53,0x69,0x7a,0x65,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x69,0x6e,0x74,0x53,0x69,0x7a,0x65,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x49,0x6e,0x64,0x65,0x78,0x20,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,0x6e,0x64,0x65,0x78,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x46,0x52,0x41,0x47,0x4d,0x45,0x4e,0x54,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x46,0x72,0x61,0x67,0x43,0x6f,0x6f,0x72,0x64,0x20,0x67,0x6c,0x5f,0x46,0x72,0x61,0x67,0x43,0x6f,0x6f,0x72,0x64,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x46,0x72,0x61,0x67,0x44,0x65,0x70,0x74,0x68,0x20,0x67,0x6c,0x5f,0x46,0x72,0x61,0x67,0x44,0x65,0x70,0x74,0x68,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x46,0x72,0x6f,0x6e,0x74,0x46,0x61,0x63,0x69,0x6e,0x67,0x20,0x67,0x6c,0x5f,0x46,0x72,0x6f,0x6e,0x74,0x46,0x61,0x63,0x69,0x6e,0x67,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x50,0x6f,0x69,0x6e,0x74,0x43,0x6f,0x6f,0x72,0x64,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x69,0x6e,0x74,0x43,0x6f,0x6f,0x72,0x64,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x49,0x44,0x20,0x67,0x6c,0x5f,0x53,0x61,0x6d,0x70,0x6c,0x65,0x49,0x44,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x4d,0x61,0x73,0x6b,0x49,0x6e,0x20,0x67,0x6c,0x5f,0x53,0x61,0x6d,0x70,0x6c,0x65,0x4d,0x61,0x73,0x6b,0x49,0x6e,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x4d,0x61,0x73,0x6b,0x20,0x67,0x6c,0x5f,0x53,0x61,0x6d,0x70,0x6c,0x65,0x4d,0x61,0x73,0x6b,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x67,0x6c,0x5f,0x53,0x61,0x6d,0x70,0x6c,0x65,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x2f,0x2f,0x20,0x43,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x73,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x50,0x49,0x20,0x33,0x2e,0x31,0x34,0x31,0x35,0x39,0x32,0x36,0x35,0x33,0x35,0x38,0x39,0x37,0x39,0x33,0x32,0x33,0x38,0x34,0x36,0x32,0x36,0x34,0x33,0x33,0x38,0x33,0x32,0x37,0x39,0x35,0x30,0x32,0x66,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x54,0x41,0x55,0x20,0x28,0x32,0x2e,0x66,0x20,0x2a,0x20,0x50,0x49,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x50,0x49,0x5f,0x32,0x20,0x28,0x2e,0x35,0x66,0x20,0x2a,0x20,0x50,0x49,0x29,0x0a,0x0a,0x2f,0x2f,0x20,0x48,0x65,0x6c,0x70,0x65,0x72,0x73,0x0a,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x43,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x73,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x44,0x65,0x66,0x61,0x75,0x6c,0x74,0x55,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x42,0x6c,0x6f,0x63,0x6b,0x0a,0x0a,0x23,0x69,0x66,0x6e,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x43,0x4f,0x4d,0x50,0x55,0x54,0x45,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x73,0x5b,0x56,0x69,0x65,0x77,0x49,0x6e,0x64,0x65,0x78,0x5d,0x2e,0x70,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x56,0x69,0x65,0x77,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x73,0x5b,0x56,0x69,0x65,0x77,0x49,0x6e,0x64,0x65,0x78,0x5d,0x2e,0x76,0x69,0x65,0x77,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x56,0x69,0x65,0x77,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x73,0x5b,0x56,0x69,0x65,0x77,0x49,0x6e,0x64,0x65,0x78,0x5d,0x2e,0x76,0x69,0x65,0x77,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x49,0x6e,0x76,0x65,0x72,0x73,0x65,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x73,0x5b,0x56,0x69,0x65,0x77,0x49,0x6e,0x64,0x65,0x78,0x5d,0x2e,0x69,0x6e,0x76,0x65,0x72,0x73,0x65,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x43,0x61,0x6d,0x65,0x72,0x61,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x20,0x28,0x2d,0x56,0x69,0x65,0x77,0x5b,0x33,0x5d,0x2e,0x78,0x79,0x7a,0x20,0x2a,0x20,0x6d,0x61,0x74,0x33,0x28,0x56,0x69,0x65,0x77,0x29,0x29,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x56,0x45,0x52,0x54,0x45,0x58,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x54,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x20,0x6d,0x61,0x74,0x34,0x28,0x44,0x72,0x61,0x77,0x73,0x5b,0x44,0x72,0x61,0x77,0x49,0x44,0x5d,0x2e,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x4d,0x61,0x74,0x72,0x69,0x78,0x20,0x28,0x63,0x6f,0x66,0x61,0x63,0x74,0x6f,0x72,0x33,0x28,0x44,0x72,0x61,0x77,0x73,0x5b,0x44,0x72,0x61,0x77,0x49,0x44,0x5d,0x2e,0x74,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x29,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x50,0x61,0x73,0x73,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x44,0x72,0x61,0x77,0x73,0x5b,0x44,0x72,0x61,0x77,0x49,0x44,0x5d,0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x43,0x6c,0x69,0x70,0x46,0x72,0x6f,0x6d,0x4c,0x6f,0x63,0x61,0x6c,0x20,0x28,0x56,0x69,0x65,0x77,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x20,0x2a,0x20,0x54,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x43,0x6c,0x69,0x70,0x46,0x72,0x6f,0x6d,0x57,0x6f,0x72,0x6c,0x64,0x20,0x28,0x56,0x69,0x65,0x77,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x43,0x6c,0x69,0x70,0x46,0x72,0x6f,0x6d,0x56,0x69,0x65,0x77,0x20,0x28,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x56,0x69,0x65,0x77,0x46,0x72,0x6f,0x6d,0x4c,0x6f,0x63,0x61,0x6c,0x20,0x28,0x56,0x69,0x65,0x77,0x20,0x2a,0x20,0x54,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x56,0x69,0x65,0x77,0x46,0x72,0x6f,0x6d,0x57,0x6f,0x72,0x6c,0x64,0x20,0x28,0x56,0x69,0x65,0x77,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x56,0x69,0x65,0x77,0x46,0x72,0x6f,0x6d,0x43,0x6c,0x69,0x70,0x20,0x28,0x49,0x6e,0x76,0x65,0x72,0x73,0x65,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x57,0x6f,0x72,0x6c,0x64,0x46,0x72,0x6f,0x6d,0x4c,0x6f,0x63,0x61,0x6c,0x20,0x28,0x54,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x57,0x6f,0x72,0x6c,0x64,0x46,0x72,0x6f,0x6d,0x56,0x69,0x65,0x77,0x20,0x28,0x69,0x6e,0x76,0x65,0x72,0x73,0x65,0x28,0x56,0x69,0x65,0x77,0x29,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x57,0x6f,0x72,0x6c,0x64,0x46,0x72,0x6f,0x6d,0x43,0x6c,0x69,0x70,0x20,0x28,0x69,0x6e,0x76,0x65,0x72,0x73,0x65,0x28,0x56,0x69,0x65,0x77,0x50,0x72,0x6f,0x6a,0x65,0x63,0x74,0x69,0x6f,0x6e,0x29,0x29,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x44,0x65,0x66,0x61,0x75,0x6c,0x74,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x28,0x43,0x6c,0x69,0x70,0x46,0x72,0x6f,0x6d,0x4c,0x6f,0x63,0x61,0x6c,0x20,0x2a,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x29,0x0a,0x0a,0x6d,0x61,0x74,0x33,0x20,0x63,0x6f,0x66,0x61,0x63,0x74,0x6f,0x72,0x33,0x28,0x6d,0x61,0x74,0x34,0x78,0x33,0x20,0x6d,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6d,0x61,0x74,0x33,0x28,0x76,0x65,0x63,0x33,0x28,0x0a,0x20,0x20,0x20,0x20,0x20,0x28,0x6d,0x5b,0x31,0x5d,0x5b,0x31,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x32,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x31,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x32,0x5d,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x2d,0x28,0x6d,0x5b,0x31,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x32,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x32,0x5d,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x20,0x28,0x6d,0x5b,0x31,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x31,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x31,0x5d,0x29,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x0a,0x20,0x20,0x20,0x20,0x2d,0x28,0x6d,0x5b,0x30,0x5d,0x5b,0x31,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x32,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x31,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x30,0x5d,0x5b,0x32,0x5d,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x20,0x28,0x6d,0x5b,0x30,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x32,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x30,0x5d,0x5b,0x32,0x5d,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x2d,0x28,0x6d,0x5b,0x30,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x31,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x32,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x30,0x5d,0x5b,0x31,0x5d,0x29,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x0a,0x20,0x20,0x20,0x20,0x20,0x28,0x6d,0x5b,0x30,0x5d,0x5b,0x31,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x32,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x31,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x30,0x5d,0x5b,0x32,0x5d,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x2d,0x28,0x6d,0x5b,0x30,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x32,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x30,0x5d,0x5b,0x32,0x5d,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x20,0x28,0x6d,0x5b,0x30,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x31,0x5d,0x20,0x2d,0x20,0x6d,0x5b,0x31,0x5d,0x5b,0x30,0x5d,0x20,0x2a,0x20,0x6d,0x5b,0x30,0x5d,0x5b,0x31,0x5d,0x29,0x0a,0x20,0x20,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x46,0x52,0x41,0x47,0x4d,0x45,0x4e,0x54,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x44,0x65,0x66,0x61,0x75,0x6c,0x74,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x20,0x3f,0x20,0x28,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x2a,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x43,0x6f,0x6c,0x6f,0x72,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x29,0x20,0x3a,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x29,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x2f,0x2f,0x20,0x48,0x65,0x6c,0x70,0x65,0x72,0x20,0x66,0x6f,0x72,0x20,0x73,0x61,0x6d,0x70,0x6c,0x69,0x6e,0x67,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x73,0x20,0x75,0x73,0x69,0x6e,0x67,0x20,0x74,0x68,0x65,0x20,0x64,0x65,0x66,0x61,0x75,0x6c,0x74,0x20,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x20,0x73,0x65,0x74,0x20,0x75,0x73,0x69,0x6e,0x67,0x20,0x50,0x61,0x73,0x73,0x3a,0x73,0x65,0x74,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x0a,0x23,0x69,0x66,0x6e,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x43,0x4f,0x4d,0x50,0x55,0x54,0x45,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x32,0x44,0x28,0x74,0x2c,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x29,0x2c,0x20,0x75,0x76,0x29,0x3b,0x20,0x7d,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x33,0x44,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x33,0x20,0x75,0x76,0x77,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x33,0x44,0x28,0x74,0x2c,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x29,0x2c,0x20,0x75,0x76,0x77,0x29,0x3b,0x20,0x7d,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x43,0x75,0x62,0x65,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x69,0x72,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x43,0x75,0x62,0x65,0x28,0x74,0x2c,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x29,0x2c,0x20,0x64,0x69,0x72,0x29,0x3b,0x20,0x7d,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x41,0x72,0x72,0x61,0x79,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6c,0x61,0x79,0x65,0x72,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x32,0x44,0x41,0x72,0x72,0x61,0x79,0x28,0x74,0x2c,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x75,0x76,0x2c,0x20,0x6c,0x61,0x79,0x65,0x72,0x29,0x29,0x3b,0x20,0x7d,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x43,0x75,0x62,0x65,0x41,0x72,0x72,0x61,0x79,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x6f,0x6f,0x72,0x64,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x43,0x75,0x62,0x65,0x41,0x72,0x72,0x61,0x79,0x28,0x74,0x2c,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x29,0x2c,0x20,0x63,0x6f,0x6f,0x72,0x64,0x29,0x3b,0x20,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x32,0x44,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x74,0x2c,0x20,0x75,0x76,0x29,0x3b,0x20,0x7d,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x33,0x44,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x33,0x20,0x75,0x76,0x77,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x74,0x2c,0x20,0x75,0x76,0x77,0x29,0x3b,0x20,0x7d,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x43,0x75,0x62,0x65,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x69,0x72,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x74,0x2c,0x20,0x64,0x69,0x72,0x29,0x3b,0x20,0x7d,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x32,0x44,0x41,0x72,0x72,0x61,0x79,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6c,0x61,0x79,0x65,0x72,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x74,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x75,0x76,0x2c,0x20,0x6c,0x61,0x79,0x65,0x72,0x29,0x29,0x3b,0x20,0x7d,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x43,0x75,0x62,0x65,0x41,0x72,0x72,0x61,0x79,0x20,0x74,0x2c,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x6f,0x6f,0x72,0x64,0x29,0x20,0x7b,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x74,0x2c,0x20,0x63,0x6f,0x6f,0x72,0x64,0x29,0x3b,0x20,0x7d,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x46,0x52,0x41,0x47,0x4d,0x45,0x4e,0x54,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x2f,0x2f,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x63,0x6f,0x6e,0x74,0x61,0x69,0x6e,0x73,0x20,0x61,0x6c,0x6c,0x20,0x6c,0x69,0x67,0x68,0x74,0x2d,0x69,0x6e,0x64,0x65,0x70,0x65,0x6e,0x64,0x65,0x6e,0x74,0x20,0x64,0x61,0x74,0x61,0x20,0x6e,0x65,0x65,0x64,0x65,0x64,0x20,0x66,0x6f,0x72,0x20,0x73,0x68,0x61,0x64,0x69,0x6e,0x67,0x2e,0x20,0x20,0x49,0x74,0x20,0x63,0x61,0x6e,0x20,0x62,0x65,0x20,0x63,0x61,0x6c,0x63,0x75,0x6c,0x61,0x74,0x65,0x64,0x20,0x6f,0x6e,0x63,0x65,0x20,0x70,0x65,0x72,0x0a,0x2f,0x2f,0x20,0x70,0x69,0x78,0x65,0x6c,0x20,0x61,0x6e,0x64,0x20,0x72,0x65,0x75,0x73,0x65,0x64,0x20,0x66,0x6f,0x72,0x20,0x6d,0x75,0x6c,0x74,0x69,0x70,0x6c,0x65,0x20,0x6c,0x69,0x67,0x68,0x74,0x73,0x2e,0x20,0x20,0x49,0x74,0x20,0x73,0x74,0x6f,0x72,0x65,0x73,0x20,0x69,0x6e,0x66,0x6f,0x72,0x6d,0x61,0x74,0x69,0x6f,0x6e,0x20,0x66,0x72,0x6f,0x6d,0x20,0x74,0x68,0x65,0x20,0x76,0x65,0x72,0x74,0x65,0x78,0x20,0x73,0x68,0x61,0x64,0x65,0x72,0x20,0x61,0x6e,0x64,0x20,0x6d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x0a,0x2f,0x2f,0x20,0x69,0x6e,0x70,0x75,0x74,0x73,0x2e,0x20,0x20,0x54,0x68,0x65,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x63,0x61,0x6e,0x20,0x62,0x65,0x20,0x69,0x6e,0x69,0x74,0x69,0x61,0x6c,0x69,0x7a,0x65,0x64,0x20,0x75,0x73,0x69,0x6e,0x67,0x20,0x69,0x6e,0x69,0x74,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x61,0x6e,0x64,0x20,0x69,0x73,0x20,0x70,0x61,0x73,0x73,0x65,0x64,0x20,0x69,0x6e,0x74,0x6f,0x20,0x74,0x68,0x65,0x20,0x6f,0x74,0x68,0x65,0x72,0x20,0x6c,0x69,0x67,0x68,0x74,0x69,0x6e,0x67,0x0a,0x2f,0x2f,0x20,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x73,0x2e,0x20,0x20,0x45,0x76,0x65,0x72,0x79,0x74,0x68,0x69,0x6e,0x67,0x20,0x69,0x73,0x20,0x69,0x6e,0x20,0x77,0x6f,0x72,0x6c,0x64,0x20,0x73,0x70,0x61,0x63,0x65,0x2e,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x7b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x20,0x2f,0x2f,0x20,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x6f,0x66,0x20,0x66,0x72,0x61,0x67,0x6d,0x65,0x6e,0x74,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x20,0x2f,0x2f,0x20,0x49,0x6e,0x63,0x6c,0x75,0x64,0x65,0x73,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x6d,0x61,0x70,0x70,0x69,0x6e,0x67,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x67,0x65,0x6f,0x6d,0x65,0x74,0x72,0x69,0x63,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x20,0x2f,0x2f,0x20,0x52,0x61,0x77,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x66,0x72,0x6f,0x6d,0x20,0x76,0x65,0x72,0x74,0x65,0x78,0x20,0x73,0x68,0x61,0x64,0x65,0x72,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x76,0x69,0x65,0x77,0x3b,0x20,0x2f,0x2f,0x20,0x54,0x68,0x65,0x20,0x64,0x69,0x72,0x65,0x63,0x74,0x69,0x6f,0x6e,0x20,0x66,0x72,0x6f,0x6d,0x20,0x74,0x68,0x65,0x20,0x66,0x72,0x61,0x67,0x6d,0x65,0x6e,0x74,0x20,0x74,0x6f,0x20,0x74,0x68,0x65,0x20,0x63,0x61,0x6d,0x65,0x72,0x61,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x72,0x65,0x66,0x6c,0x65,0x63,0x74,0x69,0x6f,0x6e,0x3b,0x20,0x2f,0x2f,0x20,0x54,0x68,0x65,0x20,0x76,0x69,0x65,0x77,0x20,0x76,0x65,0x63,0x74,0x6f,0x72,0x20,0x72,0x65,0x66,0x6c,0x65,0x63,0x74,0x65,0x64,0x20,0x61,0x62,0x6f,0x75,0x74,0x20,0x74,0x68,0x65,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x0a,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x66,0x30,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x69,0x66,0x66,0x75,0x73,0x65,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x65,0x6d,0x69,0x73,0x73,0x69,0x76,0x65,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x62,0x61,0x73,0x65,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x32,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x23,0x64,0x65,0x66,0x69,0x6e,0x65,0x20,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x4d,0x61,0x74,0x72,0x69,0x78,0x20,0x67,0x65,0x74,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x4d,0x61,0x74,0x72,0x69,0x78,0x28,0x29,0x0a,0x0a,0x6d,0x61,0x74,0x33,0x20,0x67,0x65,0x74,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x4d,0x61,0x74,0x72,0x69,0x78,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x76,0x65,0x72,0x74,0x65,0x78,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x73,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x4e,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x54,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x78,0x79,0x7a,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x42,0x20,0x3d,0x20,0x63,0x72,0x6f,0x73,0x73,0x28,0x4e,0x2c,0x20,0x54,0x29,0x20,0x2a,0x20,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x77,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6d,0x61,0x74,0x33,0x28,0x54,0x2c,0x20,0x42,0x2c,0x20,0x4e,0x29,0x3b,0x0a,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x2f,0x2f,0x20,0x68,0x74,0x74,0x70,0x3a,0x2f,0x2f,0x77,0x77,0x77,0x2e,0x74,0x68,0x65,0x74,0x65,0x6e,0x74,0x68,0x70,0x6c,0x61,0x6e,0x65,0x74,0x2e,0x64,0x65,0x2f,0x61,0x72,0x63,0x68,0x69,0x76,0x65,0x73,0x2f,0x31,0x31,0x38,0x30,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x4e,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x70,0x31,0x20,0x3d,0x20,0x64,0x46,0x64,0x78,0x28,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x70,0x32,0x20,0x3d,0x20,0x64,0x46,0x64,0x79,0x28,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x64,0x75,0x76,0x31,0x20,0x3d,0x20,0x64,0x46,0x64,0x78,0x28,0x55,0x56,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x64,0x75,0x76,0x32,0x20,0x3d,0x20,0x64,0x46,0x64,0x79,0x28,0x55,0x56,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x70,0x32,0x70,0x65,0x72,0x70,0x20,0x3d,0x20,0x63,0x72,0x6f,0x73,0x73,0x28,0x64,0x70,0x32,0x2c,0x20,0x4e,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x70,0x31,0x70,0x65,0x72,0x70,0x20,0x3d,0x20,0x63,0x72,0x6f,0x73,0x73,0x28,0x4e,0x2c,0x20,0x64,0x70,0x31,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x54,0x20,0x3d,0x20,0x64,0x70,0x32,0x70,0x65,0x72,0x70,0x20,0x2a,0x20,0x64,0x75,0x76,0x31,0x2e,0x78,0x20,0x2b,0x20,0x64,0x70,0x31,0x70,0x65,0x72,0x70,0x20,0x2a,0x20,0x64,0x75,0x76,0x32,0x2e,0x78,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x42,0x20,0x3d,0x20,0x64,0x70,0x32,0x70,0x65,0x72,0x70,0x20,0x2a,0x20,0x64,0x75,0x76,0x31,0x2e,0x79,0x20,0x2b,0x20,0x64,0x70,0x31,0x70,0x65,0x72,0x70,0x20,0x2a,0x20,0x64,0x75,0x76,0x32,0x2e,0x79,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x69,0x6e,0x76,0x6d,0x61,0x78,0x20,0x3d,0x20,0x69,0x6e,0x76,0x65,0x72,0x73,0x65,0x73,0x71,0x72,0x74,0x28,0x6d,0x61,0x78,0x28,0x64,0x6f,0x74,0x28,0x54,0x2c,0x20,0x54,0x29,0x2c,0x20,0x64,0x6f,0x74,0x28,0x42,0x2c,0x20,0x42,0x29,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6d,0x61,0x74,0x33,0x28,0x54,0x20,0x2a,0x20,0x69,0x6e,0x76,0x6d,0x61,0x78,0x2c,0x20,0x42,0x20,0x2a,0x20,0x69,0x6e,0x76,0x6d,0x61,0x78,0x2c,0x20,0x4e,0x29,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x7d,0x0a,0x0a,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x6e,0x65,0x77,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x67,0x65,0x6f,0x6d,0x65,0x74,0x72,0x69,0x63,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x67,0x65,0x6f,0x6d,0x65,0x74,0x72,0x69,0x63,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x76,0x69,0x65,0x77,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x43,0x61,0x6d,0x65,0x72,0x61,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x20,0x2d,0x20,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x65,0x6d,0x69,0x73,0x73,0x69,0x76,0x65,0x20,0x3d,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x62,0x61,0x73,0x65,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x31,0x2e,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x31,0x2e,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x2e,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x20,0x3d,0x20,0x30,0x2e,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x30,0x2e,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x34,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x42,0x61,0x73,0x65,0x43,0x6f,0x6c,0x6f,0x72,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x29,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x2a,0x3d,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x43,0x6f,0x6c,0x6f,0x72,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x45,0x6d,0x69,0x73,0x73,0x69,0x76,0x65,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x65,0x6d,0x69,0x73,0x73,0x69,0x76,0x65,0x20,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x67,0x6c,0x6f,0x77,0x2e,0x72,0x67,0x62,0x20,0x2a,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x67,0x6c,0x6f,0x77,0x2e,0x61,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x67,0x6c,0x6f,0x77,0x20,0x26,0x26,0x20,0x66,0x6c,0x61,0x67,0x5f,0x67,0x6c,0x6f,0x77,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x29,0x20,0x65,0x6d,0x69,0x73,0x73,0x69,0x76,0x65,0x20,0x2a,0x3d,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x47,0x6c,0x6f,0x77,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x2e,0x72,0x67,0x62,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x65,0x6d,0x69,0x73,0x73,0x69,0x76,0x65,0x3b,0x0a,0x7d,0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x4d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x29,0x20,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x20,0x2a,0x3d,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x4d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x2e,0x62,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x7d,0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x29,0x20,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x2a,0x3d,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x2e,0x67,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x7d,0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x4f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x2e,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x61,0x6d,0x62,0x69,0x65,0x6e,0x74,0x4f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x29,0x20,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x20,0x2a,0x3d,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x4f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x2e,0x72,0x20,0x2a,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x53,0x74,0x72,0x65,0x6e,0x67,0x74,0x68,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x3b,0x0a,0x7d,0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x43,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x20,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x29,0x20,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x20,0x2a,0x3d,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x43,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x2e,0x72,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x3b,0x0a,0x7d,0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x43,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x61,0x70,0x70,0x6c,0x79,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x28,0x69,0x6e,0x6f,0x75,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x29,0x20,0x7b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x62,0x61,0x73,0x65,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x42,0x61,0x73,0x65,0x43,0x6f,0x6c,0x6f,0x72,0x28,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x65,0x6d,0x69,0x73,0x73,0x69,0x76,0x65,0x20,0x3d,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x45,0x6d,0x69,0x73,0x73,0x69,0x76,0x65,0x28,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x4d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x28,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x28,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x4f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x20,0x3d,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x43,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x28,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x63,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x67,0x65,0x74,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x43,0x6c,0x65,0x61,0x72,0x63,0x6f,0x61,0x74,0x52,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x28,0x29,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x4d,0x61,0x70,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x53,0x63,0x61,0x6c,0x65,0x20,0x3d,0x20,0x76,0x65,0x63,0x33,0x28,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x53,0x63,0x61,0x6c,0x65,0x2c,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x53,0x63,0x61,0x6c,0x65,0x2c,0x20,0x31,0x2e,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x4d,0x61,0x74,0x72,0x69,0x78,0x20,0x2a,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x28,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x2e,0x72,0x67,0x62,0x20,0x2a,0x20,0x32,0x2e,0x20,0x2d,0x20,0x31,0x2e,0x29,0x20,0x2a,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x53,0x63,0x61,0x6c,0x65,0x29,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x66,0x69,0x6e,0x61,0x6c,0x69,0x7a,0x65,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x28,0x69,0x6e,0x6f,0x75,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x29,0x20,0x7b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x21,0x46,0x72,0x6f,0x6e,0x74,0x46,0x61,0x63,0x69,0x6e,0x67,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x2d,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x67,0x65,0x6f,0x6d,0x65,0x74,0x72,0x69,0x63,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x2d,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x67,0x65,0x6f,0x6d,0x65,0x74,0x72,0x69,0x63,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x65,0x66,0x6c,0x65,0x63,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x72,0x65,0x66,0x6c,0x65,0x63,0x74,0x28,0x2d,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x76,0x69,0x65,0x77,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x66,0x30,0x20,0x3d,0x20,0x6d,0x69,0x78,0x28,0x76,0x65,0x63,0x33,0x28,0x2e,0x30,0x34,0x29,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x62,0x61,0x73,0x65,0x43,0x6f,0x6c,0x6f,0x72,0x2e,0x72,0x67,0x62,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x64,0x69,0x66,0x66,0x75,0x73,0x65,0x20,0x3d,0x20,0x6d,0x69,0x78,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x62,0x61,0x73,0x65,0x43,0x6f,0x6c,0x6f,0x72,0x2e,0x72,0x67,0x62,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x29,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6d,0x65,0x74,0x61,0x6c,0x6e,0x65,0x73,0x73,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x3d,0x20,0x6d,0x61,0x78,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x2c,0x20,0x2e,0x30,0x35,0x29,0x3b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x32,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x2a,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x67,0x65,0x74,0x44,0x65,0x66,0x61,0x75,0x6c,0x74,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x3d,0x20,0x6e,0x65,0x77,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x28,0x29,0x3b,0x0a,0x20,0x20,0x61,0x70,0x70,0x6c,0x79,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x29,0x3b,0x0a,0x20,0x20,0x66,0x69,0x6e,0x61,0x6c,0x69,0x7a,0x65,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x29,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2f,0x20,0x44,0x65,0x70,0x72,0x65,0x63,0x61,0x74,0x65,0x64,0x0a,0x76,0x6f,0x69,0x64,0x20,0x69,0x6e,0x69,0x74,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x28,0x6f,0x75,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x29,0x20,0x7b,0x0a,0x20,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x3d,0x20,0x67,0x65,0x74,0x44,0x65,0x66,0x61,0x75,0x6c,0x74,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x28,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x20,0x44,0x5f,0x47,0x47,0x58,0x28,0x63,0x6f,0x6e,0x73,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x4e,0x6f,0x48,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x61,0x6c,0x70,0x68,0x61,0x32,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x32,0x20,0x2a,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x32,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x64,0x65,0x6e,0x6f,0x6d,0x20,0x3d,0x20,0x28,0x4e,0x6f,0x48,0x20,0x2a,0x20,0x4e,0x6f,0x48,0x29,0x20,0x2a,0x20,0x28,0x61,0x6c,0x70,0x68,0x61,0x32,0x20,0x2d,0x20,0x31,0x2e,0x29,0x20,0x2b,0x20,0x31,0x2e,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x61,0x6c,0x70,0x68,0x61,0x32,0x20,0x2f,0x20,0x28,0x50,0x49,0x20,0x2a,0x20,0x64,0x65,0x6e,0x6f,0x6d,0x20,0x2a,0x20,0x64,0x65,0x6e,0x6f,0x6d,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x20,0x47,0x5f,0x53,0x6d,0x69,0x74,0x68,0x47,0x47,0x58,0x43,0x6f,0x72,0x72,0x65,0x6c,0x61,0x74,0x65,0x64,0x28,0x63,0x6f,0x6e,0x73,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x4e,0x6f,0x56,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x4e,0x6f,0x4c,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x61,0x6c,0x70,0x68,0x61,0x32,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x32,0x20,0x2a,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x32,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x47,0x47,0x58,0x56,0x20,0x3d,0x20,0x4e,0x6f,0x4c,0x20,0x2a,0x20,0x73,0x71,0x72,0x74,0x28,0x61,0x6c,0x70,0x68,0x61,0x32,0x20,0x2b,0x20,0x28,0x31,0x2e,0x20,0x2d,0x20,0x61,0x6c,0x70,0x68,0x61,0x32,0x29,0x20,0x2a,0x20,0x28,0x4e,0x6f,0x56,0x20,0x2a,0x20,0x4e,0x6f,0x56,0x29,0x29,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x47,0x47,0x58,0x4c,0x20,0x3d,0x20,0x4e,0x6f,0x56,0x20,0x2a,0x20,0x73,0x71,0x72,0x74,0x28,0x61,0x6c,0x70,0x68,0x61,0x32,0x20,0x2b,0x20,0x28,0x31,0x2e,0x20,0x2d,0x20,0x61,0x6c,0x70,0x68,0x61,0x32,0x29,0x20,0x2a,0x20,0x28,0x4e,0x6f,0x4c,0x20,0x2a,0x20,0x4e,0x6f,0x4c,0x29,0x29,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x2e,0x35,0x20,0x2f,0x20,0x28,0x47,0x47,0x58,0x56,0x20,0x2b,0x20,0x47,0x47,0x58,0x4c,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x46,0x5f,0x53,0x63,0x68,0x6c,0x69,0x63,0x6b,0x28,0x63,0x6f,0x6e,0x73,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x56,0x6f,0x48,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x66,0x30,0x20,0x2b,0x20,0x28,0x76,0x65,0x63,0x33,0x28,0x31,0x2e,0x29,0x20,0x2d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x66,0x30,0x29,0x20,0x2a,0x20,0x70,0x6f,0x77,0x28,0x31,0x2e,0x20,0x2d,0x20,0x56,0x6f,0x48,0x2c,0x20,0x35,0x2e,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2f,0x20,0x45,0x76,0x61,0x6c,0x75,0x61,0x74,0x65,0x73,0x20,0x61,0x20,0x64,0x69,0x72,0x65,0x63,0x74,0x20,0x6c,0x69,0x67,0x68,0x74,0x20,0x66,0x6f,0x72,0x20,0x61,0x20,0x67,0x69,0x76,0x65,0x6e,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x0a,0x76,0x65,0x63,0x33,0x20,0x67,0x65,0x74,0x4c,0x69,0x67,0x68,0x74,0x69,0x6e,0x67,0x28,0x63,0x6f,0x6e,0x73,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x69,0x72,0x65,0x63,0x74,0x69,0x6f,0x6e,0x2c,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x76,0x69,0x73,0x69,0x62,0x69,0x6c,0x69,0x74,0x79,0x29,0x20,0x7b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x76,0x69,0x73,0x69,0x62,0x69,0x6c,0x69,0x74,0x79,0x20,0x3c,0x3d,0x20,0x30,0x2e,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x29,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x2f,0x2f,0x20,0x50,0x61,0x72,0x61,0x6d,0x65,0x74,0x65,0x72,0x73,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x4e,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x56,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x76,0x69,0x65,0x77,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x4c,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x2d,0x64,0x69,0x72,0x65,0x63,0x74,0x69,0x6f,0x6e,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x48,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x56,0x20,0x2b,0x20,0x4c,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x52,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x65,0x66,0x6c,0x65,0x63,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x4e,0x6f,0x56,0x20,0x3d,0x20,0x61,0x62,0x73,0x28,0x64,0x6f,0x74,0x28,0x4e,0x2c,0x20,0x56,0x29,0x29,0x20,0x2b,0x20,0x31,0x65,0x2d,0x38,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x4e,0x6f,0x4c,0x20,0x3d,0x20,0x63,0x6c,0x61,0x6d,0x70,0x28,0x64,0x6f,0x74,0x28,0x4e,0x2c,0x20,0x4c,0x29,0x2c,0x20,0x30,0x2e,0x2c,0x20,0x31,0x2e,0x29,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x4e,0x6f,0x48,0x20,0x3d,0x20,0x63,0x6c,0x61,0x6d,0x70,0x28,0x64,0x6f,0x74,0x28,0x4e,0x2c,0x20,0x48,0x29,0x2c,0x20,0x30,0x2e,0x2c,0x20,0x31,0x2e,0x29,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x56,0x6f,0x48,0x20,0x3d,0x20,0x63,0x6c,0x61,0x6d,0x70,0x28,0x64,0x6f,0x74,0x28,0x56,0x2c,0x20,0x48,0x29,0x2c,0x20,0x30,0x2e,0x2c,0x20,0x31,0x2e,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x2f,0x2f,0x20,0x44,0x69,0x66,0x66,0x75,0x73,0x65,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x46,0x64,0x5f,0x4c,0x61,0x6d,0x62,0x65,0x72,0x74,0x20,0x3d,0x20,0x31,0x2e,0x20,0x2f,0x20,0x50,0x49,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x69,0x66,0x66,0x75,0x73,0x65,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x64,0x69,0x66,0x66,0x75,0x73,0x65,0x20,0x2a,0x20,0x46,0x64,0x5f,0x4c,0x61,0x6d,0x62,0x65,0x72,0x74,0x3b,0x0a,0x0a,0x20,0x20,0x2f,0x2f,0x20,0x53,0x70,0x65,0x63,0x75,0x6c,0x61,0x72,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x44,0x20,0x3d,0x20,0x44,0x5f,0x47,0x47,0x58,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x4e,0x6f,0x48,0x29,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x47,0x20,0x3d,0x20,0x47,0x5f,0x53,0x6d,0x69,0x74,0x68,0x47,0x47,0x58,0x43,0x6f,0x72,0x72,0x65,0x6c,0x61,0x74,0x65,0x64,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x4e,0x6f,0x56,0x2c,0x20,0x4e,0x6f,0x4c,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x46,0x20,0x3d,0x20,0x46,0x5f,0x53,0x63,0x68,0x6c,0x69,0x63,0x6b,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x56,0x6f,0x48,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x73,0x70,0x65,0x63,0x75,0x6c,0x61,0x72,0x20,0x3d,0x20,0x76,0x65,0x63,0x33,0x28,0x44,0x20,0x2a,0x20,0x47,0x29,0x20,0x2a,0x20,0x46,0x3b,0x0a,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x28,0x64,0x69,0x66,0x66,0x75,0x73,0x65,0x20,0x2b,0x20,0x73,0x70,0x65,0x63,0x75,0x6c,0x61,0x72,0x29,0x20,0x2a,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x2e,0x72,0x67,0x62,0x20,0x2a,0x20,0x28,0x4e,0x6f,0x4c,0x20,0x2a,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x2e,0x61,0x20,0x2a,0x20,0x76,0x69,0x73,0x69,0x62,0x69,0x6c,0x69,0x74,0x79,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2f,0x20,0x68,0x74,0x74,0x70,0x73,0x3a,0x2f,0x2f,0x77,0x77,0x77,0x2e,0x75,0x6e,0x72,0x65,0x61,0x6c,0x65,0x6e,0x67,0x69,0x6e,0x65,0x2e,0x63,0x6f,0x6d,0x2f,0x65,0x6e,0x2d,0x55,0x53,0x2f,0x62,0x6c,0x6f,0x67,0x2f,0x70,0x68,0x79,0x73,0x69,0x63,0x61,0x6c,0x6c,0x79,0x2d,0x62,0x61,0x73,0x65,0x64,0x2d,0x73,0x68,0x61,0x64,0x69,0x6e,0x67,0x2d,0x6f,0x6e,0x2d,0x6d,0x6f,0x62,0x69,0x6c,0x65,0x0a,0x76,0x65,0x63,0x32,0x20,0x70,0x72,0x65,0x66,0x69,0x6c,0x74,0x65,0x72,0x65,0x64,0x42,0x52,0x44,0x46,0x28,0x66,0x6c,0x6f,0x61,0x74,0x20,0x4e,0x6f,0x56,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x29,0x20,0x7b,0x0a,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x30,0x20,0x3d,0x20,0x76,0x65,0x63,0x34,0x28,0x2d,0x31,0x2e,0x2c,0x20,0x2d,0x2e,0x30,0x32,0x37,0x35,0x2c,0x20,0x2d,0x2e,0x35,0x37,0x32,0x2c,0x20,0x2e,0x30,0x32,0x32,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x63,0x31,0x20,0x3d,0x20,0x76,0x65,0x63,0x34,0x28,0x31,0x2e,0x2c,0x20,0x2e,0x30,0x34,0x32,0x35,0x2c,0x20,0x31,0x2e,0x30,0x34,0x2c,0x20,0x2d,0x2e,0x30,0x34,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x72,0x20,0x3d,0x20,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x2a,0x20,0x63,0x30,0x20,0x2b,0x20,0x63,0x31,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x61,0x30,0x30,0x34,0x20,0x3d,0x20,0x6d,0x69,0x6e,0x28,0x72,0x2e,0x78,0x20,0x2a,0x20,0x72,0x2e,0x78,0x2c,0x20,0x65,0x78,0x70,0x32,0x28,0x2d,0x39,0x2e,0x32,0x38,0x20,0x2a,0x20,0x4e,0x6f,0x56,0x29,0x29,0x20,0x2a,0x20,0x72,0x2e,0x78,0x20,0x2b,0x20,0x72,0x2e,0x79,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x76,0x65,0x63,0x32,0x28,0x2d,0x31,0x2e,0x30,0x34,0x2c,0x20,0x31,0x2e,0x30,0x34,0x29,0x20,0x2a,0x20,0x61,0x30,0x30,0x34,0x20,0x2b,0x20,0x72,0x2e,0x7a,0x77,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x65,0x76,0x61,0x6c,0x75,0x61,0x74,0x65,0x53,0x70,0x68,0x65,0x72,0x69,0x63,0x61,0x6c,0x48,0x61,0x72,0x6d,0x6f,0x6e,0x69,0x63,0x73,0x28,0x76,0x65,0x63,0x33,0x20,0x73,0x68,0x5b,0x39,0x5d,0x2c,0x20,0x76,0x65,0x63,0x33,0x20,0x6e,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6d,0x61,0x78,0x28,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x30,0x5d,0x20,0x2b,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x31,0x5d,0x20,0x2a,0x20,0x6e,0x2e,0x79,0x20,0x2b,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x32,0x5d,0x20,0x2a,0x20,0x6e,0x2e,0x7a,0x20,0x2b,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x33,0x5d,0x20,0x2a,0x20,0x6e,0x2e,0x78,0x20,0x2b,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x34,0x5d,0x20,0x2a,0x20,0x6e,0x2e,0x79,0x20,0x2a,0x20,0x6e,0x2e,0x78,0x20,0x2b,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x35,0x5d,0x20,0x2a,0x20,0x6e,0x2e,0x79,0x20,0x2a,0x20,0x6e,0x2e,0x7a,0x20,0x2b,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x36,0x5d,0x20,0x2a,0x20,0x28,0x33,0x2e,0x20,0x2a,0x20,0x6e,0x2e,0x7a,0x20,0x2a,0x20,0x6e,0x2e,0x7a,0x20,0x2d,0x20,0x31,0x2e,0x29,0x20,0x2b,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x37,0x5d,0x20,0x2a,0x20,0x6e,0x2e,0x7a,0x20,0x2a,0x20,0x6e,0x2e,0x78,0x20,0x2b,0x0a,0x20,0x20,0x20,0x20,0x73,0x68,0x5b,0x38,0x5d,0x20,0x2a,0x20,0x28,0x6e,0x2e,0x78,0x20,0x2a,0x20,0x6e,0x2e,0x78,0x20,0x2d,0x20,0x6e,0x2e,0x79,0x20,0x2a,0x20,0x6e,0x2e,0x79,0x29,0x0a,0x20,0x20,0x2c,0x20,0x30,0x2e,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x67,0x65,0x74,0x49,0x6e,0x64,0x69,0x72,0x65,0x63,0x74,0x4c,0x69,0x67,0x68,0x74,0x69,0x6e,0x67,0x28,0x63,0x6f,0x6e,0x73,0x74,0x20,0x53,0x75,0x72,0x66,0x61,0x63,0x65,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2c,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x43,0x75,0x62,0x65,0x20,0x65,0x6e,0x76,0x69,0x72,0x6f,0x6e,0x6d,0x65,0x6e,0x74,0x2c,0x20,0x76,0x65,0x63,0x33,0x20,0x73,0x70,0x68,0x65,0x72,0x69,0x63,0x61,0x6c,0x48,0x61,0x72,0x6d,0x6f,0x6e,0x69,0x63,0x73,0x5b,0x39,0x5d,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x4e,0x6f,0x56,0x20,0x3d,0x20,0x64,0x6f,0x74,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x76,0x69,0x65,0x77,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x6c,0x6f,0x6f,0x6b,0x75,0x70,0x20,0x3d,0x20,0x70,0x72,0x65,0x66,0x69,0x6c,0x74,0x65,0x72,0x65,0x64,0x42,0x52,0x44,0x46,0x28,0x4e,0x6f,0x56,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x69,0x6e,0x74,0x20,0x6d,0x69,0x70,0x6d,0x61,0x70,0x43,0x6f,0x75,0x6e,0x74,0x20,0x3d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x51,0x75,0x65,0x72,0x79,0x4c,0x65,0x76,0x65,0x6c,0x73,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x43,0x75,0x62,0x65,0x28,0x65,0x6e,0x76,0x69,0x72,0x6f,0x6e,0x6d,0x65,0x6e,0x74,0x2c,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x29,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x69,0x62,0x6c,0x20,0x3d,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x4c,0x6f,0x64,0x28,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x43,0x75,0x62,0x65,0x28,0x65,0x6e,0x76,0x69,0x72,0x6f,0x6e,0x6d,0x65,0x6e,0x74,0x2c,0x20,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x29,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x65,0x66,0x6c,0x65,0x63,0x74,0x69,0x6f,0x6e,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x72,0x6f,0x75,0x67,0x68,0x6e,0x65,0x73,0x73,0x20,0x2a,0x20,0x6d,0x69,0x70,0x6d,0x61,0x70,0x43,0x6f,0x75,0x6e,0x74,0x29,0x2e,0x72,0x67,0x62,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x73,0x70,0x65,0x63,0x75,0x6c,0x61,0x72,0x20,0x3d,0x20,0x28,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x66,0x30,0x20,0x2a,0x20,0x6c,0x6f,0x6f,0x6b,0x75,0x70,0x2e,0x72,0x20,0x2b,0x20,0x6c,0x6f,0x6f,0x6b,0x75,0x70,0x2e,0x67,0x29,0x20,0x2a,0x20,0x69,0x62,0x6c,0x3b,0x0a,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x73,0x68,0x20,0x3d,0x20,0x65,0x76,0x61,0x6c,0x75,0x61,0x74,0x65,0x53,0x70,0x68,0x65,0x72,0x69,0x63,0x61,0x6c,0x48,0x61,0x72,0x6d,0x6f,0x6e,0x69,0x63,0x73,0x28,0x73,0x70,0x68,0x65,0x72,0x69,0x63,0x61,0x6c,0x48,0x61,0x72,0x6d,0x6f,0x6e,0x69,0x63,0x73,0x2c,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x29,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x64,0x69,0x66,0x66,0x75,0x73,0x65,0x20,0x3d,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x64,0x69,0x66,0x66,0x75,0x73,0x65,0x20,0x2a,0x20,0x73,0x75,0x72,0x66,0x61,0x63,0x65,0x2e,0x6f,0x63,0x63,0x6c,0x75,0x73,0x69,0x6f,0x6e,0x20,0x2a,0x20,0x73,0x68,0x3b,0x0a,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x64,0x69,0x66,0x66,0x75,0x73,0x65,0x20,0x2b,0x20,0x73,0x70,0x65,0x63,0x75,0x6c,0x61,0x72,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x74,0x6f,0x6e,0x65,0x6d,0x61,0x70,0x28,0x76,0x65,0x63,0x33,0x20,0x78,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x61,0x20,0x3d,0x20,0x32,0x2e,0x35,0x31,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x62,0x20,0x3d,0x20,0x30,0x2e,0x30,0x33,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x20,0x3d,0x20,0x32,0x2e,0x34,0x33,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x64,0x20,0x3d,0x20,0x30,0x2e,0x35,0x39,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x65,0x20,0x3d,0x20,0x30,0x2e,0x31,0x34,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x28,0x78,0x20,0x2a,0x20,0x28,0x61,0x20,0x2a,0x20,0x78,0x20,0x2b,0x20,0x62,0x29,0x29,0x20,0x2f,0x20,0x28,0x78,0x20,0x2a,0x20,0x28,0x63,0x20,0x2a,0x20,0x78,0x20,0x2b,0x20,0x64,0x29,0x20,0x2b,0x20,0x65,0x29,0x3b,0x0a,0x7d,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x67,0x61,0x6d,0x6d,0x61,0x54,0x6f,0x4c,0x69,0x6e,0x65,0x61,0x72,0x28,0x76,0x65,0x63,0x33,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6d,0x69,0x78,0x28,0x70,0x6f,0x77,0x28,0x28,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x2b,0x20,0x2e,0x30,0x35,0x35,0x29,0x20,0x2f,0x20,0x31,0x2e,0x30,0x35,0x35,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x32,0x2e,0x34,0x29,0x29,0x2c,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x2f,0x20,0x31,0x32,0x2e,0x39,0x32,0x2c,0x20,0x6c,0x65,0x73,0x73,0x54,0x68,0x61,0x6e,0x45,0x71,0x75,0x61,0x6c,0x28,0x63,0x6f,0x6c,0x6f,0x72,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x2e,0x30,0x34,0x30,0x34,0x35,0x29,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x6c,0x69,0x6e,0x65,0x61,0x72,0x54,0x6f,0x47,0x61,0x6d,0x6d,0x61,0x28,0x76,0x65,0x63,0x33,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6d,0x69,0x78,0x28,0x31,0x2e,0x30,0x35,0x35,0x20,0x2a,0x20,0x70,0x6f,0x77,0x28,0x63,0x6f,0x6c,0x6f,0x72,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x31,0x2e,0x20,0x2f,0x20,0x32,0x2e,0x34,0x29,0x29,0x20,0x2d,0x20,0x2e,0x30,0x35,0x35,0x2c,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x2a,0x20,0x31,0x32,0x2e,0x39,0x32,0x2c,0x20,0x6c,0x65,0x73,0x73,0x54,0x68,0x61,0x6e,0x45,0x71,0x75,0x61,0x6c,0x28,0x63,0x6f,0x6c,0x6f,0x72,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x2e,0x30,0x30,0x33,0x31,0x33,0x30,0x38,0x29,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x70,0x71,0x54,0x6f,0x4c,0x69,0x6e,0x65,0x61,0x72,0x28,0x76,0x65,0x63,0x33,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x31,0x20,0x3d,0x20,0x2e,0x38,0x33,0x35,0x39,0x37,0x35,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x32,0x20,0x3d,0x20,0x31,0x38,0x2e,0x38,0x35,0x31,0x35,0x36,0x32,0x35,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x33,0x20,0x3d,0x20,0x31,0x38,0x2e,0x36,0x38,0x37,0x35,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6d,0x31,0x20,0x3d,0x20,0x2e,0x31,0x35,0x39,0x33,0x30,0x31,0x37,0x35,0x37,0x38,0x31,0x32,0x35,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6d,0x32,0x20,0x3d,0x20,0x37,0x38,0x2e,0x38,0x34,0x33,0x37,0x35,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x65,0x6d,0x32,0x20,0x3d,0x20,0x70,0x6f,0x77,0x28,0x63,0x6f,0x6c,0x6f,0x72,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x31,0x2e,0x20,0x2f,0x20,0x6d,0x32,0x29,0x29,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x70,0x6f,0x77,0x28,0x6d,0x61,0x78,0x28,0x65,0x6d,0x32,0x20,0x2d,0x20,0x63,0x31,0x2c,0x20,0x30,0x2e,0x29,0x20,0x2f,0x20,0x28,0x63,0x32,0x20,0x2d,0x20,0x63,0x33,0x20,0x2a,0x20,0x65,0x6d,0x32,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x31,0x2e,0x20,0x2f,0x20,0x6d,0x31,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x6c,0x69,0x6e,0x65,0x61,0x72,0x54,0x6f,0x50,0x51,0x28,0x76,0x65,0x63,0x33,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x29,0x20,0x7b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x31,0x20,0x3d,0x20,0x2e,0x38,0x33,0x35,0x39,0x37,0x35,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x32,0x20,0x3d,0x20,0x31,0x38,0x2e,0x38,0x35,0x31,0x35,0x36,0x32,0x35,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x63,0x33,0x20,0x3d,0x20,0x31,0x38,0x2e,0x36,0x38,0x37,0x35,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6d,0x31,0x20,0x3d,0x20,0x2e,0x31,0x35,0x39,0x33,0x30,0x31,0x37,0x35,0x37,0x38,0x31,0x32,0x35,0x3b,0x0a,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x6d,0x32,0x20,0x3d,0x20,0x37,0x38,0x2e,0x38,0x34,0x33,0x37,0x35,0x3b,0x0a,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x79,0x6d,0x31,0x20,0x3d,0x20,0x70,0x6f,0x77,0x28,0x63,0x6f,0x6c,0x6f,0x72,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x6d,0x31,0x29,0x29,0x3b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x70,0x6f,0x77,0x28,0x28,0x63,0x31,0x20,0x2b,0x20,0x63,0x32,0x20,0x2a,0x20,0x79,0x6d,0x31,0x29,0x20,0x2f,0x20,0x28,0x31,0x2e,0x20,0x2b,0x20,0x63,0x33,0x20,0x2a,0x20,0x79,0x6d,0x31,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x6d,0x32,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x73,0x52,0x47,0x42,0x54,0x6f,0x52,0x65,0x63,0x32,0x30,0x32,0x30,0x28,0x76,0x65,0x63,0x33,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x29,0x20,0x7b,0x0a,0x20,0x20,0x6d,0x61,0x74,0x33,0x20,0x78,0x79,0x7a,0x5f,0x66,0x72,0x6f,0x6d,0x5f,0x73,0x72,0x67,0x62,0x20,0x3d,0x20,0x74,0x72,0x61,0x6e,0x73,0x70,0x6f,0x73,0x65,0x28,0x6d,0x61,0x74,0x33,0x28,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x34,0x31,0x32,0x33,0x39,0x30,0x38,0x2c,0x20,0x30,0x2e,0x33,0x35,0x37,0x35,0x38,0x34,0x33,0x2c,0x20,0x30,0x2e,0x31,0x38,0x30,0x34,0x38,0x30,0x38,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x32,0x31,0x32,0x36,0x33,0x39,0x30,0x2c,0x20,0x30,0x2e,0x37,0x31,0x35,0x31,0x36,0x38,0x37,0x2c,0x20,0x30,0x2e,0x30,0x37,0x32,0x31,0x39,0x32,0x33,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x31,0x39,0x33,0x33,0x30,0x38,0x2c,0x20,0x30,0x2e,0x31,0x31,0x39,0x31,0x39,0x34,0x38,0x2c,0x20,0x30,0x2e,0x39,0x35,0x30,0x35,0x33,0x32,0x32,0x29,0x0a,0x20,0x20,0x29,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x6d,0x61,0x74,0x33,0x20,0x72,0x65,0x63,0x32,0x30,0x32,0x30,0x5f,0x66,0x72,0x6f,0x6d,0x5f,0x78,0x79,0x7a,0x20,0x3d,0x20,0x74,0x72,0x61,0x6e,0x73,0x70,0x6f,0x73,0x65,0x28,0x6d,0x61,0x74,0x33,0x28,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x20,0x31,0x2e,0x37,0x31,0x36,0x36,0x35,0x31,0x32,0x2c,0x20,0x2d,0x30,0x2e,0x33,0x35,0x35,0x36,0x37,0x30,0x38,0x2c,0x20,0x2d,0x30,0x2e,0x32,0x35,0x33,0x33,0x36,0x36,0x33,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x2d,0x30,0x2e,0x36,0x36,0x36,0x36,0x38,0x34,0x34,0x2c,0x20,0x20,0x31,0x2e,0x36,0x31,0x36,0x34,0x38,0x31,0x32,0x2c,0x20,0x20,0x30,0x2e,0x30,0x31,0x35,0x37,0x36,0x38,0x35,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x20,0x30,0x2e,0x30,0x31,0x37,0x36,0x33,0x39,0x39,0x2c,0x20,0x2d,0x30,0x2e,0x30,0x34,0x32,0x37,0x37,0x30,0x36,0x2c,0x20,0x20,0x30,0x2e,0x39,0x34,0x32,0x31,0x30,0x33,0x31,0x29,0x0a,0x20,0x20,0x29,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x72,0x65,0x63,0x32,0x30,0x32,0x30,0x5f,0x66,0x72,0x6f,0x6d,0x5f,0x78,0x79,0x7a,0x20,0x2a,0x20,0x78,0x79,0x7a,0x5f,0x66,0x72,0x6f,0x6d,0x5f,0x73,0x72,0x67,0x62,0x20,0x2a,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x65,0x63,0x33,0x20,0x72,0x65,0x63,0x32,0x30,0x32,0x30,0x54,0x6f,0x53,0x52,0x47,0x42,0x28,0x76,0x65,0x63,0x33,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x29,0x20,0x7b,0x0a,0x20,0x20,0x6d,0x61,0x74,0x33,0x20,0x78,0x79,0x7a,0x5f,0x66,0x72,0x6f,0x6d,0x5f,0x72,0x65,0x63,0x32,0x30,0x32,0x30,0x20,0x3d,0x20,0x74,0x72,0x61,0x6e,0x73,0x70,0x6f,0x73,0x65,0x28,0x6d,0x61,0x74,0x33,0x28,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x36,0x33,0x36,0x39,0x35,0x38,0x30,0x2c,0x20,0x30,0x2e,0x31,0x34,0x34,0x36,0x31,0x36,0x39,0x2c,0x20,0x30,0x2e,0x31,0x36,0x38,0x38,0x38,0x31,0x30,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x32,0x36,0x32,0x37,0x30,0x30,0x32,0x2c,0x20,0x30,0x2e,0x36,0x37,0x37,0x39,0x39,0x38,0x31,0x2c,0x20,0x30,0x2e,0x30,0x35,0x39,0x33,0x30,0x31,0x37,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x2c,0x20,0x30,0x2e,0x30,0x32,0x38,0x30,0x37,0x32,0x37,0x2c,0x20,0x31,0x2e,0x30,0x36,0x30,0x39,0x38,0x35,0x31,0x29,0x0a,0x20,0x20,0x29,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x6d,0x61,0x74,0x33,0x20,0x73,0x72,0x67,0x62,0x5f,0x66,0x72,0x6f,0x6d,0x5f,0x78,0x79,0x7a,0x20,0x3d,0x20,0x74,0x72,0x61,0x6e,0x73,0x70,0x6f,0x73,0x65,0x28,0x6d,0x61,0x74,0x33,0x28,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x20,0x33,0x2e,0x32,0x34,0x30,0x39,0x36,0x39,0x39,0x2c,0x20,0x2d,0x31,0x2e,0x35,0x33,0x37,0x33,0x38,0x33,0x32,0x2c,0x20,0x2d,0x30,0x2e,0x34,0x39,0x38,0x36,0x31,0x30,0x38,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x2d,0x30,0x2e,0x39,0x36,0x39,0x32,0x34,0x33,0x36,0x2c,0x20,0x20,0x31,0x2e,0x38,0x37,0x35,0x39,0x36,0x37,0x35,0x2c,0x20,0x20,0x30,0x2e,0x30,0x34,0x31,0x35,0x35,0x35,0x31,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x28,0x20,0x30,0x2e,0x30,0x35,0x35,0x36,0x33,0x30,0x31,0x2c,0x20,0x2d,0x30,0x2e,0x32,0x30,0x33,0x39,0x37,0x37,0x30,0x2c,0x20,0x20,0x31,0x2e,0x30,0x35,0x36,0x39,0x37,0x31,0x35,0x29,0x0a,0x20,0x20,0x29,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x72,0x67,0x62,0x5f,0x66,0x72,0x6f,0x6d,0x5f,0x78,0x79,0x7a,0x20,0x2a,0x20,0x78,0x79,0x7a,0x5f,0x66,0x72,0x6f,0x6d,0x5f,0x72,0x65,0x63,0x32,0x30,0x32,0x30,0x20,0x2a,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x0a,0x0a,0x75,0x69,0x6e,0x74,0x20,0x70,0x61,0x63,0x6b,0x53,0x6e,0x6f,0x72,0x6d,0x31,0x30,0x78,0x33,0x28,0x76,0x65,0x63,0x34,0x20,0x76,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x0a,0x20,0x20,0x20,0x20,0x28,0x28,0x69,0x6e,0x74,0x28,0x76,0x2e,0x78,0x20,0x2a,0x20,0x35,0x31,0x31,0x2e,0x29,0x20,0x26,0x20,0x30,0x78,0x33,0x66,0x66,0x29,0x20,0x3c,0x3c,0x20,0x20,0x30,0x29,0x20,0x7c,0x0a,0x20,0x20,0x20,0x20,0x28,0x28,0x69,0x6e,0x74,0x28,0x76,0x2e,0x79,0x20,0x2a,0x20,0x35,0x31,0x31,0x2e,0x29,0x20,0x26,0x20,0x30,0x78,0x33,0x66,0x66,0x29,0x20,0x3c,0x3c,0x20,0x31,0x30,0x29,0x20,0x7c,0x0a,0x20,0x20,0x20,0x20,0x28,0x28,0x69,0x6e,0x74,0x28,0x76,0x2e,0x7a,0x20,0x2a,0x20,0x35,0x31,0x31,0x2e,0x29,0x20,0x26,0x20,0x30,0x78,0x33,0x66,0x66,0x29,0x20,0x3c,0x3c,0x20,0x32,0x30,0x29,0x20,0x7c,0x0a,0x20,0x20,0x20,0x20,0x28,0x28,0x69,0x6e,0x74,0x28,0x76,0x2e,0x77,0x20,0x2a,0x20,0x32,0x2e,0x29,0x20,0x26,0x20,0x30,0x78,0x33,0x29,0x20,0x3c,0x3c,0x20,0x33,0x30,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2f,0x20,0x54,0x68,0x65,0x20,0x77,0x65,0x69,0x72,0x64,0x20,0x32,0x32,0x20,0x62,0x69,0x74,0x20,0x73,0x68,0x69,0x66,0x74,0x20,0x62,0x61,0x73,0x69,0x63,0x61,0x6c,0x6c,0x79,0x20,0x64,0x6f,0x65,0x73,0x20,0x73,0x69,0x67,0x6e,0x2d,0x65,0x78,0x74,0x65,0x6e,0x73,0x69,0x6f,0x6e,0x20,0x6f,0x66,0x20,0x61,0x20,0x31,0x30,0x2d,0x62,0x69,0x74,0x20,0x76,0x61,0x6c,0x75,0x65,0x20,0x73,0x74,0x6f,0x72,0x65,0x64,0x20,0x69,0x6e,0x20,0x61,0x20,0x33,0x32,0x2d,0x62,0x69,0x74,0x20,0x69,0x6e,0x74,0x0a,0x76,0x65,0x63,0x34,0x20,0x75,0x6e,0x70,0x61,0x63,0x6b,0x53,0x6e,0x6f,0x72,0x6d,0x31,0x30,0x78,0x33,0x28,0x75,0x69,0x6e,0x74,0x20,0x6e,0x29,0x20,0x7b,0x0a,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x76,0x65,0x63,0x34,0x28,0x0a,0x20,0x20,0x20,0x20,0x6d,0x61,0x78,0x28,0x28,0x69,0x6e,0x74,0x28,0x28,0x6e,0x20,0x3e,0x3e,0x20,0x30,0x29,0x20,0x20,0x26,0x20,0x30,0x78,0x33,0x66,0x66,0x29,0x20,0x3c,0x3c,0x20,0x32,0x32,0x20,0x3e,0x3e,0x20,0x32,0x32,0x29,0x20,0x2f,0x20,0x35,0x31,0x31,0x2e,0x2c,0x20,0x2d,0x31,0x2e,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x6d,0x61,0x78,0x28,0x28,0x69,0x6e,0x74,0x28,0x28,0x6e,0x20,0x3e,0x3e,0x20,0x31,0x30,0x29,0x20,0x26,0x20,0x30,0x78,0x33,0x66,0x66,0x29,0x20,0x3c,0x3c,0x20,0x32,0x32,0x20,0x3e,0x3e,0x20,0x32,0x32,0x29,0x20,0x2f,0x20,0x35,0x31,0x31,0x2e,0x2c,0x20,0x2d,0x31,0x2e,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x6d,0x61,0x78,0x28,0x28,0x69,0x6e,0x74,0x28,0x28,0x6e,0x20,0x3e,0x3e,0x20,0x32,0x30,0x29,0x20,0x26,0x20,0x30,0x78,0x33,0x66,0x66,0x29,0x20,0x3c,0x3c,0x20,0x32,0x32,0x20,0x3e,0x3e,0x20,0x32,0x32,0x29,0x20,0x2f,0x20,0x35,0x31,0x31,0x2e,0x2c,0x20,0x2d,0x31,0x2e,0x29,0x2c,0x0a,0x20,0x20,0x20,0x20,0x6d,0x61,0x78,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x28,0x6e,0x20,0x3e,0x3e,0x20,0x33,0x30,0x29,0x20,0x26,0x20,0x30,0x78,0x33,0x29,0x2c,0x20,0x2d,0x31,0x2e,0x29,0x0a,0x20,0x20,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x2f,0x2f,0x20,0x45,0x6e,0x74,0x72,0x79,0x70,0x6f,0x69,0x6e,0x74,0x73,0x0a,0x23,0x69,0x66,0x6e,0x64,0x65,0x66,0x20,0x4e,0x4f,0x5f,0x44,0x45,0x46,0x41,0x55,0x4c,0x54,0x5f,0x4d,0x41,0x49,0x4e,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x56,0x45,0x52,0x54,0x45,0x58,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x76,0x65,0x63,0x34,0x20,0x6c,0x6f,0x76,0x72,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x57,0x6f,0x72,0x6c,0x64,0x20,0x3d,0x20,0x76,0x65,0x63,0x33,0x28,0x57,0x6f,0x72,0x6c,0x64,0x46,0x72,0x6f,0x6d,0x4c,0x6f,0x63,0x61,0x6c,0x20,0x2a,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x29,0x3b,0x0a,0x20,0x20,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x4d,0x61,0x74,0x72,0x69,0x78,0x20,0x2a,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x20,0x20,0x55,0x56,0x20,0x3d,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x55,0x56,0x3b,0x0a,0x0a,0x20,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x76,0x65,0x63,0x34,0x28,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x70,0x61,0x73,0x73,0x43,0x6f,0x6c,0x6f,0x72,0x29,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x2a,0x3d,0x20,0x50,0x61,0x73,0x73,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x6d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x29,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x2a,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x76,0x65,0x72,0x74,0x65,0x78,0x43,0x6f,0x6c,0x6f,0x72,0x73,0x29,0x20,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x2a,0x3d,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x43,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x76,0x65,0x72,0x74,0x65,0x78,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x73,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x3d,0x20,0x76,0x65,0x63,0x34,0x28,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x4d,0x61,0x74,0x72,0x69,0x78,0x20,0x2a,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x56,0x65,0x72,0x74,0x65,0x78,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x77,0x29,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x50,0x6f,0x69,0x6e,0x74,0x53,0x69,0x7a,0x65,0x20,0x3d,0x20,0x66,0x6c,0x61,0x67,0x5f,0x70,0x6f,0x69,0x6e,0x74,0x53,0x69,0x7a,0x65,0x3b,0x0a,0x20,0x20,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x6c,0x6f,0x76,0x72,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x75,0x76,0x54,0x72,0x61,0x6e,0x73,0x66,0x6f,0x72,0x6d,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x55,0x56,0x20,0x2a,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x75,0x76,0x53,0x63,0x61,0x6c,0x65,0x3b,0x0a,0x20,0x20,0x20,0x20,0x55,0x56,0x20,0x2b,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x75,0x76,0x53,0x68,0x69,0x66,0x74,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x7d,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x46,0x52,0x41,0x47,0x4d,0x45,0x4e,0x54,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x76,0x65,0x63,0x34,0x20,0x6c,0x6f,0x76,0x72,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x50,0x69,0x78,0x65,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x6c,0x6f,0x76,0x72,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x67,0x6c,0x6f,0x77,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x67,0x6c,0x6f,0x77,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x50,0x69,0x78,0x65,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x2e,0x72,0x67,0x62,0x20,0x2b,0x3d,0x20,0x67,0x65,0x74,0x50,0x69,0x78,0x65,0x6c,0x28,0x47,0x6c,0x6f,0x77,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x2c,0x20,0x55,0x56,0x29,0x2e,0x72,0x67,0x62,0x20,0x2a,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x67,0x6c,0x6f,0x77,0x2e,0x72,0x67,0x62,0x20,0x2a,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x67,0x6c,0x6f,0x77,0x2e,0x61,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x20,0x65,0x6c,0x73,0x65,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x50,0x69,0x78,0x65,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x2e,0x72,0x67,0x62,0x20,0x2b,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x67,0x6c,0x6f,0x77,0x2e,0x72,0x67,0x62,0x20,0x2a,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x67,0x6c,0x6f,0x77,0x2e,0x61,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x74,0x6f,0x6e,0x65,0x6d,0x61,0x70,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x50,0x69,0x78,0x65,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x2e,0x72,0x67,0x62,0x20,0x3d,0x20,0x74,0x6f,0x6e,0x65,0x6d,0x61,0x70,0x28,0x50,0x69,0x78,0x65,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x2e,0x72,0x67,0x62,0x29,0x3b,0x0a,0x20,0x20,0x7d,0x0a,0x0a,0x20,0x20,0x69,0x66,0x20,0x28,0x66,0x6c,0x61,0x67,0x5f,0x61,0x6c,0x70,0x68,0x61,0x43,0x75,0x74,0x6f,0x66,0x66,0x29,0x20,0x7b,0x20,0x2f,0x2f,0x20,0x4e,0x65,0x73,0x74,0x69,0x6e,0x67,0x20,0x74,0x68,0x65,0x20,0x69,0x66,0x73,0x20,0x69,0x6e,0x73,0x74,0x65,0x61,0x64,0x20,0x6f,0x66,0x20,0x75,0x73,0x69,0x6e,0x67,0x20,0x26,0x26,0x20,0x74,0x6f,0x20,0x77,0x6f,0x72,0x6b,0x20,0x61,0x72,0x6f,0x75,0x6e,0x64,0x20,0x61,0x20,0x67,0x6c,0x73,0x6c,0x61,0x6e,0x67,0x20,0x62,0x75,0x67,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x50,0x69,0x78,0x65,0x6c,0x43,0x6f,0x6c,0x6f,0x72,0x2e,0x61,0x20,0x3c,0x3d,0x20,0x4d,0x61,0x74,0x65,0x72,0x69,0x61,0x6c,0x2e,0x61,0x6c,0x70,0x68,0x61,0x43,0x75,0x74,0x6f,0x66,0x66,0x29,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x64,0x69,0x73,0x63,0x61,0x72,0x64,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x7d,0x0a,0x7d,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x0a,0x23,0x69,0x66,0x64,0x65,0x66,0x20,0x47,0x4c,0x5f,0x43,0x4f,0x4d,0x50,0x55,0x54,0x45,0x5f,0x53,0x48,0x41,0x44,0x45,0x52,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6c,0x6f,0x76,0x72,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x20,0x7b,0x0a,0x20,0x20,0x6c,0x6f,0x76,0x72,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x7d,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,0x23,0x65,0x6e,0x64,0x69,0x66,0x0a,};
+const unsigned int etc_shaders_lovr_glsl_len = sizeof(etc_shaders_lovr_glsl);
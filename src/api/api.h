@@ -27,6 +27,7 @@ extern StringEntry lovrBlockType[];
 extern StringEntry lovrBufferLayout[];
 extern StringEntry lovrChannelLayout[];
 extern StringEntry lovrCompareMode[];
+extern StringEntry lovrContactEvent[];
 extern StringEntry lovrCullMode[];
 extern StringEntry lovrDataType[];
 extern StringEntry lovrDefaultAttribute[];
@@ -54,6 +55,9 @@ extern StringEntry lovrOpenMode[];
 extern StringEntry lovrOriginType[];
 extern StringEntry lovrPassType[];
 extern StringEntry lovrPermission[];
+extern StringEntry lovrRandomAlgorithm[];
+extern StringEntry lovrRandomDistribution[];
+extern StringEntry lovrResamplerMode[];
 extern StringEntry lovrSampleFormat[];
 extern StringEntry lovrShaderStage[];
 extern StringEntry lovrShaderType[];
@@ -43,6 +43,13 @@ StringEntry lovrAudioType[] = {
   { 0 }
 };
 
+StringEntry lovrResamplerMode[] = {
+  [RESAMPLER_LINEAR] = ENTRY("linear"),
+  [RESAMPLER_CUBIC] = ENTRY("cubic"),
+  [RESAMPLER_SINC] = ENTRY("sinc"),
+  { 0 }
+};
+
 StringEntry lovrTimeUnit[] = {
   [UNIT_SECONDS] = ENTRY("seconds"),
   [UNIT_FRAMES] = ENTRY("frames"),
@@ -205,6 +212,82 @@ static int l_lovrAudioSetGeometry(lua_State* L) {
   return 1;
 }
 
+static int l_lovrAudioRender(lua_State* L) {
+  uint32_t frames = luax_checku32(L, 1);
+  double averageTime, peakTime;
+  Sound* sound = lovrAudioRender(frames, &averageTime, &peakTime);
+  luax_pushtype(L, Sound, sound);
+  lovrRelease(sound, lovrSoundDestroy);
+  lua_pushnumber(L, averageTime);
+  lua_pushnumber(L, peakTime);
+  return 3;
+}
+
+static int l_lovrAudioGetMaxVoices(lua_State* L) {
+  lua_pushinteger(L, lovrAudioGetMaxVoices());
+  return 1;
+}
+
+static int l_lovrAudioSetMaxVoices(lua_State* L) {
+  uint32_t count = luax_checku32(L, 1);
+  lovrAudioSetMaxVoices(count);
+  return 0;
+}
+
+static int l_lovrAudioGetSampleCache(lua_State* L) {
+  float duration;
+  size_t budget, size;
+  uint32_t count;
+  lovrAudioGetSampleCache(&duration, &budget, &size, &count);
+  lua_pushnumber(L, duration);
+  lua_pushinteger(L, budget);
+  lua_pushinteger(L, size);
+  lua_pushinteger(L, count);
+  return 4;
+}
+
+static int l_lovrAudioSetSampleCache(lua_State* L) {
+  float duration = luax_checkfloat(L, 1);
+  float oldDuration;
+  size_t oldBudget, size;
+  uint32_t count;
+  lovrAudioGetSampleCache(&oldDuration, &oldBudget, &size, &count);
+  lua_Integer budget = luaL_optinteger(L, 2, (lua_Integer) oldBudget);
+  luax_check(L, duration >= 0.f, "Sample cache duration can not be negative");
+  luax_check(L, budget >= 0, "Sample cache budget can not be negative");
+  lovrAudioSetSampleCache(duration, (size_t) budget);
+  return 0;
+}
+
+static int l_lovrAudioGetResampler(lua_State* L) {
+  luax_pushenum(L, ResamplerMode, lovrAudioGetResampler());
+  return 1;
+}
+
+static int l_lovrAudioSetResampler(lua_State* L) {
+  ResamplerMode mode = luax_checkenum(L, 1, ResamplerMode, NULL);
+  lovrAudioSetResampler(mode);
+  return 0;
+}
+
+static int l_lovrAudioGetResamplerStats(lua_State* L) {
+  uint32_t frames[3];
+  double time[3];
+  lovrAudioGetResamplerStats(frames, time);
+  lua_createtable(L, 0, 3);
+  for (uint32_t i = 0; i < 3; i++) {
+    lua_createtable(L, 0, 2);
+    lua_pushinteger(L, frames[i]);
+    lua_setfield(L, -2, "frames");
+    lua_pushnumber(L, time[i]);
+    lua_setfield(L, -2, "time");
+    luax_pushenum(L, ResamplerMode, i);
+    lua_insert(L, -2);
+    lua_settable(L, -3);
+  }
+  return 1;
+}
+
 static int l_lovrAudioGetSpatializer(lua_State *L) {
   lua_pushstring(L, lovrAudioGetSpatializer());
   return 1;
@@ -240,6 +323,7 @@ static int l_lovrAudioNewSource(lua_State* L) {
   bool pitchable = true;
   bool spatial = true;
   uint32_t effects = ~0u;
+  ResamplerMode resampler = lovrAudioGetResampler();
   if (lua_gettop(L) >= 2) {
     luaL_checktype(L, 2, LUA_TTABLE);
 
@@ -273,6 +357,10 @@ static int l_lovrAudioNewSource(lua_State* L) {
     lua_getfield(L, 2, "spatial");
     if (!lua_isnil(L, -1)) spatial = lua_toboolean(L, -1);
     lua_pop(L, 1);
+
+    lua_getfield(L, 2, "resampler");
+    if (!lua_isnil(L, -1)) resampler = luax_checkenum(L, -1, ResamplerMode, NULL);
+    lua_pop(L, 1);
   }
 
   if (!sound) {
@@ -283,7 +371,7 @@ static int l_lovrAudioNewSource(lua_State* L) {
     lovrRetain(sound);
   }
 
-  Source* source = lovrSourceCreate(sound, pitchable, spatial, effects);
+  Source* source = lovrSourceCreate(sound, pitchable, spatial, effects, resampler);
   lovrRelease(sound, lovrSoundDestroy);
   luax_assert(L, source);
   luax_pushtype(L, Source, source);
@@ -291,6 +379,13 @@ static int l_lovrAudioNewSource(lua_State* L) {
   return 1;
 }
 
+static int l_lovrAudioNewBus(lua_State* L) {
+  Bus* bus = lovrBusCreate();
+  luax_pushtype(L, Bus, bus);
+  lovrRelease(bus, lovrBusDestroy);
+  return 1;
+}
+
 static const luaL_Reg lovrAudio[] = {
   { "getDevices", l_lovrAudioGetDevices },
   { "getDevice", l_lovrAudioGetDevice },
@@ -307,20 +402,31 @@ static const luaL_Reg lovrAudio[] = {
   { "getPose", l_lovrAudioGetPose },
   { "setPose", l_lovrAudioSetPose },
   { "setGeometry", l_lovrAudioSetGeometry },
+  { "render", l_lovrAudioRender },
+  { "getMaxVoices", l_lovrAudioGetMaxVoices },
+  { "setMaxVoices", l_lovrAudioSetMaxVoices },
+  { "getSampleCache", l_lovrAudioGetSampleCache },
+  { "setSampleCache", l_lovrAudioSetSampleCache },
+  { "getResampler", l_lovrAudioGetResampler },
+  { "setResampler", l_lovrAudioSetResampler },
+  { "getResamplerStats", l_lovrAudioGetResamplerStats },
   { "getSpatializer", l_lovrAudioGetSpatializer },
   { "getSampleRate", l_lovrAudioGetSampleRate },
   { "getAbsorption", l_lovrAudioGetAbsorption },
   { "setAbsorption", l_lovrAudioSetAbsorption },
   { "newSource", l_lovrAudioNewSource },
+  { "newBus", l_lovrAudioNewBus },
   { NULL, NULL }
 };
 
 extern const luaL_Reg lovrSource[];
+extern const luaL_Reg lovrBus[];
 
 int luaopen_lovr_audio(lua_State* L) {
   bool start = true;
   const char *spatializer = NULL;
   uint32_t sampleRate = 48000; // Set default here
+  float readAhead = .25f;
   luax_pushconf(L);
   if (lua_istable(L, -1)) {
     lua_getfield(L, -1, "audio");
@@ -333,6 +439,10 @@ int luaopen_lovr_audio(lua_State* L) {
       sampleRate = lua_isnil(L, -1) ? sampleRate : luax_checku32(L, -1);
       lua_pop(L, 1);
 
+      lua_getfield(L, -1, "readahead");
+      readAhead = lua_isnil(L, -1) ? readAhead : luax_checkfloat(L, -1);
+      lua_pop(L, 1);
+
       lua_getfield(L, -1, "start");
       start = lua_isnil(L, -1) || lua_toboolean(L, -1);
       lua_pop(L, 1);
@@ -341,7 +451,7 @@ int luaopen_lovr_audio(lua_State* L) {
   }
   lua_pop(L, 1);
 
-  luax_assert(L, lovrAudioInit(spatializer, sampleRate));
+  luax_assert(L, lovrAudioInit(spatializer, sampleRate, readAhead));
   luax_atexit(L, lovrAudioDestroy);
 
   if (start) {
@@ -352,5 +462,6 @@ int luaopen_lovr_audio(lua_State* L) {
   lua_newtable(L);
   luax_register(L, lovrAudio);
   luax_registertype(L, Source);
+  luax_registertype(L, Bus);
   return 1;
 }
@@ -0,0 +1,82 @@
+#include "api.h"
+#include "audio/audio.h"
+#include "util.h"
+
+static int l_lovrBusGetVolume(lua_State* L) {
+  Bus* bus = luax_checktype(L, 1, Bus);
+  VolumeUnit units = luax_checkenum(L, 2, VolumeUnit, "linear");
+  lua_pushnumber(L, lovrBusGetVolume(bus, units));
+  return 1;
+}
+
+static int l_lovrBusSetVolume(lua_State* L) {
+  Bus* bus = luax_checktype(L, 1, Bus);
+  float volume = luax_checkfloat(L, 2);
+  VolumeUnit units = luax_checkenum(L, 3, VolumeUnit, "linear");
+  lovrBusSetVolume(bus, volume, units);
+  return 0;
+}
+
+static int l_lovrBusGetLowPass(lua_State* L) {
+  Bus* bus = luax_checktype(L, 1, Bus);
+  float cutoff = lovrBusGetLowPass(bus);
+  if (cutoff > 0.f) {
+    lua_pushnumber(L, cutoff);
+  } else {
+    lua_pushnil(L);
+  }
+  return 1;
+}
+
+static int l_lovrBusSetLowPass(lua_State* L) {
+  Bus* bus = luax_checktype(L, 1, Bus);
+  float cutoff = luax_optfloat(L, 2, 0.f);
+  lovrBusSetLowPass(bus, cutoff);
+  return 0;
+}
+
+static int l_lovrBusGetCompressor(lua_State* L) {
+  Bus* bus = luax_checktype(L, 1, Bus);
+  float threshold, ratio, attack, release;
+  lovrBusGetCompressor(bus, &threshold, &ratio, &attack, &release);
+  lua_pushnumber(L, threshold);
+  lua_pushnumber(L, ratio);
+  lua_pushnumber(L, attack);
+  lua_pushnumber(L, release);
+  return 4;
+}
+
+static int l_lovrBusSetCompressor(lua_State* L) {
+  Bus* bus = luax_checktype(L, 1, Bus);
+  float threshold = luax_optfloat(L, 2, 0.f);
+  float ratio = luax_optfloat(L, 3, 1.f);
+  float attack = luax_optfloat(L, 4, .01f);
+  float release = luax_optfloat(L, 5, .1f);
+  lovrBusSetCompressor(bus, threshold, ratio, attack, release);
+  return 0;
+}
+
+static int l_lovrBusGetReverb(lua_State* L) {
+  Bus* bus = luax_checktype(L, 1, Bus);
+  lua_pushnumber(L, lovrBusGetReverb(bus));
+  return 1;
+}
+
+static int l_lovrBusSetReverb(lua_State* L) {
+  Bus* bus = luax_checktype(L, 1, Bus);
+  float send = luax_optfloat(L, 2, 0.f);
+  lovrBusSetReverb(bus, send);
+  return 0;
+}
+
+const luaL_Reg lovrBus[] = {
+  { "getVolume", l_lovrBusGetVolume },
+  { "setVolume", l_lovrBusSetVolume },
+  { "getLowPass", l_lovrBusGetLowPass },
+  { "setLowPass", l_lovrBusSetLowPass },
+  { "getCompressor", l_lovrBusGetCompressor },
+  { "setCompressor", l_lovrBusSetCompressor },
+  { "getReverb", l_lovrBusGetReverb },
+  { "setReverb", l_lovrBusSetReverb },
+  { NULL, NULL }
+};
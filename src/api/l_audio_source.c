@@ -99,6 +99,25 @@ static int l_lovrSourceTell(lua_State* L) {
   return 1;
 }
 
+static int l_lovrSourceGetPriority(lua_State* L) {
+  Source* source = luax_checktype(L, 1, Source);
+  lua_pushinteger(L, lovrSourceGetPriority(source));
+  return 1;
+}
+
+static int l_lovrSourceSetPriority(lua_State* L) {
+  Source* source = luax_checktype(L, 1, Source);
+  int priority = luaL_checkinteger(L, 2);
+  lovrSourceSetPriority(source, priority);
+  return 0;
+}
+
+static int l_lovrSourceIsVirtual(lua_State* L) {
+  Source* source = luax_checktype(L, 1, Source);
+  lua_pushboolean(L, lovrSourceIsVirtual(source));
+  return 1;
+}
+
 static int l_lovrSourceGetDuration(lua_State* L) {
   Source* source = luax_checktype(L, 1, Source);
   TimeUnit units = luax_checkenum(L, 2, TimeUnit, "seconds");
@@ -224,6 +243,26 @@ static int l_lovrSourceIsSpatial(lua_State* L) {
   return 1;
 }
 
+static int l_lovrSourceGetResampler(lua_State* L) {
+  Source* source = luax_checktype(L, 1, Source);
+  luax_pushenum(L, ResamplerMode, lovrSourceGetResampler(source));
+  return 1;
+}
+
+static int l_lovrSourceGetBus(lua_State* L) {
+  Source* source = luax_checktype(L, 1, Source);
+  Bus* bus = lovrSourceGetBus(source);
+  luax_pushtype(L, Bus, bus);
+  return 1;
+}
+
+static int l_lovrSourceSetBus(lua_State* L) {
+  Source* source = luax_checktype(L, 1, Source);
+  Bus* bus = lua_isnoneornil(L, 2) ? NULL : luax_checktype(L, 2, Bus);
+  lovrSourceSetBus(source, bus);
+  return 0;
+}
+
 const luaL_Reg lovrSource[] = {
   { "clone", l_lovrSourceClone },
   { "getSound", l_lovrSourceGetSound },
@@ -239,6 +278,9 @@ const luaL_Reg lovrSource[] = {
   { "setVolume", l_lovrSourceSetVolume },
   { "seek", l_lovrSourceSeek },
   { "tell", l_lovrSourceTell },
+  { "getPriority", l_lovrSourceGetPriority },
+  { "setPriority", l_lovrSourceSetPriority },
+  { "isVirtual", l_lovrSourceIsVirtual },
   { "getDuration", l_lovrSourceGetDuration },
   { "getPosition", l_lovrSourceGetPosition },
   { "setPosition", l_lovrSourceSetPosition },
@@ -253,5 +295,8 @@ const luaL_Reg lovrSource[] = {
   { "isEffectEnabled", l_lovrSourceIsEffectEnabled },
   { "setEffectEnabled", l_lovrSourceSetEffectEnabled },
   { "isSpatial", l_lovrSourceIsSpatial },
+  { "getResampler", l_lovrSourceGetResampler },
+  { "getBus", l_lovrSourceGetBus },
+  { "setBus", l_lovrSourceSetBus },
   { NULL, NULL }
 };
@@ -394,6 +394,42 @@ static int l_lovrGraphicsSetTimingEnabled(lua_State* L) {
   return 0;
 }
 
+static int l_lovrGraphicsGetTimings(lua_State* L) {
+  uint32_t count;
+  const GraphicsTiming* timings = lovrGraphicsGetTimings(&count);
+  lua_createtable(L, count, 0);
+  lua_newtable(L);
+
+  // Parents always come before their children, so zones can be attached as they are created
+  for (uint32_t i = 0; i < count; i++) {
+    lua_createtable(L, 0, 4);
+    lua_pushstring(L, timings[i].label);
+    lua_setfield(L, -2, "label");
+    lua_pushnumber(L, timings[i].cpuTime);
+    lua_setfield(L, -2, "cpuTime");
+    lua_pushnumber(L, timings[i].gpuTime);
+    lua_setfield(L, -2, "gpuTime");
+    lua_newtable(L);
+    lua_setfield(L, -2, "children");
+
+    lua_pushvalue(L, -1);
+    lua_rawseti(L, -4, i + 1);
+
+    if (timings[i].parent == ~0u) {
+      lua_rawseti(L, -2, luax_len(L, -2) + 1);
+    } else {
+      lua_rawgeti(L, -3, timings[i].parent + 1);
+      lua_getfield(L, -1, "children");
+      lua_pushvalue(L, -3);
+      lua_rawseti(L, -2, luax_len(L, -2) + 1);
+      lua_pop(L, 3);
+    }
+  }
+
+  lua_remove(L, -2);
+  return 1;
+}
+
 static int l_lovrGraphicsSubmit(lua_State* L) {
   bool table = lua_istable(L, 1);
   int length = table ? luax_len(L, 1) : lua_gettop(L);
@@ -1546,6 +1582,7 @@ static const luaL_Reg lovrGraphics[] = {
   { "isInitialized", l_lovrGraphicsIsInitialized },
   { "isTimingEnabled", l_lovrGraphicsIsTimingEnabled },
   { "setTimingEnabled", l_lovrGraphicsSetTimingEnabled },
+  { "getTimings", l_lovrGraphicsGetTimings },
   { "submit", l_lovrGraphicsSubmit },
   { "present", l_lovrGraphicsPresent },
   { "wait", l_lovrGraphicsWait },
@@ -1,5 +1,6 @@
 #include "api.h"
 #include "graphics/graphics.h"
+#include "data/blob.h"
 #include "data/rasterizer.h"
 #include "util.h"
 #include <stdlib.h>
@@ -171,6 +172,73 @@ static int l_lovrFontGetVertices(lua_State* L) {
   return 2;
 }
 
+static int l_lovrFontPrewarm(lua_State* L) {
+  Font* font = luax_checktype(L, 1, Font);
+  arr_t(uint32_t) codepoints;
+  arr_init(&codepoints);
+
+  int top = lua_gettop(L);
+  for (int i = 2; i <= top; i++) {
+    switch (lua_type(L, i)) {
+      case LUA_TSTRING: {
+        size_t length, bytes;
+        const char* str = lua_tolstring(L, i, &length);
+        const char* end = str + length;
+        uint32_t codepoint;
+        while ((bytes = utf8_decode(str, end, &codepoint)) > 0) {
+          arr_push(&codepoints, codepoint);
+          str += bytes;
+        }
+        break;
+      }
+      case LUA_TNUMBER:
+        arr_push(&codepoints, luax_checku32(L, i));
+        break;
+      case LUA_TTABLE: {
+        lua_rawgeti(L, i, 1);
+        lua_rawgeti(L, i, 2);
+        uint32_t first = luax_checku32(L, -2);
+        uint32_t last = luax_checku32(L, -1);
+        lua_pop(L, 2);
+        if (first > last || last > 0x10ffff) {
+          arr_free(&codepoints);
+          return luaL_error(L, "Invalid codepoint range");
+        }
+        for (uint32_t codepoint = first; codepoint <= last; codepoint++) {
+          arr_push(&codepoints, codepoint);
+        }
+        break;
+      }
+      default:
+        arr_free(&codepoints);
+        return luax_typeerror(L, i, "string, number, or table");
+    }
+  }
+
+  bool success = lovrFontPrewarm(font, codepoints.data, (uint32_t) codepoints.length);
+  arr_free(&codepoints);
+  luax_assert(L, success);
+  return 0;
+}
+
+static int l_lovrFontGetCache(lua_State* L) {
+  Font* font = luax_checktype(L, 1, Font);
+  Blob* blob = lovrFontGetCache(font);
+  luax_assert(L, blob);
+  luax_pushtype(L, Blob, blob);
+  lovrRelease(blob, lovrBlobDestroy);
+  return 1;
+}
+
+static int l_lovrFontLoadCache(lua_State* L) {
+  Font* font = luax_checktype(L, 1, Font);
+  Blob* blob = luax_checktype(L, 2, Blob);
+  bool loaded;
+  luax_assert(L, lovrFontLoadCache(font, blob, &loaded));
+  lua_pushboolean(L, loaded);
+  return 1;
+}
+
 const luaL_Reg lovrFont[] = {
   { "getRasterizer", l_lovrFontGetRasterizer },
   { "getPixelDensity", l_lovrFontGetPixelDensity },
@@ -184,5 +252,8 @@ const luaL_Reg lovrFont[] = {
   { "getWidth", l_lovrFontGetWidth },
   { "getLines", l_lovrFontGetLines },
   { "getVertices", l_lovrFontGetVertices },
+  { "prewarm", l_lovrFontPrewarm },
+  { "getCache", l_lovrFontGetCache },
+  { "loadCache", l_lovrFontLoadCache },
   { NULL, NULL }
 };
@@ -1055,6 +1055,19 @@ static int l_lovrPassSetTallyBuffer(lua_State* L) {
   return 0;
 }
 
+static int l_lovrPassBeginTimer(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  const char* label = luaL_checkstring(L, 2);
+  luax_assert(L, lovrPassBeginTimer(pass, label));
+  return 0;
+}
+
+static int l_lovrPassEndTimer(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  luax_assert(L, lovrPassEndTimer(pass));
+  return 0;
+}
+
 static int l_lovrPassCompute(lua_State* L) {
   Pass* pass = luax_checktype(L, 1, Pass);
   Buffer* buffer = luax_totype(L, 2, Buffer);
@@ -1076,6 +1089,41 @@ static int l_lovrPassBarrier(lua_State* L) {
   return 0;
 }
 
+static int l_lovrPassBuildDepthPyramid(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  Texture* texture = luax_checktype(L, 2, Texture);
+  if (lua_isnoneornil(L, 3)) {
+    luax_assert(L, lovrPassBuildDepthPyramid(pass, texture, NULL));
+  } else {
+    float viewProjection[16];
+    luax_readmat4(L, 3, viewProjection, 1);
+    luax_assert(L, lovrPassBuildDepthPyramid(pass, texture, viewProjection));
+  }
+  return 0;
+}
+
+static int l_lovrPassCullDraws(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  Buffer* bounds = luax_checktype(L, 2, Buffer);
+  Buffer* draws = luax_checktype(L, 3, Buffer);
+  Buffer* output = luax_checktype(L, 4, Buffer);
+  uint32_t count = luax_checku32(L, 5);
+  bool indexed = lua_isnoneornil(L, 6) ? true : lua_toboolean(L, 6);
+  luax_assert(L, lovrPassCullDraws(pass, bounds, draws, output, count, indexed));
+  return 0;
+}
+
+static int l_lovrPassCullInstances(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  Buffer* bounds = luax_checktype(L, 2, Buffer);
+  Buffer* output = luax_checktype(L, 3, Buffer);
+  Buffer* draws = luax_checktype(L, 4, Buffer);
+  uint32_t count = luax_checku32(L, 5);
+  uint32_t offset = luax_optu32(L, 6, 0);
+  luax_assert(L, lovrPassCullInstances(pass, bounds, output, draws, offset, count));
+  return 0;
+}
+
 static int l_lovrPassToString(lua_State* L) {
   Pass* pass = luax_checktype(L, 1, Pass);
   const char* label = lovrPassGetLabel(pass);
@@ -1163,8 +1211,14 @@ const luaL_Reg lovrPass[] = {
   { "getTallyBuffer", l_lovrPassGetTallyBuffer },
   { "setTallyBuffer", l_lovrPassSetTallyBuffer },
 
+  { "beginTimer", l_lovrPassBeginTimer },
+  { "endTimer", l_lovrPassEndTimer },
+
   { "compute", l_lovrPassCompute },
   { "barrier", l_lovrPassBarrier },
+  { "buildDepthPyramid", l_lovrPassBuildDepthPyramid },
+  { "cullDraws", l_lovrPassCullDraws },
+  { "cullInstances", l_lovrPassCullInstances },
 
   { "__tostring", l_lovrPassToString },
 
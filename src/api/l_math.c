@@ -1,6 +1,10 @@
 #include "api.h"
 #include "math/math.h"
 #include "util.h"
+#ifndef LOVR_DISABLE_DATA
+#include "data/blob.h"
+#include "data/image.h"
+#endif
 #include <threads.h>
 #include <stdlib.h>
 #include <string.h>
@@ -31,6 +35,21 @@ extern const luaL_Reg lovrVec3[];
 extern const luaL_Reg lovrVec4[];
 extern const luaL_Reg lovrQuat[];
 extern const luaL_Reg lovrMat4[];
+extern const luaL_Reg lovrVectorArray[];
+
+StringEntry lovrRandomAlgorithm[] = {
+  [RANDOM_XORSHIFT] = ENTRY("xorshift"),
+  [RANDOM_XOSHIRO] = ENTRY("xoshiro"),
+  { 0 }
+};
+
+StringEntry lovrRandomDistribution[] = {
+  [RANDOM_UNIFORM] = ENTRY("uniform"),
+  [RANDOM_NORMAL] = ENTRY("normal"),
+  [RANDOM_IN_SPHERE] = ENTRY("insphere"),
+  [RANDOM_ON_SPHERE] = ENTRY("onsphere"),
+  { 0 }
+};
 
 static thread_local Pool* pool;
 static thread_local int metaref[MAX_VECTOR_TYPES];
@@ -134,7 +153,13 @@ static int l_lovrMathNewCurve(lua_State* L) {
 }
 
 static int l_lovrMathNewRandomGenerator(lua_State* L) {
-  RandomGenerator* generator = lovrRandomGeneratorCreate();
+  RandomAlgorithm algorithm = RANDOM_XORSHIFT;
+  if (lua_istable(L, lua_gettop(L))) {
+    lua_getfield(L, -1, "algorithm");
+    if (!lua_isnil(L, -1)) algorithm = luax_checkenum(L, -1, RandomAlgorithm, NULL);
+    lua_pop(L, 2);
+  }
+  RandomGenerator* generator = lovrRandomGeneratorCreate(algorithm);
   if (lua_gettop(L) > 0){
     Seed seed = { .b64 = luax_checkrandomseed(L, 1) };
     lovrRandomGeneratorSetSeed(generator, seed);
@@ -157,6 +182,73 @@ static int l_lovrMathNoise(lua_State* L) {
   }
 }
 
+static int l_lovrMathNoiseField(lua_State* L) {
+  NoiseInfo info = {
+    .frequency = luax_optfloat(L, 3, 1.f),
+    .octaves = luax_optu32(L, 4, 1),
+    .lacunarity = luax_optfloat(L, 5, 2.f),
+    .gain = luax_optfloat(L, 6, .5f)
+  };
+
+  luax_readvec3(L, 7, info.offset, NULL);
+
+  if (lua_istable(L, 2)) {
+    info.dimensions = luax_len(L, 2);
+    luax_check(L, info.dimensions >= 1 && info.dimensions <= 3, "Noise field must have 1, 2, or 3 dimensions");
+    for (uint32_t i = 0; i < info.dimensions; i++) {
+      lua_rawgeti(L, 2, i + 1);
+      info.size[i] = luax_checku32(L, -1);
+      lua_pop(L, 1);
+    }
+  } else if (!lua_isnoneornil(L, 2)) {
+    info.dimensions = 1;
+    info.size[0] = luax_checku32(L, 2);
+  }
+
+#ifndef LOVR_DISABLE_DATA
+  Image* image = luax_totype(L, 1, Image);
+
+  if (image) {
+    info.dimensions = 2;
+    info.size[0] = lovrImageGetWidth(image, 0);
+    info.size[1] = lovrImageGetHeight(image, 0);
+
+    if (lovrImageGetFormat(image) == FORMAT_R32F) {
+      luax_assert(L, lovrMathNoiseField(&info, lovrImageGetLayerData(image, 0, 0)));
+    } else {
+      float* data = lovrMalloc(info.size[0] * info.size[1] * sizeof(float));
+      if (!lovrMathNoiseField(&info, data)) {
+        lovrFree(data);
+        luax_assert(L, false);
+      }
+      bool success = true;
+      for (uint32_t y = 0; y < info.size[1] && success; y++) {
+        for (uint32_t x = 0; x < info.size[0] && success; x++) {
+          float value = data[y * info.size[0] + x];
+          float pixel[4] = { value, value, value, 1.f };
+          success = lovrImageSetPixel(image, x, y, pixel);
+        }
+      }
+      lovrFree(data);
+      luax_assert(L, success);
+    }
+
+    lua_settop(L, 1);
+    return 1;
+  }
+
+  Blob* blob = luax_checktype(L, 1, Blob);
+  luax_check(L, info.dimensions > 0, "Noise field size is required when filling a Blob");
+  size_t count = (size_t) info.size[0] * MAX(info.size[1], 1) * MAX(info.size[2], 1);
+  luax_check(L, count * sizeof(float) <= blob->size, "Blob is too small to hold %d floats", (int) count);
+  luax_assert(L, lovrMathNoiseField(&info, blob->data));
+  lua_settop(L, 1);
+  return 1;
+#else
+  return luaL_error(L, "lovr.math.noiseField requires the data module");
+#endif
+}
+
 static int l_lovrMathRandom(lua_State* L) {
   luax_pushtype(L, RandomGenerator, lovrMathGetRandomGenerator());
   lua_insert(L, 1);
@@ -277,6 +369,50 @@ static int l_lovrMathMat4(lua_State* L) {
   return l_lovrMat4Set(L);
 }
 
+static int l_lovrMathNewVectorArray(lua_State* L, VectorType type) {
+  VectorArray* array;
+#ifndef LOVR_DISABLE_DATA
+  static const size_t strides[] = { [V_VEC2] = 8, [V_VEC3] = 12, [V_VEC4] = 16, [V_MAT4] = 64 };
+  size_t stride = strides[type];
+  Blob* blob = luax_totype(L, 1, Blob);
+  if (blob) {
+    luax_check(L, blob->size > 0 && blob->size % stride == 0, "Blob size must be a nonzero multiple of %d bytes", (int) stride);
+    array = lovrVectorArrayCreate(type, blob->size / stride, blob->data, blob, lovrBlobDestroy);
+  } else {
+    uint32_t count = luax_checku32(L, 1);
+    luax_check(L, count > 0, "VectorArray count must be positive");
+    void* data = lovrCalloc(count * stride);
+    blob = lovrBlobCreate(data, count * stride, "VectorArray");
+    array = lovrVectorArrayCreate(type, count, data, blob, lovrBlobDestroy);
+    lovrRelease(blob, lovrBlobDestroy);
+  }
+#else
+  uint32_t count = luax_checku32(L, 1);
+  luax_check(L, count > 0, "VectorArray count must be positive");
+  array = lovrVectorArrayCreate(type, count, NULL, NULL, NULL);
+#endif
+  luax_assert(L, array);
+  luax_pushtype(L, VectorArray, array);
+  lovrRelease(array, lovrVectorArrayDestroy);
+  return 1;
+}
+
+static int l_lovrMathNewVec2Array(lua_State* L) {
+  return l_lovrMathNewVectorArray(L, V_VEC2);
+}
+
+static int l_lovrMathNewVec3Array(lua_State* L) {
+  return l_lovrMathNewVectorArray(L, V_VEC3);
+}
+
+static int l_lovrMathNewVec4Array(lua_State* L) {
+  return l_lovrMathNewVectorArray(L, V_VEC4);
+}
+
+static int l_lovrMathNewMat4Array(lua_State* L) {
+  return l_lovrMathNewVectorArray(L, V_MAT4);
+}
+
 static int l_lovrMathDrain(lua_State* L) {
   lovrPoolDrain(pool);
   return 0;
@@ -286,6 +422,7 @@ static const luaL_Reg lovrMath[] = {
   { "newCurve", l_lovrMathNewCurve },
   { "newRandomGenerator", l_lovrMathNewRandomGenerator },
   { "noise", l_lovrMathNoise },
+  { "noiseField", l_lovrMathNoiseField },
   { "random", l_lovrMathRandom },
   { "randomNormal", l_lovrMathRandomNormal },
   { "getRandomSeed", l_lovrMathGetRandomSeed },
@@ -297,6 +434,10 @@ static const luaL_Reg lovrMath[] = {
   { "newVec4", l_lovrMathNewVec4 },
   { "newQuat", l_lovrMathNewQuat },
   { "newMat4", l_lovrMathNewMat4 },
+  { "newVec2Array", l_lovrMathNewVec2Array },
+  { "newVec3Array", l_lovrMathNewVec3Array },
+  { "newVec4Array", l_lovrMathNewVec4Array },
+  { "newMat4Array", l_lovrMathNewMat4Array },
   { "drain", l_lovrMathDrain },
   { NULL, NULL }
 };
@@ -355,6 +496,7 @@ int luaopen_lovr_math(lua_State* L) {
   luax_register(L, lovrMath);
   luax_registertype(L, Curve);
   luax_registertype(L, RandomGenerator);
+  luax_registertype(L, VectorArray);
 
   for (size_t i = V_NONE + 1; i < MAX_VECTOR_TYPES; i++) {
     lua_newtable(L);
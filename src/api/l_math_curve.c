@@ -1,6 +1,10 @@
 #include "api.h"
 #include "util.h"
 
+#ifndef LOVR_DISABLE_DATA
+#include "data/blob.h"
+#endif
+
 static int l_lovrCurveEvaluate(lua_State* L) {
   Curve* curve = luax_checktype(L, 1, Curve);
   float t = luax_checkfloat(L, 2);
@@ -12,6 +16,54 @@ static int l_lovrCurveEvaluate(lua_State* L) {
   return 3;
 }
 
+static int l_lovrCurveEvaluateMany(lua_State* L) {
+  Curve* curve = luax_checktype(L, 1, Curve);
+  float t1 = luax_checkfloat(L, 2);
+  float t2 = luax_checkfloat(L, 3);
+  uint32_t count = luax_checku32(L, 4);
+  bool uniform = lua_toboolean(L, 6);
+  float* points;
+  size_t stride;
+  VectorArray* array = luax_totype(L, 5, VectorArray);
+  if (array) {
+    VectorType type = lovrVectorArrayGetType(array);
+    luax_check(L, type == V_VEC3 || type == V_VEC4, "Curve points can only be written to vec3 or vec4 arrays");
+    luax_check(L, count <= lovrVectorArrayGetCount(array), "VectorArray is too small to hold %d points", count);
+    points = lovrVectorArrayGetData(array);
+    stride = lovrVectorArrayGetComponents(array);
+  } else {
+#ifndef LOVR_DISABLE_DATA
+    Blob* blob = luax_totype(L, 5, Blob);
+    if (!blob) return luax_typeerror(L, 5, "VectorArray or Blob");
+    luax_check(L, count * 3 * sizeof(float) <= blob->size, "Blob is too small to hold %d points", count);
+    points = blob->data;
+    stride = 3;
+#else
+    return luax_typeerror(L, 5, "VectorArray");
+#endif
+  }
+  luax_assert(L, lovrCurveEvaluateMany(curve, t1, t2, count, uniform, points, stride));
+  lua_settop(L, 5);
+  return 1;
+}
+
+static int l_lovrCurveEvaluateDistance(lua_State* L) {
+  Curve* curve = luax_checktype(L, 1, Curve);
+  float distance = luax_checkfloat(L, 2);
+  float point[4];
+  luax_assert(L, lovrCurveEvaluateDistance(curve, distance, point));
+  lua_pushnumber(L, point[0]);
+  lua_pushnumber(L, point[1]);
+  lua_pushnumber(L, point[2]);
+  return 3;
+}
+
+static int l_lovrCurveGetLength(lua_State* L) {
+  Curve* curve = luax_checktype(L, 1, Curve);
+  lua_pushnumber(L, lovrCurveGetLength(curve));
+  return 1;
+}
+
 static int l_lovrCurveGetTangent(lua_State* L) {
   Curve* curve = luax_checktype(L, 1, Curve);
   float t = luax_checkfloat(L, 2);
@@ -105,6 +157,9 @@ static int l_lovrCurveRemovePoint(lua_State* L) {
 
 const luaL_Reg lovrCurve[] = {
   { "evaluate", l_lovrCurveEvaluate },
+  { "evaluateMany", l_lovrCurveEvaluateMany },
+  { "evaluateDistance", l_lovrCurveEvaluateDistance },
+  { "getLength", l_lovrCurveGetLength },
   { "getTangent", l_lovrCurveGetTangent },
   { "render", l_lovrCurveRender },
   { "slice", l_lovrCurveSlice },
@@ -2,6 +2,10 @@
 #include "util.h"
 #include <math.h>
 
+#ifndef LOVR_DISABLE_DATA
+#include "data/blob.h"
+#endif
+
 static double luax_checkrandomseedpart(lua_State* L, int index) {
   double x = luaL_checknumber(L, index);
 
@@ -42,8 +46,8 @@ int l_lovrRandomGeneratorSetSeed(lua_State* L) {
 
 static int l_lovrRandomGeneratorGetState(lua_State* L) {
   RandomGenerator* generator = luax_checktype(L, 1, RandomGenerator);
-  size_t length = 32;
-  char state[32];
+  size_t length = 80;
+  char state[80];
   lovrRandomGeneratorGetState(generator, state, length);
   lua_pushstring(L, state);
   return 1;
@@ -52,9 +56,7 @@ static int l_lovrRandomGeneratorGetState(lua_State* L) {
 static int l_lovrRandomGeneratorSetState(lua_State* L) {
   RandomGenerator* generator = luax_checktype(L, 1, RandomGenerator);
   const char* state = luaL_checklstring(L, 2, NULL);
-  if (lovrRandomGeneratorSetState(generator, state)) {
-    luaL_error(L, "invalid random state %s", state);
-  }
+  luax_assert(L, lovrRandomGeneratorSetState(generator, state));
   return 0;
 }
 
@@ -84,6 +86,61 @@ int l_lovrRandomGeneratorRandomNormal(lua_State* L) {
   return 1;
 }
 
+static int l_lovrRandomGeneratorGetAlgorithm(lua_State* L) {
+  RandomGenerator* generator = luax_checktype(L, 1, RandomGenerator);
+  luax_pushenum(L, RandomAlgorithm, lovrRandomGeneratorGetAlgorithm(generator));
+  return 1;
+}
+
+static int l_lovrRandomGeneratorJump(lua_State* L) {
+  RandomGenerator* generator = luax_checktype(L, 1, RandomGenerator);
+  uint32_t count = luax_optu32(L, 2, 1);
+  for (uint32_t i = 0; i < count; i++) {
+    luax_assert(L, lovrRandomGeneratorJump(generator));
+  }
+  return 0;
+}
+
+static int l_lovrRandomGeneratorFill(lua_State* L) {
+  RandomGenerator* generator = luax_checktype(L, 1, RandomGenerator);
+  RandomDistribution distribution = luax_checkenum(L, 4, RandomDistribution, "uniform");
+  bool sphere = distribution == RANDOM_IN_SPHERE || distribution == RANDOM_ON_SPHERE;
+  float* data;
+  size_t capacity;
+  size_t stride;
+
+  VectorArray* array = luax_totype(L, 2, VectorArray);
+  if (array) {
+    size_t components = lovrVectorArrayGetComponents(array);
+    data = lovrVectorArrayGetData(array);
+    if (sphere) {
+      VectorType type = lovrVectorArrayGetType(array);
+      luax_check(L, type == V_VEC3 || type == V_VEC4, "Sphere distributions can only be written to vec3 or vec4 arrays");
+      capacity = lovrVectorArrayGetCount(array);
+      stride = components;
+    } else {
+      capacity = lovrVectorArrayGetCount(array) * components;
+      stride = 1;
+    }
+  } else {
+#ifndef LOVR_DISABLE_DATA
+    Blob* blob = luax_totype(L, 2, Blob);
+    if (!blob) return luax_typeerror(L, 2, "VectorArray or Blob");
+    data = blob->data;
+    stride = sphere ? 3 : 1;
+    capacity = blob->size / (stride * sizeof(float));
+#else
+    return luax_typeerror(L, 2, "VectorArray");
+#endif
+  }
+
+  size_t count = lua_isnoneornil(L, 3) ? capacity : luax_checku32(L, 3);
+  luax_check(L, count <= capacity, "Tried to generate %d values, but there is only room for %d", (int) count, (int) capacity);
+  lovrRandomGeneratorFill(generator, data, count, stride, distribution);
+  lua_settop(L, 2);
+  return 1;
+}
+
 const luaL_Reg lovrRandomGenerator[] = {
   { "getSeed", l_lovrRandomGeneratorGetSeed },
   { "setSeed", l_lovrRandomGeneratorSetSeed },
@@ -91,5 +148,8 @@ const luaL_Reg lovrRandomGenerator[] = {
   { "setState", l_lovrRandomGeneratorSetState },
   { "random", l_lovrRandomGeneratorRandom },
   { "randomNormal", l_lovrRandomGeneratorRandomNormal },
+  { "getAlgorithm", l_lovrRandomGeneratorGetAlgorithm },
+  { "jump", l_lovrRandomGeneratorJump },
+  { "fill", l_lovrRandomGeneratorFill },
   { NULL, NULL }
 };
@@ -0,0 +1,172 @@
+#include "api.h"
+#include "core/maf.h"
+#include "util.h"
+#include <string.h>
+
+#ifndef LOVR_DISABLE_DATA
+#include "data/blob.h"
+#endif
+
+static const char* typeNames[] = {
+  [V_VEC2] = "vec2",
+  [V_VEC3] = "vec3",
+  [V_VEC4] = "vec4",
+  [V_MAT4] = "mat4"
+};
+
+static int luax_readarrayvector(lua_State* L, int index, VectorType type, float* v) {
+  switch (type) {
+    case V_VEC2: return luax_readvec2(L, index, v, NULL);
+    case V_VEC3: return luax_readvec3(L, index, v, NULL);
+    case V_VEC4: return luax_readvec4(L, index, v, NULL);
+    case V_MAT4: return luax_readmat4(L, index, v, 3);
+    default: return index;
+  }
+}
+
+static size_t luax_checkarrayindex(lua_State* L, int index, VectorArray* array) {
+  lua_Integer i = luaL_checkinteger(L, index);
+  luax_check(L, i >= 1 && (size_t) i <= lovrVectorArrayGetCount(array), "Invalid VectorArray index: %d", (int) i);
+  return (size_t) i - 1;
+}
+
+static int l_lovrVectorArrayGetType(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  lua_pushstring(L, typeNames[lovrVectorArrayGetType(array)]);
+  return 1;
+}
+
+static int l_lovrVectorArrayGetCount(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  lua_pushinteger(L, lovrVectorArrayGetCount(array));
+  return 1;
+}
+
+static int l_lovrVectorArrayGetBlob(lua_State* L) {
+#ifndef LOVR_DISABLE_DATA
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  Blob* blob = lovrVectorArrayGetOwner(array);
+  luax_check(L, blob, "VectorArray does not have a Blob");
+  luax_pushtype(L, Blob, blob);
+  return 1;
+#else
+  return luaL_error(L, "VectorArray:getBlob requires the data module");
+#endif
+}
+
+static int l_lovrVectorArrayGet(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  size_t index = luax_checkarrayindex(L, 2, array);
+  size_t components = lovrVectorArrayGetComponents(array);
+  float* v = luax_newtempvector(L, lovrVectorArrayGetType(array));
+  memcpy(v, lovrVectorArrayGetData(array) + index * components, components * sizeof(float));
+  return 1;
+}
+
+static int l_lovrVectorArraySet(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  size_t index = luax_checkarrayindex(L, 2, array);
+  size_t components = lovrVectorArrayGetComponents(array);
+  float v[16];
+  luax_readarrayvector(L, 3, lovrVectorArrayGetType(array), v);
+  memcpy(lovrVectorArrayGetData(array) + index * components, v, components * sizeof(float));
+  return 0;
+}
+
+static int luax_addvectorarray(lua_State* L, float sign) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  VectorArray* other = luax_totype(L, 2, VectorArray);
+  if (other) {
+    luax_assert(L, lovrVectorArrayAdd(array, other, sign));
+  } else {
+    VectorType type = lovrVectorArrayGetType(array);
+    luax_check(L, type != V_MAT4, "mat4 arrays can only be added to other VectorArrays");
+    size_t components = lovrVectorArrayGetComponents(array);
+    float v[4];
+    luax_readarrayvector(L, 2, type, v);
+    for (size_t i = 0; i < components; i++) v[i] *= sign;
+    lovrVectorArrayAddVector(array, v);
+  }
+  lua_settop(L, 1);
+  return 1;
+}
+
+static int l_lovrVectorArrayAdd(lua_State* L) {
+  return luax_addvectorarray(L, 1.f);
+}
+
+static int l_lovrVectorArraySub(lua_State* L) {
+  return luax_addvectorarray(L, -1.f);
+}
+
+static int l_lovrVectorArrayScale(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  VectorType type = lovrVectorArrayGetType(array);
+  float v[16];
+  if (lua_type(L, 2) == LUA_TNUMBER) {
+    float s = luax_checkfloat(L, 2);
+    for (int i = 0; i < 16; i++) v[i] = s;
+  } else {
+    luax_check(L, type != V_MAT4, "mat4 arrays can only be scaled by a number");
+    luax_readarrayvector(L, 2, type, v);
+  }
+  lovrVectorArrayScale(array, v);
+  lua_settop(L, 1);
+  return 1;
+}
+
+static int l_lovrVectorArrayTransform(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  float m[16];
+  luax_readmat4(L, 2, m, 3);
+  lovrVectorArrayTransform(array, m);
+  lua_settop(L, 1);
+  return 1;
+}
+
+static int l_lovrVectorArrayNormalize(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  luax_check(L, lovrVectorArrayGetType(array) != V_MAT4, "mat4 arrays can not be normalized");
+  lovrVectorArrayNormalize(array);
+  lua_settop(L, 1);
+  return 1;
+}
+
+static int l_lovrVectorArrayLerp(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  VectorArray* other = luax_checktype(L, 2, VectorArray);
+  float t = luax_checkfloat(L, 3);
+  luax_assert(L, lovrVectorArrayLerp(array, other, t));
+  lua_settop(L, 1);
+  return 1;
+}
+
+static int l_lovrVectorArrayGetBounds(lua_State* L) {
+  VectorArray* array = luax_checktype(L, 1, VectorArray);
+  luax_check(L, lovrVectorArrayGetType(array) != V_MAT4, "mat4 arrays do not have bounds");
+  size_t components = lovrVectorArrayGetComponents(array);
+  float min[4], max[4];
+  lovrVectorArrayGetBounds(array, min, max);
+  for (size_t i = 0; i < components; i++) {
+    lua_pushnumber(L, min[i]);
+    lua_pushnumber(L, max[i]);
+  }
+  return (int) components * 2;
+}
+
+const luaL_Reg lovrVectorArray[] = {
+  { "getType", l_lovrVectorArrayGetType },
+  { "getCount", l_lovrVectorArrayGetCount },
+  { "__len", l_lovrVectorArrayGetCount },
+  { "getBlob", l_lovrVectorArrayGetBlob },
+  { "get", l_lovrVectorArrayGet },
+  { "set", l_lovrVectorArraySet },
+  { "add", l_lovrVectorArrayAdd },
+  { "sub", l_lovrVectorArraySub },
+  { "scale", l_lovrVectorArrayScale },
+  { "transform", l_lovrVectorArrayTransform },
+  { "normalize", l_lovrVectorArrayNormalize },
+  { "lerp", l_lovrVectorArrayLerp },
+  { "getBounds", l_lovrVectorArrayGetBounds },
+  { NULL, NULL }
+};
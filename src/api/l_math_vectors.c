@@ -246,6 +246,16 @@ static int l_lovrVec2Div(lua_State* L) {
   return 1;
 }
 
+static int l_lovrVec2Madd(lua_State* L) {
+  float* v = luax_checkvector(L, 1, V_VEC2, NULL);
+  float u[4];
+  int index = luax_readvec2(L, 2, u, NULL);
+  float s = luax_optfloat(L, index, 1.f);
+  vec2_madd(v, u, s);
+  lua_settop(L, 1);
+  return 1;
+}
+
 static int l_lovrVec2Length(lua_State* L) {
   float* v = luax_checkvector(L, 1, V_VEC2, NULL);
   lua_pushnumber(L, vec2_length(v));
@@ -513,6 +523,7 @@ const luaL_Reg lovrVec2[] = {
   { "sub", l_lovrVec2Sub },
   { "mul", l_lovrVec2Mul },
   { "div", l_lovrVec2Div },
+  { "madd", l_lovrVec2Madd },
   { "length", l_lovrVec2Length },
   { "normalize", l_lovrVec2Normalize },
   { "distance", l_lovrVec2Distance },
@@ -611,6 +622,16 @@ static int l_lovrVec3Div(lua_State* L) {
   return 1;
 }
 
+static int l_lovrVec3Madd(lua_State* L) {
+  vec3 v = luax_checkvector(L, 1, V_VEC3, NULL);
+  float u[4];
+  int index = luax_readvec3(L, 2, u, NULL);
+  float s = luax_optfloat(L, index, 1.f);
+  vec3_madd(v, u, s);
+  lua_settop(L, 1);
+  return 1;
+}
+
 static int l_lovrVec3Length(lua_State* L) {
   vec3 v = luax_checkvector(L, 1, V_VEC3, NULL);
   lua_pushnumber(L, vec3_length(v));
@@ -912,6 +933,7 @@ const luaL_Reg lovrVec3[] = {
   { "sub", l_lovrVec3Sub },
   { "mul", l_lovrVec3Mul },
   { "div", l_lovrVec3Div },
+  { "madd", l_lovrVec3Madd },
   { "length", l_lovrVec3Length },
   { "normalize", l_lovrVec3Normalize },
   { "distance", l_lovrVec3Distance },
@@ -1001,6 +1023,16 @@ static int l_lovrVec4Div(lua_State* L) {
   return 1;
 }
 
+static int l_lovrVec4Madd(lua_State* L) {
+  float* v = luax_checkvector(L, 1, V_VEC4, NULL);
+  float u[4];
+  int index = luax_readvec4(L, 2, u, NULL);
+  float s = luax_optfloat(L, index, 1.f);
+  vec4_madd(v, u, s);
+  lua_settop(L, 1);
+  return 1;
+}
+
 static int l_lovrVec4Length(lua_State* L) {
   float* v = luax_checkvector(L, 1, V_VEC4, NULL);
   lua_pushnumber(L, vec4_length(v));
@@ -1307,6 +1339,7 @@ const luaL_Reg lovrVec4[] = {
   { "sub", l_lovrVec4Sub },
   { "mul", l_lovrVec4Mul },
   { "div", l_lovrVec4Div },
+  { "madd", l_lovrVec4Madd },
   { "length", l_lovrVec4Length },
   { "normalize", l_lovrVec4Normalize },
   { "distance", l_lovrVec4Distance },
@@ -1806,6 +1839,17 @@ static int l_lovrMat4Identity(lua_State* L) {
   return 1;
 }
 
+static int l_lovrMat4ComposeTRS(lua_State* L) {
+  mat4 m = luax_checkvector(L, 1, V_MAT4, NULL);
+  float position[3], rotation[4], scale[3];
+  int index = luax_readvec3(L, 2, position, NULL);
+  index = luax_readquat(L, index, rotation, NULL);
+  luax_readscale(L, index, scale, 3, NULL);
+  mat4_fromTRS(m, position, rotation, scale);
+  lua_settop(L, 1);
+  return 1;
+}
+
 static int l_lovrMat4Invert(lua_State* L) {
   mat4 m = luax_checkvector(L, 1, V_MAT4, NULL);
   mat4_invert(m);
@@ -2022,6 +2066,7 @@ const luaL_Reg lovrMat4[] = {
   { "set", l_lovrMat4Set },
   { "mul", l_lovrMat4Mul },
   { "identity", l_lovrMat4Identity },
+  { "composeTRS", l_lovrMat4ComposeTRS },
   { "invert", l_lovrMat4Invert },
   { "transpose", l_lovrMat4Transpose },
   { "translate", l_lovrMat4Translate },
@@ -24,6 +24,13 @@ StringEntry lovrJointType[] = {
   { 0 }
 };
 
+StringEntry lovrContactEvent[] = {
+  [CONTACT_ENTER] = ENTRY("enter"),
+  [CONTACT_PERSIST] = ENTRY("persist"),
+  [CONTACT_EXIT] = ENTRY("exit"),
+  { 0 }
+};
+
 StringEntry lovrMotorMode[] = {
   [MOTOR_OFF] = ENTRY("off"),
   [MOTOR_VELOCITY] = ENTRY("velocity"),
@@ -309,6 +316,29 @@ static int l_lovrPhysicsNewSliderJoint(lua_State* L) {
   return 1;
 }
 
+static int l_lovrPhysicsIsShapeCacheEnabled(lua_State* L) {
+  lua_pushboolean(L, lovrPhysicsIsShapeCacheEnabled());
+  return 1;
+}
+
+static int l_lovrPhysicsSetShapeCacheEnabled(lua_State* L) {
+  lovrPhysicsSetShapeCacheEnabled(lua_toboolean(L, 1));
+  return 0;
+}
+
+static int l_lovrPhysicsClearShapeCache(lua_State* L) {
+  lovrPhysicsClearShapeCache();
+  return 0;
+}
+
+static int l_lovrPhysicsGetShapeCacheStats(lua_State* L) {
+  uint32_t count, hits;
+  lovrPhysicsGetShapeCacheStats(&count, &hits);
+  lua_pushinteger(L, count);
+  lua_pushinteger(L, hits);
+  return 2;
+}
+
 static const luaL_Reg lovrPhysics[] = {
   { "newWorld", l_lovrPhysicsNewWorld },
   { "newBoxShape", l_lovrPhysicsNewBoxShape },
@@ -324,6 +354,10 @@ static const luaL_Reg lovrPhysics[] = {
   { "newDistanceJoint", l_lovrPhysicsNewDistanceJoint },
   { "newHingeJoint", l_lovrPhysicsNewHingeJoint },
   { "newSliderJoint", l_lovrPhysicsNewSliderJoint },
+  { "isShapeCacheEnabled", l_lovrPhysicsIsShapeCacheEnabled },
+  { "setShapeCacheEnabled", l_lovrPhysicsSetShapeCacheEnabled },
+  { "clearShapeCache", l_lovrPhysicsClearShapeCache },
+  { "getShapeCacheStats", l_lovrPhysicsGetShapeCacheStats },
   { NULL, NULL }
 };
 
@@ -12,6 +12,7 @@ static Collider* luax_checkcollider(lua_State* L, int index) {
 
 static int l_lovrColliderDestroy(lua_State* L) {
   Collider* collider = luax_checkcollider(L, 1);
+  luax_check(L, !lovrWorldIsUpdating(lovrColliderGetWorld(collider)), "World is updating, call World:sync first");
   lovrColliderDestruct(collider);
   return 0;
 }
@@ -134,7 +135,7 @@ static int l_lovrColliderIsSensor(lua_State* L) {
 static int l_lovrColliderSetSensor(lua_State* L) {
   Collider* collider = luax_checkcollider(L, 1);
   bool sensor = lua_toboolean(L, 2);
-  lovrColliderSetSensor(collider, sensor);
+  luax_assert(L, lovrColliderSetSensor(collider, sensor));
   return 0;
 }
 
@@ -188,7 +189,7 @@ static int l_lovrColliderIsSleepingAllowed(lua_State* L) {
 static int l_lovrColliderSetSleepingAllowed(lua_State* L) {
   Collider* collider = luax_checkcollider(L, 1);
   bool allowed = lua_toboolean(L, 2);
-  lovrColliderSetSleepingAllowed(collider, allowed);
+  luax_assert(L, lovrColliderSetSleepingAllowed(collider, allowed));
   return 0;
 }
 
@@ -225,7 +226,7 @@ static int l_lovrColliderSetInertia(lua_State* L) {
   float diagonal[3], rotation[4];
   int index = luax_readvec3(L, 2, diagonal, NULL);
   luax_readquat(L, index, rotation, NULL);
-  lovrColliderSetInertia(collider, diagonal, rotation);
+  luax_assert(L, lovrColliderSetInertia(collider, diagonal, rotation));
   return 0;
 }
 
@@ -257,7 +258,7 @@ static int l_lovrColliderGetAutomaticMass(lua_State* L) {
 static int l_lovrColliderSetAutomaticMass(lua_State* L) {
   Collider* collider = luax_checkcollider(L, 1);
   bool enable = lua_toboolean(L, 2);
-  lovrColliderSetAutomaticMass(collider, enable);
+  luax_assert(L, lovrColliderSetAutomaticMass(collider, enable));
   return 0;
 }
 
@@ -316,7 +317,7 @@ static int l_lovrColliderSetDegreesOfFreedom(lua_State* L) {
     }
   }
 
-  lovrColliderSetDegreesOfFreedom(collider, translation, rotation);
+  luax_assert(L, lovrColliderSetDegreesOfFreedom(collider, translation, rotation));
   return 0;
 }
 
@@ -438,7 +439,7 @@ static int l_lovrColliderGetLinearDamping(lua_State* L) {
 static int l_lovrColliderSetLinearDamping(lua_State* L) {
   Collider* collider = luax_checkcollider(L, 1);
   float damping = luax_checkfloat(L, 2);
-  lovrColliderSetLinearDamping(collider, damping);
+  luax_assert(L, lovrColliderSetLinearDamping(collider, damping));
   return 0;
 }
 
@@ -452,7 +453,7 @@ static int l_lovrColliderGetAngularDamping(lua_State* L) {
 static int l_lovrColliderSetAngularDamping(lua_State* L) {
   Collider* collider = luax_checkcollider(L, 1);
   float damping = luax_checkfloat(L, 2);
-  lovrColliderSetAngularDamping(collider, damping);
+  luax_assert(L, lovrColliderSetAngularDamping(collider, damping));
   return 0;
 }
 
@@ -53,6 +53,7 @@ Joint* luax_checkjoint(lua_State* L, int index) {
 
 static int l_lovrJointDestroy(lua_State* L) {
   Joint* joint = luax_checkjoint(L, 1);
+  luax_check(L, !lovrWorldIsUpdating(lovrColliderGetWorld(lovrJointGetColliderB(joint))), "World is updating, call World:sync first");
   lovrJointDestruct(joint);
   return 0;
 }
@@ -120,7 +121,7 @@ static int l_lovrJointGetPriority(lua_State* L) {
 static int l_lovrJointSetPriority(lua_State* L) {
   Joint* joint = luax_checkjoint(L, 1);
   uint32_t priority = luax_checku32(L, 2);
-  lovrJointSetPriority(joint, priority);
+  luax_assert(L, lovrJointSetPriority(joint, priority));
   return 0;
 }
 
@@ -133,7 +134,7 @@ static int l_lovrJointIsEnabled(lua_State* L) {
 static int l_lovrJointSetEnabled(lua_State* L) {
   Joint* joint = luax_checkjoint(L, 1);
   bool enable = lua_toboolean(L, 2);
-  lovrJointSetEnabled(joint, enable);
+  luax_assert(L, lovrJointSetEnabled(joint, enable));
   return 0;
 }
 
@@ -238,7 +239,7 @@ static int l_lovrDistanceJointSetSpring(lua_State* L) {
   DistanceJoint* joint = luax_checktype(L, 1, DistanceJoint);
   float frequency = luax_optfloat(L, 2, 0.f);
   float damping = luax_optfloat(L, 3, 1.f);
-  lovrDistanceJointSetSpring(joint, frequency, damping);
+  luax_assert(L, lovrDistanceJointSetSpring(joint, frequency, damping));
   return 0;
 }
 
@@ -298,7 +299,7 @@ static int l_lovrHingeJointGetFriction(lua_State* L) {
 static int l_lovrHingeJointSetFriction(lua_State* L) {
   HingeJoint* joint = luax_checktype(L, 1, HingeJoint);
   float friction = luax_optfloat(L, 2, 0.f);
-  lovrHingeJointSetFriction(joint, friction);
+  luax_assert(L, lovrHingeJointSetFriction(joint, friction));
   return 0;
 }
 
@@ -316,7 +317,7 @@ static int l_lovrHingeJointGetMotorMode(lua_State* L) {
 static int l_lovrHingeJointSetMotorMode(lua_State* L) {
   HingeJoint* joint = luax_checktype(L, 1, HingeJoint);
   MotorMode mode = luax_checkenum(L, 2, MotorMode, "off");
-  lovrHingeJointSetMotorMode(joint, mode);
+  luax_assert(L, lovrHingeJointSetMotorMode(joint, mode));
   return 0;
 }
 
@@ -330,7 +331,7 @@ static int l_lovrHingeJointGetMotorTarget(lua_State* L) {
 static int l_lovrHingeJointSetMotorTarget(lua_State* L) {
   HingeJoint* joint = luax_checktype(L, 1, HingeJoint);
   float target = luax_checkfloat(L, 2);
-  lovrHingeJointSetMotorTarget(joint, target);
+  luax_assert(L, lovrHingeJointSetMotorTarget(joint, target));
   return 0;
 }
 
@@ -347,7 +348,7 @@ static int l_lovrHingeJointSetMotorSpring(lua_State* L) {
   HingeJoint* joint = luax_checktype(L, 1, HingeJoint);
   float frequency = luax_optfloat(L, 2, 0.f);
   float damping = luax_optfloat(L, 3, 1.f);
-  lovrHingeJointSetMotorSpring(joint, frequency, damping);
+  luax_assert(L, lovrHingeJointSetMotorSpring(joint, frequency, damping));
   return 0;
 }
 
@@ -363,11 +364,11 @@ static int l_lovrHingeJointGetMaxMotorTorque(lua_State* L) {
 static int l_lovrHingeJointSetMaxMotorTorque(lua_State* L) {
   HingeJoint* joint = luax_checktype(L, 1, HingeJoint);
   if (lua_isnoneornil(L, 2)) {
-    lovrHingeJointSetMaxMotorTorque(joint, HUGE_VALF, HUGE_VALF);
+    luax_assert(L, lovrHingeJointSetMaxMotorTorque(joint, HUGE_VALF, HUGE_VALF));
   } else {
     float positive = luax_checkfloat(L, 2);
     float negative = luax_optfloat(L, 3, positive);
-    lovrHingeJointSetMaxMotorTorque(joint, positive, negative);
+    luax_assert(L, lovrHingeJointSetMaxMotorTorque(joint, positive, negative));
   }
   return 0;
 }
@@ -392,7 +393,7 @@ static int l_lovrHingeJointSetSpring(lua_State* L) {
   HingeJoint* joint = luax_checktype(L, 1, HingeJoint);
   float frequency = luax_optfloat(L, 2, 0.f);
   float damping = luax_optfloat(L, 3, 1.f);
-  lovrHingeJointSetSpring(joint, frequency, damping);
+  luax_assert(L, lovrHingeJointSetSpring(joint, frequency, damping));
   return 0;
 }
 
@@ -465,7 +466,7 @@ static int l_lovrSliderJointGetFriction(lua_State* L) {
 static int l_lovrSliderJointSetFriction(lua_State* L) {
   SliderJoint* joint = luax_checktype(L, 1, SliderJoint);
   float friction = luax_optfloat(L, 2, 0.f);
-  lovrSliderJointSetFriction(joint, friction);
+  luax_assert(L, lovrSliderJointSetFriction(joint, friction));
   return 0;
 }
 
@@ -483,7 +484,7 @@ static int l_lovrSliderJointGetMotorMode(lua_State* L) {
 static int l_lovrSliderJointSetMotorMode(lua_State* L) {
   SliderJoint* joint = luax_checktype(L, 1, SliderJoint);
   MotorMode mode = luax_checkenum(L, 2, MotorMode, "off");
-  lovrSliderJointSetMotorMode(joint, mode);
+  luax_assert(L, lovrSliderJointSetMotorMode(joint, mode));
   return 0;
 }
 
@@ -497,7 +498,7 @@ static int l_lovrSliderJointGetMotorTarget(lua_State* L) {
 static int l_lovrSliderJointSetMotorTarget(lua_State* L) {
   SliderJoint* joint = luax_checktype(L, 1, SliderJoint);
   float target = luax_checkfloat(L, 2);
-  lovrSliderJointSetMotorTarget(joint, target);
+  luax_assert(L, lovrSliderJointSetMotorTarget(joint, target));
   return 0;
 }
 
@@ -514,7 +515,7 @@ static int l_lovrSliderJointSetMotorSpring(lua_State* L) {
   SliderJoint* joint = luax_checktype(L, 1, SliderJoint);
   float frequency = luax_optfloat(L, 2, 0.f);
   float damping = luax_optfloat(L, 3, 1.f);
-  lovrSliderJointSetMotorSpring(joint, frequency, damping);
+  luax_assert(L, lovrSliderJointSetMotorSpring(joint, frequency, damping));
   return 0;
 }
 
@@ -530,11 +531,11 @@ static int l_lovrSliderJointGetMaxMotorForce(lua_State* L) {
 static int l_lovrSliderJointSetMaxMotorForce(lua_State* L) {
   SliderJoint* joint = luax_checktype(L, 1, SliderJoint);
   if (lua_isnoneornil(L, 2)) {
-    lovrSliderJointSetMaxMotorForce(joint, HUGE_VALF, HUGE_VALF);
+    luax_assert(L, lovrSliderJointSetMaxMotorForce(joint, HUGE_VALF, HUGE_VALF));
   } else {
     float positive = luax_checkfloat(L, 2);
     float negative = luax_optfloat(L, 3, positive);
-    lovrSliderJointSetMaxMotorForce(joint, positive, negative);
+    luax_assert(L, lovrSliderJointSetMaxMotorForce(joint, positive, negative));
   }
   return 0;
 }
@@ -559,7 +560,7 @@ static int l_lovrSliderJointSetSpring(lua_State* L) {
   SliderJoint* joint = luax_checktype(L, 1, SliderJoint);
   float frequency = luax_optfloat(L, 2, 0.f);
   float damping = luax_optfloat(L, 3, 1.f);
-  lovrSliderJointSetSpring(joint, frequency, damping);
+  luax_assert(L, lovrSliderJointSetSpring(joint, frequency, damping));
   return 0;
 }
 
@@ -242,7 +242,7 @@ static int l_lovrShapeGetDensity(lua_State* L) {
 static int l_lovrShapeSetDensity(lua_State* L) {
   Shape* shape = luax_checkshape(L, 1);
   float density = luax_checkfloat(L, 2);
-  lovrShapeSetDensity(shape, density);
+  luax_assert(L, lovrShapeSetDensity(shape, density));
   return 0;
 }
 
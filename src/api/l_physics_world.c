@@ -6,12 +6,26 @@
 #include <stdbool.h>
 #include <string.h>
 
+#ifndef LOVR_DISABLE_DATA
+#include "data/blob.h"
+#endif
+
+#ifndef LOVR_DISABLE_GRAPHICS
+#include "graphics/graphics.h"
+#endif
+
 static World* luax_checkworld(lua_State* L, int index) {
   World* world = luax_checktype(L, index, World);
   luax_check(L, !lovrWorldIsDestroyed(world), "Attempt to use a destroyed World");
   return world;
 }
 
+static World* luax_checkidleworld(lua_State* L, int index) {
+  World* world = luax_checkworld(L, index);
+  luax_check(L, !lovrWorldIsUpdating(world), "World is updating, call World:sync first");
+  return world;
+}
+
 static int luax_pushcastresult(lua_State* L, CastResult* hit) {
   luax_pushtype(L, Collider, hit->collider);
   luax_pushshape(L, hit->shape);
@@ -298,6 +312,205 @@ static int l_lovrWorldGetColliders(lua_State* L) {
   return 1;
 }
 
+static int l_lovrWorldGetPoses(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  bool matrices = lua_toboolean(L, 4);
+  bool incremental = !lua_isnoneornil(L, 5);
+  uint32_t since = incremental ? luax_checku32(L, 5) : 0;
+
+  float* data = NULL;
+  size_t capacity = 0;
+#ifndef LOVR_DISABLE_GRAPHICS
+  Buffer* buffer = NULL;
+#endif
+
+  VectorArray* array = luax_totype(L, 2, VectorArray);
+  if (array) {
+    VectorType type = lovrVectorArrayGetType(array);
+    luax_check(L, type == V_VEC4 || type == V_MAT4, "Poses can only be written to vec4 or mat4 arrays");
+    matrices = type == V_MAT4;
+    data = lovrVectorArrayGetData(array);
+    capacity = lovrVectorArrayGetCount(array) * lovrVectorArrayGetComponents(array);
+  } else {
+#ifndef LOVR_DISABLE_DATA
+    Blob* blob = luax_totype(L, 2, Blob);
+    if (blob) {
+      data = blob->data;
+      capacity = blob->size / sizeof(float);
+    }
+#endif
+#ifndef LOVR_DISABLE_GRAPHICS
+    if (!data) {
+      buffer = luax_totype(L, 2, Buffer);
+      if (buffer) capacity = lovrBufferGetInfo(buffer)->size / sizeof(float);
+    }
+    if (!data && !buffer) return luax_typeerror(L, 2, "Buffer, Blob, or VectorArray");
+#else
+    if (!data) return luax_typeerror(L, 2, "Blob or VectorArray");
+#endif
+  }
+
+  uint32_t count;
+  Collider** colliders;
+  if (lua_istable(L, 3)) {
+    count = luax_len(L, 3);
+    colliders = lovrMalloc(MAX(count, 1) * sizeof(Collider*));
+    for (uint32_t i = 0; i < count; i++) {
+      lua_rawgeti(L, 3, i + 1);
+      Collider* collider = luax_totype(L, -1, Collider);
+      if (!collider || lovrColliderIsDestroyed(collider) || lovrColliderGetWorld(collider) != world) {
+        lovrFree(colliders);
+        return luaL_error(L, "Expected a table of Colliders from this World");
+      }
+      colliders[i] = collider;
+      lua_pop(L, 1);
+    }
+  } else {
+    count = lovrWorldGetColliderCount(world);
+    colliders = lovrMalloc(MAX(count, 1) * sizeof(Collider*));
+    Collider* collider = NULL;
+    for (uint32_t i = 0; (collider = lovrWorldGetColliders(world, collider)) != NULL; i++) {
+      colliders[i] = collider;
+    }
+  }
+
+  uint32_t stride = matrices ? 16 : 8;
+
+  if ((size_t) count * stride > capacity) {
+    lovrFree(colliders);
+    return luaL_error(L, "Output is too small to hold %d poses", (int) count);
+  }
+
+  // The tick is taken first so poses that change while exporting get written next time too
+  uint32_t tick = lovrWorldAdvancePoseTick(world);
+
+  // Write contiguous runs of colliders, skipping ones that haven't moved since the tick the target
+  // was last exported at when incremental
+  for (uint32_t i = 0; i < count;) {
+    if (incremental && !lovrColliderIsPoseDirty(colliders[i], since)) {
+      i++;
+      continue;
+    }
+
+    uint32_t j = i + 1;
+    while (j < count && (!incremental || lovrColliderIsPoseDirty(colliders[j], since))) {
+      j++;
+    }
+
+    float* poses = data + (size_t) i * stride;
+#ifndef LOVR_DISABLE_GRAPHICS
+    if (buffer) {
+      poses = lovrBufferSetData(buffer, i * stride * sizeof(float), (j - i) * stride * sizeof(float));
+      if (!poses) {
+        lovrFree(colliders);
+        luax_assert(L, false);
+      }
+    }
+#endif
+
+    lovrWorldGetPoses(world, colliders + i, j - i, poses, matrices);
+    i = j;
+  }
+
+  lovrFree(colliders);
+  lua_pushinteger(L, count);
+  lua_pushinteger(L, tick);
+  return 2;
+}
+
+static int l_lovrWorldSaveState(lua_State* L) {
+#ifndef LOVR_DISABLE_DATA
+  World* world = luax_checkworld(L, 1);
+  Blob* base = lua_isnoneornil(L, 2) ? NULL : luax_checktype(L, 2, Blob);
+  size_t size = lovrWorldGetStateSize(world);
+  void* data = lovrMalloc(size);
+  if (!lovrWorldSaveState(world, data, &size, base ? base->data : NULL, base ? base->size : 0)) {
+    lovrFree(data);
+    luax_assert(L, false);
+  }
+  Blob* blob = lovrBlobCreate(data, size, "World state");
+  luax_pushtype(L, Blob, blob);
+  lovrRelease(blob, lovrBlobDestroy);
+  return 1;
+#else
+  return luaL_error(L, "World:saveState requires the data module");
+#endif
+}
+
+static int l_lovrWorldRestoreState(lua_State* L) {
+#ifndef LOVR_DISABLE_DATA
+  World* world = luax_checkworld(L, 1);
+  Blob* blob = luax_checktype(L, 2, Blob);
+  Blob* base = lua_isnoneornil(L, 3) ? NULL : luax_checktype(L, 3, Blob);
+  luax_assert(L, lovrWorldRestoreState(world, blob->data, blob->size, base ? base->data : NULL, base ? base->size : 0));
+  return 0;
+#else
+  return luaL_error(L, "World:restoreState requires the data module");
+#endif
+}
+
+static int l_lovrWorldIsContactBufferEnabled(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  lua_pushboolean(L, lovrWorldIsContactBufferEnabled(world));
+  return 1;
+}
+
+static int l_lovrWorldSetContactBufferEnabled(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  bool enable = lua_toboolean(L, 2);
+  luax_assert(L, lovrWorldSetContactBufferEnabled(world, enable));
+  return 0;
+}
+
+static int luax_nextcontact(lua_State* L) {
+  World* world = luax_checkworld(L, lua_upvalueindex(1));
+  uint32_t index = (uint32_t) lua_tointeger(L, lua_upvalueindex(2));
+  uint32_t count;
+  ContactRecord* contacts = lovrWorldGetContacts(world, &count, NULL);
+
+  // Skip contacts with colliders that were destroyed after the step
+  while (index < count && !contacts[index].colliderA) {
+    index++;
+  }
+
+  if (index >= count) {
+    return 0;
+  }
+
+  ContactRecord* contact = &contacts[index];
+  lua_pushinteger(L, index + 1);
+  lua_replace(L, lua_upvalueindex(2));
+  luax_pushenum(L, ContactEvent, contact->event);
+  luax_pushtype(L, Collider, contact->colliderA);
+  luax_pushtype(L, Collider, contact->colliderB);
+  lua_pushnumber(L, contact->position[0]);
+  lua_pushnumber(L, contact->position[1]);
+  lua_pushnumber(L, contact->position[2]);
+  lua_pushnumber(L, contact->normal[0]);
+  lua_pushnumber(L, contact->normal[1]);
+  lua_pushnumber(L, contact->normal[2]);
+  lua_pushnumber(L, contact->overlap);
+  return 10;
+}
+
+static int l_lovrWorldGetContacts(lua_State* L) {
+  World* world = luax_checkidleworld(L, 1);
+  luax_check(L, lovrWorldIsContactBufferEnabled(world), "Contact buffering is not enabled for this World");
+  lua_settop(L, 1);
+  lua_pushinteger(L, 0);
+  lua_pushcclosure(L, luax_nextcontact, 2);
+  return 1;
+}
+
+static int l_lovrWorldGetContactCount(lua_State* L) {
+  World* world = luax_checkidleworld(L, 1);
+  uint32_t count, dropped;
+  lovrWorldGetContacts(world, &count, &dropped);
+  lua_pushinteger(L, count);
+  lua_pushinteger(L, dropped);
+  return 2;
+}
+
 static int l_lovrWorldGetJoints(lua_State* L) {
   World* world = luax_checkworld(L, 1);
   int index = 1;
@@ -324,7 +537,7 @@ static int l_lovrWorldSetGravity(lua_State* L) {
   World* world = luax_checkworld(L, 1);
   float gravity[3];
   luax_readvec3(L, 2, gravity, NULL);
-  lovrWorldSetGravity(world, gravity);
+  luax_assert(L, lovrWorldSetGravity(world, gravity));
   return 0;
 }
 
@@ -332,13 +545,32 @@ static int l_lovrWorldUpdate(lua_State* L) {
   World* world = luax_checkworld(L, 1);
   float dt = luax_checkfloat(L, 2);
   lua_settop(L, 2);
-  lovrWorldUpdate(world, dt);
+  luax_assert(L, lovrWorldUpdate(world, dt));
   if (lua_type(L, 3) == LUA_TSTRING) {
     lua_error(L);
   }
   return 0;
 }
 
+static int l_lovrWorldUpdateAsync(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  float dt = luax_checkfloat(L, 2);
+  luax_assert(L, lovrWorldUpdateAsync(world, dt));
+  return 0;
+}
+
+static int l_lovrWorldSync(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  lovrWorldSync(world);
+  return 0;
+}
+
+static int l_lovrWorldIsUpdating(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  lua_pushboolean(L, lovrWorldIsUpdating(world));
+  return 1;
+}
+
 static int l_lovrWorldInterpolate(lua_State* L) {
   World* world = luax_checkworld(L, 1);
   float alpha = luax_checkfloat(L, 2);
@@ -359,7 +591,7 @@ static uint32_t luax_checktagmask(lua_State* L, int index, World* world) {
 }
 
 static int l_lovrWorldRaycast(lua_State* L) {
-  World* world = luax_checkworld(L, 1);
+  World* world = luax_checkidleworld(L, 1);
   int index = 2;
   float start[3], end[3];
   index = luax_readvec3(L, index, start, NULL);
@@ -379,7 +611,7 @@ static int l_lovrWorldRaycast(lua_State* L) {
 }
 
 static int l_lovrWorldShapecast(lua_State* L) {
-  World* world = luax_checkworld(L, 1);
+  World* world = luax_checkidleworld(L, 1);
   int index = 2;
   float pose[7], end[3];
   Shape* shape = luax_checkshape(L, index++);
@@ -401,7 +633,7 @@ static int l_lovrWorldShapecast(lua_State* L) {
 }
 
 static int l_lovrWorldOverlapShape(lua_State* L) {
-  World* world = luax_checkworld(L, 1);
+  World* world = luax_checkidleworld(L, 1);
   int index;
   float pose[7];
   Shape* shape = luax_checkshape(L, 2);
@@ -423,7 +655,7 @@ static int l_lovrWorldOverlapShape(lua_State* L) {
 }
 
 static int l_lovrWorldQueryBox(lua_State* L) {
-  World* world = luax_checkworld(L, 1);
+  World* world = luax_checkidleworld(L, 1);
   float position[3], size[3];
   int index = 2;
   index = luax_readvec3(L, index, position, NULL);
@@ -443,7 +675,7 @@ static int l_lovrWorldQueryBox(lua_State* L) {
 }
 
 static int l_lovrWorldQuerySphere(lua_State* L) {
-  World* world = luax_checkworld(L, 1);
+  World* world = luax_checkidleworld(L, 1);
   float position[3];
   int index = luax_readvec3(L, 2, position, NULL);
   float radius = luax_checkfloat(L, index++);
@@ -461,6 +693,157 @@ static int l_lovrWorldQuerySphere(lua_State* L) {
   }
 }
 
+// Batch queries take tightly packed floats from a VectorArray or a Blob
+static float* luax_checkbatchdata(lua_State* L, int index, uint32_t components, uint32_t* count) {
+  VectorArray* array = luax_totype(L, index, VectorArray);
+  if (array) {
+    luax_check(L, lovrVectorArrayGetComponents(array) == components, "Expected a VectorArray with %d components", components);
+    *count = (uint32_t) lovrVectorArrayGetCount(array);
+    return lovrVectorArrayGetData(array);
+  }
+#ifndef LOVR_DISABLE_DATA
+  Blob* blob = luax_totype(L, index, Blob);
+  if (blob) {
+    *count = (uint32_t) (blob->size / (components * sizeof(float)));
+    return blob->data;
+  }
+  luax_typeerror(L, index, "VectorArray or Blob");
+#else
+  luax_typeerror(L, index, "VectorArray");
+#endif
+  return NULL;
+}
+
+// Checked before any work is done, so a bad argument can't leak the results
+static float* luax_checkcastoutput(lua_State* L, int index, int collidersIndex, uint32_t count) {
+  uint32_t capacity;
+  float* output = luax_checkbatchdata(L, index, 4, &capacity);
+  uint64_t floats = (uint64_t) capacity * 4;
+  luax_check(L, floats >= (uint64_t) count * 8, "Output is too small to hold %d results (each result is 8 floats)", (int) count);
+  if (!lua_isnoneornil(L, collidersIndex)) luaL_checktype(L, collidersIndex, LUA_TTABLE);
+  return output;
+}
+
+static void luax_writecastresults(lua_State* L, float* output, int collidersIndex, CastResult* hits, float* ends, uint32_t count) {
+  bool colliders = lua_istable(L, collidersIndex);
+
+  for (uint32_t i = 0; i < count; i++) {
+    float* result = output + 8 * i;
+    CastResult* hit = &hits[i];
+    if (hit->collider) {
+      vec3_init(result, hit->position);
+      result[3] = hit->fraction;
+      vec3_init(result + 4, hit->normal);
+      result[7] = 1.f;
+    } else {
+      vec3_init(result, ends + 3 * i);
+      result[3] = 1.f;
+      result[4] = result[5] = result[6] = 0.f;
+      result[7] = 0.f;
+    }
+
+    if (colliders) {
+      if (hit->collider) {
+        luax_pushtype(L, Collider, hit->collider);
+      } else {
+        lua_pushboolean(L, false);
+      }
+      lua_rawseti(L, collidersIndex, i + 1);
+    }
+  }
+}
+
+static int l_lovrWorldRaycastBatch(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  uint32_t count, endCount;
+  float* starts = luax_checkbatchdata(L, 2, 3, &count);
+  float* ends = luax_checkbatchdata(L, 3, 3, &endCount);
+  luax_check(L, count == endCount, "Raycast batches need the same number of start and end points");
+  float* output = luax_checkcastoutput(L, 4, 6, count);
+  uint32_t filter = luax_checktagmask(L, 5, world);
+  CastResult* hits = lovrMalloc(count * sizeof(CastResult));
+  if (!lovrWorldRaycastBatch(world, starts, ends, count, filter, hits)) {
+    lovrFree(hits);
+    luax_assert(L, false);
+  }
+  luax_writecastresults(L, output, 6, hits, ends, count);
+  lovrFree(hits);
+  return 0;
+}
+
+static int l_lovrWorldShapecastBatch(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  Shape* shape = luax_checkshape(L, 2);
+  uint32_t count, endCount;
+  float* starts = luax_checkbatchdata(L, 3, 3, &count);
+  float* ends = luax_checkbatchdata(L, 4, 3, &endCount);
+  luax_check(L, count == endCount, "Shapecast batches need the same number of start and end points");
+  float* output = luax_checkcastoutput(L, 5, 7, count);
+  uint32_t filter = luax_checktagmask(L, 6, world);
+  CastResult* hits = lovrMalloc(count * sizeof(CastResult));
+  if (!lovrWorldShapecastBatch(world, shape, starts, ends, count, filter, hits)) {
+    lovrFree(hits);
+    luax_assert(L, false);
+  }
+  luax_writecastresults(L, output, 7, hits, ends, count);
+  lovrFree(hits);
+  return 0;
+}
+
+static int l_lovrWorldQuerySphereBatch(lua_State* L) {
+#ifndef LOVR_DISABLE_DATA
+  World* world = luax_checkworld(L, 1);
+  uint32_t count;
+  float* spheres = luax_checkbatchdata(L, 2, 4, &count);
+  Blob* output = luax_checktype(L, 3, Blob);
+  luax_check(L, output->size >= count * sizeof(uint32_t), "Blob is too small to hold %d counts", count);
+  uint32_t filter = luax_checktagmask(L, 4, world);
+  bool table = lua_istable(L, 5);
+  uint32_t maxColliders = table ? luax_optu32(L, 6, 16) : 0;
+  luax_check(L, maxColliders == 0 || count <= SIZE_MAX / sizeof(Collider*) / maxColliders, "Too many results requested");
+  Collider** colliders = table ? lovrMalloc((size_t) count * maxColliders * sizeof(Collider*)) : NULL;
+  uint32_t* counts = output->data;
+  if (!lovrWorldQuerySphereBatch(world, spheres, count, filter, counts, colliders, maxColliders)) {
+    lovrFree(colliders);
+    luax_assert(L, false);
+  }
+
+  if (table) {
+    for (uint32_t i = 0; i < count; i++) {
+      lua_rawgeti(L, 5, i + 1);
+      if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        lua_createtable(L, MIN(counts[i], maxColliders), 0);
+        lua_pushvalue(L, -1);
+        lua_rawseti(L, 5, i + 1);
+      }
+
+      uint32_t n = MIN(counts[i], maxColliders);
+      int length = luax_len(L, -1);
+
+      for (uint32_t j = 0; j < n; j++) {
+        luax_pushtype(L, Collider, colliders[i * maxColliders + j]);
+        lua_rawseti(L, -2, j + 1);
+      }
+
+      // Clear leftovers from previous queries when the table is reused
+      for (int j = n + 1; j <= length; j++) {
+        lua_pushnil(L);
+        lua_rawseti(L, -2, j);
+      }
+
+      lua_pop(L, 1);
+    }
+
+    lovrFree(colliders);
+  }
+
+  return 0;
+#else
+  return luaL_error(L, "World:querySphereBatch requires the data module");
+#endif
+}
+
 static int l_lovrWorldDisableCollisionBetween(lua_State* L) {
   World* world = luax_checkworld(L, 1);
   const char* tag1 = luaL_checkstring(L, 2);
@@ -520,9 +903,9 @@ static int l_lovrWorldGetCallbacks(lua_State* L) {
 }
 
 static int l_lovrWorldSetCallbacks(lua_State* L) {
-  World* world = luax_checkworld(L, 1);
+  World* world = luax_checkidleworld(L, 1);
   if (lua_isnoneornil(L, 2)) {
-    lovrWorldSetCallbacks(world, &(WorldCallbacks) { 0 });
+    luax_assert(L, lovrWorldSetCallbacks(world, &(WorldCallbacks) { 0 }));
     return 0;
   }
 
@@ -556,13 +939,13 @@ static int l_lovrWorldSetCallbacks(lua_State* L) {
   lua_rawset(L, -3);
   lua_pop(L, 1);
 
-  lovrWorldSetCallbacks(world, &(WorldCallbacks) {
+  luax_assert(L, lovrWorldSetCallbacks(world, &(WorldCallbacks) {
     .filter = filter ? filterCallback : NULL,
     .enter = enter ? enterCallback : NULL,
     .exit = exit ? exitCallback : NULL,
     .contact = contact ? contactCallback : NULL,
     .userdata = L
-  });
+  }));
 
   return 0;
 }
@@ -676,14 +1059,23 @@ const luaL_Reg lovrWorld[] = {
   { "getColliderCount", l_lovrWorldGetColliderCount },
   { "getJointCount", l_lovrWorldGetJointCount },
   { "getColliders", l_lovrWorldGetColliders },
+  { "getPoses", l_lovrWorldGetPoses },
+  { "saveState", l_lovrWorldSaveState },
+  { "restoreState", l_lovrWorldRestoreState },
   { "getJoints", l_lovrWorldGetJoints },
   { "update", l_lovrWorldUpdate },
+  { "updateAsync", l_lovrWorldUpdateAsync },
+  { "sync", l_lovrWorldSync },
+  { "isUpdating", l_lovrWorldIsUpdating },
   { "interpolate", l_lovrWorldInterpolate },
   { "raycast", l_lovrWorldRaycast },
   { "shapecast", l_lovrWorldShapecast },
   { "overlapShape", l_lovrWorldOverlapShape },
   { "queryBox", l_lovrWorldQueryBox },
   { "querySphere", l_lovrWorldQuerySphere },
+  { "raycastBatch", l_lovrWorldRaycastBatch },
+  { "shapecastBatch", l_lovrWorldShapecastBatch },
+  { "querySphereBatch", l_lovrWorldQuerySphereBatch },
   { "getGravity", l_lovrWorldGetGravity },
   { "setGravity", l_lovrWorldSetGravity },
   { "disableCollisionBetween", l_lovrWorldDisableCollisionBetween },
@@ -691,6 +1083,10 @@ const luaL_Reg lovrWorld[] = {
   { "isCollisionEnabledBetween", l_lovrWorldIsCollisionEnabledBetween },
   { "getCallbacks", l_lovrWorldGetCallbacks },
   { "setCallbacks", l_lovrWorldSetCallbacks },
+  { "isContactBufferEnabled", l_lovrWorldIsContactBufferEnabled },
+  { "setContactBufferEnabled", l_lovrWorldSetContactBufferEnabled },
+  { "getContacts", l_lovrWorldGetContacts },
+  { "getContactCount", l_lovrWorldGetContactCount },
 
   // Deprecated
   { "getTightness", l_lovrWorldGetTightness },
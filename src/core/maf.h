@@ -1,3 +1,4 @@
+#include <stddef.h>
 #include <string.h>
 #include <math.h>
 #include <float.h>
@@ -6,6 +7,15 @@
 
 #define MAF static inline
 
+// SIMD paths are selected at compile time, define MAF_NO_SIMD to use the scalar code everywhere
+#if !defined(MAF_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define MAF_SSE
+#include <xmmintrin.h>
+#elif !defined(MAF_NO_SIMD) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define MAF_NEON
+#include <arm_neon.h>
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979
 #endif
@@ -58,6 +68,12 @@ MAF vec2 vec2_scale(vec2 v, float s) {
   return v;
 }
 
+MAF vec2 vec2_madd(vec2 v, const vec2 u, float s) {
+  v[0] += u[0] * s;
+  v[1] += u[1] * s;
+  return v;
+}
+
 MAF float vec2_length(vec2 v) {
   return sqrtf(v[0] * v[0] + v[1] * v[1]);
 }
@@ -147,6 +163,13 @@ MAF vec3 vec3_scale(vec3 v, float s) {
   return v;
 }
 
+MAF vec3 vec3_madd(vec3 v, const vec3 u, float s) {
+  v[0] += u[0] * s;
+  v[1] += u[1] * s;
+  v[2] += u[2] * s;
+  return v;
+}
+
 MAF float vec3_length(const vec3 v) {
   return sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
 }
@@ -258,6 +281,14 @@ MAF vec4 vec4_scale(vec4 v, float s) {
   return v;
 }
 
+MAF vec4 vec4_madd(vec4 v, const vec4 u, float s) {
+  v[0] += u[0] * s;
+  v[1] += u[1] * s;
+  v[2] += u[2] * s;
+  v[3] += u[3] * s;
+  return v;
+}
+
 MAF float vec4_length(vec4 v) {
   return sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
 }
@@ -570,6 +601,15 @@ MAF mat4 mat4_fromPose(mat4 m, vec3 v, quat q) {
   return m;
 }
 
+MAF mat4 mat4_fromTRS(mat4 m, vec3 v, quat q, vec3 s) {
+  mat4_fromQuat(m, q);
+  vec3_scale(m + 0, s[0]);
+  vec3_scale(m + 4, s[1]);
+  vec3_scale(m + 8, s[2]);
+  vec3_init(m + 12, v);
+  return m;
+}
+
 MAF mat4 mat4_identity(mat4 m) {
   m[0] = 1.f;
   m[1] = 0.f;
@@ -654,6 +694,36 @@ MAF mat4 mat4_invert(mat4 m) {
 
 // Calculate matrix equivalent to "apply n, then m"
 MAF mat4 mat4_mul(mat4 m, mat4 n) {
+#if defined(MAF_SSE)
+  __m128 c0 = _mm_loadu_ps(m + 0);
+  __m128 c1 = _mm_loadu_ps(m + 4);
+  __m128 c2 = _mm_loadu_ps(m + 8);
+  __m128 c3 = _mm_loadu_ps(m + 12);
+  __m128 r[4] = { _mm_loadu_ps(n + 0), _mm_loadu_ps(n + 4), _mm_loadu_ps(n + 8), _mm_loadu_ps(n + 12) };
+  for (int i = 0; i < 4; i++) {
+    __m128 x = _mm_mul_ps(c0, _mm_shuffle_ps(r[i], r[i], _MM_SHUFFLE(0, 0, 0, 0)));
+    x = _mm_add_ps(x, _mm_mul_ps(c1, _mm_shuffle_ps(r[i], r[i], _MM_SHUFFLE(1, 1, 1, 1))));
+    x = _mm_add_ps(x, _mm_mul_ps(c2, _mm_shuffle_ps(r[i], r[i], _MM_SHUFFLE(2, 2, 2, 2))));
+    x = _mm_add_ps(x, _mm_mul_ps(c3, _mm_shuffle_ps(r[i], r[i], _MM_SHUFFLE(3, 3, 3, 3))));
+    _mm_storeu_ps(m + 4 * i, x);
+  }
+  return m;
+#elif defined(MAF_NEON)
+  float nn[16];
+  memcpy(nn, n, sizeof(nn));
+  float32x4_t c0 = vld1q_f32(m + 0);
+  float32x4_t c1 = vld1q_f32(m + 4);
+  float32x4_t c2 = vld1q_f32(m + 8);
+  float32x4_t c3 = vld1q_f32(m + 12);
+  for (int i = 0; i < 16; i += 4) {
+    float32x4_t x = vmulq_n_f32(c0, nn[i + 0]);
+    x = vmlaq_n_f32(x, c1, nn[i + 1]);
+    x = vmlaq_n_f32(x, c2, nn[i + 2]);
+    x = vmlaq_n_f32(x, c3, nn[i + 3]);
+    vst1q_f32(m + i, x);
+  }
+  return m;
+#else
   float m00 = m[0], m01 = m[1], m02 = m[2], m03 = m[3],
         m10 = m[4], m11 = m[5], m12 = m[6], m13 = m[7],
         m20 = m[8], m21 = m[9], m22 = m[10], m23 = m[11],
@@ -681,23 +751,94 @@ MAF mat4 mat4_mul(mat4 m, mat4 n) {
   m[14] = n30 * m02 + n31 * m12 + n32 * m22 + n33 * m32;
   m[15] = n30 * m03 + n31 * m13 + n32 * m23 + n33 * m33;
   return m;
+#endif
 }
 
 MAF vec4 mat4_mulVec4(mat4 m, vec4 v) {
+#if defined(MAF_SSE)
+  __m128 x = _mm_mul_ps(_mm_loadu_ps(m + 0), _mm_set1_ps(v[0]));
+  x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+  x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+  x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(v[3])));
+  _mm_storeu_ps(v, x);
+  return v;
+#elif defined(MAF_NEON)
+  float32x4_t x = vmulq_n_f32(vld1q_f32(m + 0), v[0]);
+  x = vmlaq_n_f32(x, vld1q_f32(m + 4), v[1]);
+  x = vmlaq_n_f32(x, vld1q_f32(m + 8), v[2]);
+  x = vmlaq_n_f32(x, vld1q_f32(m + 12), v[3]);
+  vst1q_f32(v, x);
+  return v;
+#else
   float x = v[0] * m[0] + v[1] * m[4] + v[2] * m[8] + v[3] * m[12];
   float y = v[0] * m[1] + v[1] * m[5] + v[2] * m[9] + v[3] * m[13];
   float z = v[0] * m[2] + v[1] * m[6] + v[2] * m[10] + v[3] * m[14];
   float w = v[0] * m[3] + v[1] * m[7] + v[2] * m[11] + v[3] * m[15];
   return vec4_set(v, x, y, z, w);
+#endif
 }
 
-
 MAF vec4 mat4_mulPoint(mat4 m, vec3 v) {
+#if defined(MAF_SSE)
+  float p[4];
+  __m128 x = _mm_mul_ps(_mm_loadu_ps(m + 0), _mm_set1_ps(v[0]));
+  x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+  x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+  x = _mm_add_ps(x, _mm_loadu_ps(m + 12));
+  _mm_storeu_ps(p, _mm_div_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3))));
+  return vec3_set(v, p[0], p[1], p[2]);
+#elif defined(MAF_NEON)
+  float p[4];
+  float32x4_t x = vmulq_n_f32(vld1q_f32(m + 0), v[0]);
+  x = vmlaq_n_f32(x, vld1q_f32(m + 4), v[1]);
+  x = vmlaq_n_f32(x, vld1q_f32(m + 8), v[2]);
+  x = vaddq_f32(x, vld1q_f32(m + 12));
+  vst1q_f32(p, x);
+  return vec3_set(v, p[0] / p[3], p[1] / p[3], p[2] / p[3]);
+#else
   float x = v[0] * m[0] + v[1] * m[4] + v[2] * m[8] + m[12];
   float y = v[0] * m[1] + v[1] * m[5] + v[2] * m[9] + m[13];
   float z = v[0] * m[2] + v[1] * m[6] + v[2] * m[10] + m[14];
   float w = v[0] * m[3] + v[1] * m[7] + v[2] * m[11] + m[15];
   return vec3_set(v, x / w, y / w, z / w);
+#endif
+}
+
+// Transform an array of points in place, stride is the number of floats between points
+MAF void mat4_mulPoint_n(mat4 m, float* points, size_t count, size_t stride) {
+#if defined(MAF_SSE)
+  __m128 c0 = _mm_loadu_ps(m + 0);
+  __m128 c1 = _mm_loadu_ps(m + 4);
+  __m128 c2 = _mm_loadu_ps(m + 8);
+  __m128 c3 = _mm_loadu_ps(m + 12);
+  for (size_t i = 0; i < count; i++, points += stride) {
+    float p[4];
+    __m128 x = _mm_mul_ps(c0, _mm_set1_ps(points[0]));
+    x = _mm_add_ps(x, _mm_mul_ps(c1, _mm_set1_ps(points[1])));
+    x = _mm_add_ps(x, _mm_mul_ps(c2, _mm_set1_ps(points[2])));
+    x = _mm_add_ps(x, c3);
+    _mm_storeu_ps(p, _mm_div_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3))));
+    vec3_set(points, p[0], p[1], p[2]);
+  }
+#elif defined(MAF_NEON)
+  float32x4_t c0 = vld1q_f32(m + 0);
+  float32x4_t c1 = vld1q_f32(m + 4);
+  float32x4_t c2 = vld1q_f32(m + 8);
+  float32x4_t c3 = vld1q_f32(m + 12);
+  for (size_t i = 0; i < count; i++, points += stride) {
+    float p[4];
+    float32x4_t x = vmulq_n_f32(c0, points[0]);
+    x = vmlaq_n_f32(x, c1, points[1]);
+    x = vmlaq_n_f32(x, c2, points[2]);
+    x = vaddq_f32(x, c3);
+    vst1q_f32(p, x);
+    vec3_set(points, p[0] / p[3], p[1] / p[3], p[2] / p[3]);
+  }
+#else
+  for (size_t i = 0; i < count; i++, points += stride) {
+    mat4_mulPoint(m, points);
+  }
+#endif
 }
 
 MAF vec4 mat4_mulDirection(mat4 m, vec3 v) {
@@ -1,10 +1,15 @@
 #include "audio/audio.h"
 #include "audio/spatializer.h"
+#include "audio/mix.h"
+#include "audio/resampler.h"
 #include "data/sound.h"
+#include "data/blob.h"
 #include "core/maf.h"
+#include "core/os.h"
 #include "util.h"
 #include "lib/miniaudio/miniaudio.h"
 #include <stdatomic.h>
+#include <threads.h>
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
@@ -15,47 +20,222 @@
 #define CTZL __builtin_ctzl
 #endif
 
-#define FOREACH_SOURCE(s) for (uint64_t m = state.sourceMask; s = m ? state.sources[CTZL(m)] : NULL, m; m ^= (m & -m))
 #define OUTPUT_FORMAT SAMPLE_F32
 #define OUTPUT_CHANNELS 2
-
+#define MAX_COMMANDS 1024
+#define STREAM_BLOCK_SIZE 1024
+#define MAX_MIX_WORKERS 3
+#define PARALLEL_VOICES 16 // Buses are only mixed on worker threads when this many voices are real
+#define MIX_WAIT_LIMIT .25 // Fraction of a buffer the mixer waits on workers before backing off
+#define SERIAL_BUFFERS 256 // Buffers mixed without workers after a wait goes over the limit
+#define REVERB_FEEDBACK .84f
+#define REVERB_DAMPING .2f
+#define REVERB_GAIN .03f
+
+// Compressed Sounds are decoded ahead of the mixer by a worker thread into a ring of blocks.  Each
+// block records the Sound frame it starts at, so the mixer can skip stale blocks after a seek.
+typedef struct {
+  uint32_t position;
+  uint32_t frames;
+} StreamBlock;
+
+typedef struct {
+  uint32_t ref;
+  Sound* sound;
+  float* data;
+  StreamBlock* blocks;
+  uint32_t blockCount;
+  uint32_t channels;
+  uint32_t head; // Atomic, written by the mixer
+  uint32_t tail; // Atomic, written by the worker
+  uint32_t target; // Atomic, where the mixer wants decoding to restart
+  uint32_t request; // Atomic, incremented after target changes
+  uint32_t seen; // Atomic, last request handled by the worker
+  uint32_t pending; // Mixer, request issued by a play or seek that the worker hasn't caught up to
+  uint32_t position; // Worker, next frame to decode
+  bool looping; // Atomic
+  bool idle; // Atomic, the worker has nothing to do for this stream
+  bool dead; // Atomic, the Source is gone
+} Stream;
+
+// Source fields are split between the game thread and the mixer.  Setters write the game copy and
+// push a command, the mixer applies commands to its own copy at the start of each buffer.
 struct Source {
   uint32_t ref;
-  uint32_t index;
+  uint32_t index; // Mixer, voice slot or ~0u if the Source is virtual or stopped
+  Source* next; // Mixer, list of active Sources
   Sound* sound;
   // Note: Converter is written once in lovrSourceCreate and can never be changed.
   ma_data_converter* converter;
+  Stream* stream; // Created on the first play
+  Sound* pcm; // Shared decoded copy of a compressed Sound from the sample cache
+  Bus* bus;
+  Bus* mixBus; // Mixer
   intptr_t spatializerMemo;
-  uint32_t offset;
+  SpatialParams params;
+  SpatialParams mixParams;
+  uint32_t cursor; // Mixer
+  uint32_t offset; // Atomic, published by the mixer after each buffer
   float pitch;
   float volume;
-  float position[3];
-  float orientation[4];
-  float radius;
-  float dipoleWeight;
-  float dipolePower;
-  uint8_t effects;
-  bool playing;
+  float gain; // Mixer, ramps to targetVolume over a buffer
+  float targetVolume; // Mixer
+  float ratio; // Mixer, frames of the Sound consumed per output frame
+  float phase; // Mixer, fractional frame position of virtual Sources
+  float audibility; // Mixer
+  int priority;
+  int mixPriority;
+  uint32_t playback; // Atomic, bit 0 is set while playing, the rest counts calls to play
+  uint32_t mixPlayback; // Mixer, playback value of the last play command
   bool looping;
+  bool mixLooping;
   bool pitchable;
   bool spatial;
+  bool streaming; // Compressed Sound decoded ahead by the worker
+  ResamplerMode resampler;
+  bool active; // Mixer, in the active list
+  bool selected; // Mixer, chosen for a voice this buffer
+  bool fading; // Mixer, lost its voice and is mixed for one more buffer while fading out
+  bool virtual; // Atomic
 };
 
+typedef struct {
+  float volume;
+  float cutoff; // Hz, 0 disables the low-pass filter
+  float threshold; // dB
+  float ratio; // 1 disables the compressor
+  float attack; // Seconds
+  float release; // Seconds
+  float reverb; // Send level into the shared reverb, post-fader
+} BusParams;
+
+// Sources routed to a Bus are summed into its buffer, then its effects run on the sum.  Buses mix
+// independently of each other, so they can run on worker threads before they get added together.
+struct Bus {
+  uint32_t ref;
+  BusParams params;
+  BusParams mixParams; // Mixer
+  float gain; // Mixer, ramps to mixParams.volume
+  float send; // Mixer, ramps to mixParams.volume * mixParams.reverb
+  float filter[2]; // Mixer, low-pass state per channel
+  float envelope; // Mixer, compressor gain reduction in dB
+  uint64_t tick; // Mixer, last buffer the Bus had Sources in
+  uint32_t task; // Mixer
+  float buffer[BUFFER_SIZE * 2]; // Mixer
+};
+
+typedef struct {
+  Bus* bus;
+  Source** sources;
+  uint32_t count;
+} MixTask;
+
+typedef struct {
+  float* data;
+  uint32_t size;
+  uint32_t index;
+  float filter;
+} Delay;
+
+typedef struct {
+  uint64_t hash;
+  Blob* blob; // Compressed file contents, compared on a hash match
+  uint32_t frames;
+  Sound* sound;
+  size_t size;
+  uint64_t lastUsed;
+} CacheEntry;
+
+typedef enum {
+  COMMAND_PLAY,
+  COMMAND_SEEK,
+  COMMAND_PITCH,
+  COMMAND_VOLUME,
+  COMMAND_LOOPING,
+  COMMAND_PRIORITY,
+  COMMAND_PARAMS,
+  COMMAND_LISTENER,
+  COMMAND_ROUTE,
+  COMMAND_BUS
+} CommandType;
+
+typedef struct {
+  CommandType type;
+  Source* source;
+  Bus* bus;
+  union {
+    uint32_t offset;
+    uint32_t playback;
+    float ratio;
+    float volume;
+    bool looping;
+    int priority;
+    SpatialParams params;
+    BusParams busParams;
+    struct {
+      float position[3];
+      float orientation[4];
+    } pose;
+  };
+} Command;
+
 static struct {
   uint32_t ref;
-  ma_mutex lock;
+  ma_mutex lock; // Serializes command producers, never taken by the mixer
   ma_context context;
   ma_device devices[2];
   ma_device_info* deviceInfo[2];
   Sound* sinks[2];
-  Source* sources[MAX_SOURCES];
-  uint64_t sourceMask;
+  Source* sources; // Mixer, list of active Sources
+  uint64_t voiceMask; // Mixer
+  uint32_t maxVoices; // Atomic
+  float listenerPosition[3]; // Mixer
+  Command commands[MAX_COMMANDS];
+  uint32_t head; // Atomic, written by the consumer
+  uint32_t tail; // Atomic, written by the producer
+  bool paused; // Atomic, mixer outputs silence while set
+  bool mixing; // Atomic
+  bool rendering; // Offline rendering owns the mixer and can wait on decoding
   float position[3];
   float orientation[4];
   Spatializer* spatializer;
   float absorption[3];
   ma_data_converter playbackConverter;
   uint32_t sampleRate;
+  float readAhead;
+  thrd_t decoder;
+  mtx_t decodeLock;
+  cnd_t decodeCond;
+  arr_t(Stream*) streams;
+  bool decoding;
+  mtx_t cacheLock;
+  arr_t(CacheEntry) cache;
+  float cacheDuration;
+  size_t cacheBudget;
+  size_t cacheSize;
+  uint64_t cacheTick;
+  uint64_t mixTick; // Mixer
+  uint32_t mixFrames; // Mixer, frames in the buffer being mixed, BUFFER_SIZE except at the end of a render
+  MixTask tasks[MAX_SOURCES];
+  uint32_t claim; // Atomic, claimable task count in bits 12-23, next task in bits 0-11
+  uint32_t tasksDone; // Atomic
+  uint32_t serialBuffers; // Mixer, buffers left to mix without workers
+  uint32_t mixGeneration; // Atomic
+  thrd_t mixWorkers[MAX_MIX_WORKERS];
+  uint32_t mixWorkerCount; // Atomic
+  mtx_t mixLock;
+  cnd_t mixCond;
+  bool mixQuit;
+  Delay combs[2][4];
+  Delay allpasses[2][2];
+  float* reverbData;
+  float reverbInput[BUFFER_SIZE * 2]; // Mixer
+  uint32_t reverbTail; // Mixer, frames until the reverb is silent
+  ResamplerMode resampler;
+  uint32_t resampledFrames[3]; // Atomic, wraps
+  uint32_t resampleTime[3]; // Atomic, microseconds, wraps
+  uint32_t seenFrames[3];
+  uint32_t seenTime[3];
 } state;
 
 static const ma_format miniaudioFormats[] = {
@@ -71,107 +251,1018 @@ static float linearToDb(float linear) {
   return 20.f * log10f(linear);
 }
 
-// Device callbacks
+// Streams
 
-static void onPlayback(ma_device* device, void* out, const void* in, uint32_t count) {
-  if (count != BUFFER_SIZE) {
+static void lovrStreamDestroy(void* ref) {
+  Stream* stream = ref;
+  lovrRelease(stream->sound, lovrSoundDestroy);
+  lovrFree(stream->blocks);
+  lovrFree(stream->data);
+  lovrFree(stream);
+}
+
+// Worker side, returns whether a block was decoded
+static bool decodeBlock(Stream* stream) {
+  uint32_t request = atomic_load(&stream->request);
+
+  if (request != stream->seen) {
+    stream->position = atomic_load(&stream->target);
+    atomic_store(&stream->idle, false);
+    atomic_store(&stream->seen, request);
+  }
+
+  uint32_t tail = stream->tail;
+  if (tail - atomic_load(&stream->head) >= stream->blockCount) {
+    atomic_store(&stream->idle, true);
+    return false;
+  }
+
+  uint32_t index = tail % stream->blockCount;
+  float* data = stream->data + index * STREAM_BLOCK_SIZE * stream->channels;
+  uint32_t frames = lovrSoundRead(stream->sound, stream->position, STREAM_BLOCK_SIZE, data);
+
+  if (frames == 0) {
+    if (atomic_load(&stream->looping) && stream->position > 0) {
+      stream->position = 0;
+      return true;
+    }
+
+    atomic_store(&stream->idle, true);
+    return false;
+  }
+
+  stream->blocks[index].position = stream->position;
+  stream->blocks[index].frames = frames;
+  stream->position += frames;
+  atomic_store(&stream->idle, false);
+  atomic_store(&stream->tail, tail + 1);
+  return true;
+}
+
+// The lock only protects the list of streams, each decode happens with it released
+static int decodeLoop(void* arg) {
+  size_t next = 0;
+  bool busy = false;
+
+  mtx_lock(&state.decodeLock);
+
+  while (state.decoding) {
+    if (state.streams.length == 0) {
+      cnd_wait(&state.decodeCond, &state.decodeLock);
+      continue;
+    }
+
+    // The mixer never signals the worker, so poll once per buffer while there are streams
+    if (next >= state.streams.length) {
+      if (!busy) {
+        struct timespec until;
+        timespec_get(&until, TIME_UTC);
+        until.tv_nsec += (long) (BUFFER_SIZE * 1e9 / state.sampleRate);
+        if (until.tv_nsec >= 1000000000) {
+          until.tv_sec++;
+          until.tv_nsec -= 1000000000;
+        }
+        cnd_timedwait(&state.decodeCond, &state.decodeLock, &until);
+      }
+
+      next = 0;
+      busy = false;
+      continue;
+    }
+
+    Stream* stream = state.streams.data[next];
+
+    if (atomic_load(&stream->dead)) {
+      state.streams.data[next] = state.streams.data[--state.streams.length];
+      lovrRelease(stream, lovrStreamDestroy);
+      continue;
+    }
+
+    // Only this thread removes streams from the list, so its reference keeps the stream alive
+    next++;
+    mtx_unlock(&state.decodeLock);
+    busy |= decodeBlock(stream);
+    mtx_lock(&state.decodeLock);
+  }
+
+  mtx_unlock(&state.decodeLock);
+  return 0;
+}
+
+static Stream* createStream(Sound* sound) {
+  uint32_t frames = (uint32_t) (state.readAhead * lovrSoundGetSampleRate(sound));
+  uint32_t blockCount = MAX((frames + STREAM_BLOCK_SIZE - 1) / STREAM_BLOCK_SIZE, 2);
+
+  Stream* stream = lovrCalloc(sizeof(Stream));
+  stream->ref = 2; // One for the Source, one for the worker
+  stream->sound = sound;
+  stream->channels = lovrSoundGetChannelCount(sound);
+  stream->blockCount = blockCount;
+  stream->blocks = lovrMalloc(blockCount * sizeof(StreamBlock));
+  stream->data = lovrMalloc(blockCount * STREAM_BLOCK_SIZE * stream->channels * sizeof(float));
+  lovrRetain(sound);
+
+  mtx_lock(&state.decodeLock);
+  arr_push(&state.streams, stream);
+  cnd_signal(&state.decodeCond);
+  mtx_unlock(&state.decodeLock);
+  return stream;
+}
+
+// Mixer side, called when a play or seek moves the cursor.  If the next block doesn't start at the
+// cursor the worker is pointed at it, and the Source waits for it instead of skipping ahead.
+static void seekStream(Source* source) {
+  Stream* stream = source->stream;
+  uint32_t head = stream->head;
+
+  if (head != atomic_load(&stream->tail)) {
+    StreamBlock* block = &stream->blocks[head % stream->blockCount];
+    if (source->cursor >= block->position && source->cursor < block->position + block->frames) {
+      stream->pending = 0;
+      return;
+    }
+  }
+
+  atomic_store(&stream->target, source->cursor);
+  stream->pending = atomic_fetch_add(&stream->request, 1) + 1;
+}
+
+// Mixer side, returns whether the worker has decoded the block at the cursor after a play or seek.
+// Blocks decoded before the worker saw the request are dropped.
+static bool isStreamReady(Source* source) {
+  Stream* stream = source->stream;
+
+  if (!stream->pending || state.rendering) {
+    stream->pending = 0;
+    return true;
+  }
+
+  uint32_t head = stream->head;
+  while (head != atomic_load(&stream->tail)) {
+    StreamBlock* block = &stream->blocks[head % stream->blockCount];
+    if (source->cursor >= block->position && source->cursor < block->position + block->frames) {
+      stream->pending = 0;
+      return true;
+    }
+    atomic_store(&stream->head, ++head);
+  }
+
+  // The worker is idle after handling the request if the cursor is past the end of the Sound
+  if ((int32_t) (atomic_load(&stream->seen) - stream->pending) >= 0 && atomic_load(&stream->idle)) {
+    stream->pending = 0;
+    return true;
+  }
+
+  return false;
+}
+
+// Mixer side.  Underruns are padded with silence and still advance the cursor, the worker catches up
+// after being pointed at the new position.
+static uint32_t readStream(Source* source, uint32_t count, float* data) {
+  Stream* stream = source->stream;
+  uint32_t length = lovrSoundGetFrameCount(source->sound);
+
+  if (source->cursor >= length) {
+    return 0;
+  }
+
+  count = MIN(count, length - source->cursor);
+
+  uint32_t total = 0;
+  uint32_t request = 0;
+  bool discarded = false;
+  while (total < count) {
+    uint32_t head = stream->head;
+
+    // Offline rendering waits for the worker to decode from the cursor or run out of frames
+    if (head == atomic_load(&stream->tail)) {
+      if (!state.rendering) {
+        break;
+      } else if (!request) {
+        atomic_store(&stream->target, source->cursor + total);
+        request = atomic_fetch_add(&stream->request, 1) + 1;
+      } else if (atomic_load(&stream->seen) == request && atomic_load(&stream->idle)) {
+        break;
+      } else {
+        thrd_yield();
+      }
+
+      continue;
+    }
+
+    StreamBlock* block = &stream->blocks[head % stream->blockCount];
+    uint32_t cursor = source->cursor + total;
+
+    if (cursor < block->position || cursor >= block->position + block->frames) {
+      atomic_store(&stream->head, head + 1);
+      discarded = true;
+      request = 0;
+      continue;
+    }
+
+    uint32_t offset = cursor - block->position;
+    uint32_t frames = MIN(count - total, block->frames - offset);
+    float* src = stream->data + ((head % stream->blockCount) * STREAM_BLOCK_SIZE + offset) * stream->channels;
+    memcpy(data + total * stream->channels, src, frames * stream->channels * sizeof(float));
+    total += frames;
+
+    if (offset + frames == block->frames) {
+      atomic_store(&stream->head, head + 1);
+    }
+  }
+
+  if (total < count) {
+    if (discarded || atomic_load(&stream->idle)) {
+      atomic_store(&stream->target, source->cursor + count);
+      atomic_fetch_add(&stream->request, 1);
+    }
+
+    memset(data + total * stream->channels, 0, (count - total) * stream->channels * sizeof(float));
+    total = count;
+  }
+
+  return total;
+}
+
+static uint32_t readSource(Source* source, uint32_t count, void* data) {
+  if (source->stream) {
+    return readStream(source, count, data);
+  } else {
+    return lovrSoundRead(source->pcm ? source->pcm : source->sound, source->cursor, count, data);
+  }
+}
+
+// Commands
+
+// The mixer never blocks.  When the game thread needs exclusive access to mixer state, it raises
+// the paused flag and waits for the current buffer to finish, and the mixer outputs silence until
+// the flag is cleared.  Both sides set their flag before checking the other's (seq_cst).
+static void pauseMixer(void) {
+  atomic_store(&state.paused, true);
+  while (atomic_load(&state.mixing)) {
+    thrd_yield();
+  }
+}
+
+static void resumeMixer(void) {
+  atomic_store(&state.paused, false);
+}
+
+static void registerSource(Source* source) {
+  if (source->active || !lovrSourceIsPlaying(source)) {
     return;
   }
 
-  float raw[BUFFER_SIZE * 2];
-  float aux[BUFFER_SIZE * 2];
-  float mix[BUFFER_SIZE * 2];
-  float* dst = out;
-  float* buf = NULL; // The "current" buffer (used for fast paths)
+  source->next = state.sources;
+  state.sources = source;
+  source->active = true;
+  source->gain = source->targetVolume;
+  lovrRetain(source);
+}
 
+// Stops a Source that reached its end.  The game thread may have restarted it since the mixer saw
+// the last play command, so it's only stopped if nothing has touched the playback state since.
+static void finishSource(Source* source) {
+  uint32_t expected = source->mixPlayback;
+  atomic_compare_exchange_strong(&source->playback, &expected, expected & ~1u);
+}
+
+static void acquireVoice(Source* source) {
+  uint32_t index = CTZL(~state.voiceMask);
+  state.voiceMask |= (1ull << index);
+  source->index = index;
+  if (source->spatial) state.spatializer->sourceCreate(source);
+
+  // Fade in when resuming from virtual, with the converter's history from before it went virtual
+  // discarded.  Decoded blocks are stale, so the worker is pointed at the cursor.
+  if (atomic_load(&source->virtual)) {
+    atomic_store(&source->virtual, false);
+    if (source->converter) ma_data_converter_reset(source->converter);
+    if (source->stream) seekStream(source);
+    source->gain = 0.f;
+  }
+}
+
+static void releaseVoice(Source* source) {
+  state.voiceMask &= ~(1ull << source->index);
+  if (source->spatial) state.spatializer->sourceDestroy(source);
+  source->index = ~0u;
+  source->fading = false;
+}
+
+// Caller unlinks the Source from the active list
+static void unregisterSource(Source* source) {
+  if (source->index != ~0u) releaseVoice(source);
+  atomic_store(&source->virtual, false);
+  source->active = false;
+  source->next = NULL;
+  lovrRelease(source, lovrSourceDestroy);
+}
+
+// Consumer side, called by the mixer or by a producer while the mixer is paused
+static void flushCommands(void) {
+  uint32_t head = state.head;
+  uint32_t tail = atomic_load(&state.tail);
+
+  for (; head != tail; head++) {
+    Command* command = &state.commands[head & (MAX_COMMANDS - 1)];
+    Source* source = command->source;
+
+    switch (command->type) {
+      case COMMAND_PLAY:
+        source->mixPlayback = command->playback;
+        registerSource(source);
+        if (source->stream) seekStream(source);
+        break;
+      case COMMAND_SEEK:
+        source->cursor = command->offset;
+        atomic_store(&source->offset, command->offset);
+        if (source->stream) seekStream(source);
+        break;
+      case COMMAND_PITCH:
+        ma_data_converter_set_rate_ratio(source->converter, command->ratio);
+        source->ratio = command->ratio;
+        break;
+      case COMMAND_VOLUME:
+        source->targetVolume = command->volume;
+        if (!source->active) source->gain = command->volume;
+        break;
+      case COMMAND_LOOPING: source->mixLooping = command->looping; break;
+      case COMMAND_PRIORITY: source->mixPriority = command->priority; break;
+      case COMMAND_PARAMS: source->mixParams = command->params; break;
+      case COMMAND_LISTENER:
+        vec3_init(state.listenerPosition, command->pose.position);
+        state.spatializer->setListenerPose(command->pose.position, command->pose.orientation);
+        break;
+      case COMMAND_ROUTE:
+        lovrRetain(command->bus);
+        lovrRelease(source->mixBus, lovrBusDestroy);
+        source->mixBus = command->bus;
+        break;
+      case COMMAND_BUS: command->bus->mixParams = command->busParams; break;
+    }
+
+    lovrRelease(source, lovrSourceDestroy);
+    lovrRelease(command->bus, lovrBusDestroy);
+  }
+
+  atomic_store(&state.head, tail);
+}
+
+// Producer side.  The ring only fills up if the mixer isn't running (e.g. no device is started),
+// in which case the backlog gets applied here.
+static void pushCommand(Command* command) {
+  lovrRetain(command->source);
+  lovrRetain(command->bus);
   ma_mutex_lock(&state.lock);
 
-  Source* source;
-  FOREACH_SOURCE(source) {
-    if (!source->playing) {
-      state.sources[source->index] = NULL;
-      state.sourceMask &= ~(1ull << source->index);
-      state.spatializer->sourceDestroy(source);
-      source->index = ~0u;
-      lovrRelease(source, lovrSourceDestroy);
+  uint32_t tail = state.tail;
+  if (tail - atomic_load(&state.head) >= MAX_COMMANDS) {
+    pauseMixer();
+    flushCommands();
+    resumeMixer();
+  }
+
+  state.commands[tail & (MAX_COMMANDS - 1)] = *command;
+  atomic_store(&state.tail, tail + 1);
+  ma_mutex_unlock(&state.lock);
+}
+
+static void pushParams(Source* source) {
+  pushCommand(&(Command) { .type = COMMAND_PARAMS, .source = source, .params = source->params });
+}
+
+static void pushBusParams(Bus* bus) {
+  pushCommand(&(Command) { .type = COMMAND_BUS, .bus = bus, .busParams = bus->params });
+}
+
+// Sample cache
+
+static void evictSample(size_t index) {
+  CacheEntry* entry = &state.cache.data[index];
+  state.cacheSize -= entry->size;
+  lovrRelease(entry->blob, lovrBlobDestroy);
+  lovrRelease(entry->sound, lovrSoundDestroy);
+  state.cache.data[index] = state.cache.data[--state.cache.length];
+}
+
+// A hash match only counts if the file contents and the decoded format match too
+static bool isCachedSample(CacheEntry* entry, uint64_t hash, Blob* blob, Sound* sound) {
+  if (entry->hash != hash) {
+    return false;
+  }
+
+  Sound* pcm = entry->sound;
+
+  if (
+    entry->frames != lovrSoundGetFrameCount(sound) ||
+    lovrSoundGetChannelLayout(pcm) != lovrSoundGetChannelLayout(sound) ||
+    lovrSoundGetSampleRate(pcm) != lovrSoundGetSampleRate(sound)
+  ) {
+    return false;
+  }
+
+  return entry->blob == blob || (entry->blob->size == blob->size && !memcmp(entry->blob->data, blob->data, blob->size));
+}
+
+// Returns a retained decoded copy of a short compressed Sound, shared by every Source created from
+// the same file contents, or NULL if the Sound doesn't qualify or fails to decode
+static Sound* getCachedSample(Sound* sound) {
+  if (!lovrSoundIsCompressed(sound) || !lovrSoundGetBlob(sound)) {
+    return NULL;
+  }
+
+  // Entries keep the file contents to check matches against, which counts towards the budget
+  Blob* blob = lovrSoundGetBlob(sound);
+  uint32_t frames = lovrSoundGetFrameCount(sound);
+  size_t size = frames * lovrSoundGetStride(sound) + blob->size;
+  if (frames > state.cacheDuration * lovrSoundGetSampleRate(sound) || size > state.cacheBudget) {
+    return NULL;
+  }
+
+  uint64_t hash = hash64(blob->data, blob->size);
+
+  mtx_lock(&state.cacheLock);
+  for (size_t i = 0; i < state.cache.length; i++) {
+    if (isCachedSample(&state.cache.data[i], hash, blob, sound)) {
+      Sound* pcm = state.cache.data[i].sound;
+      state.cache.data[i].lastUsed = ++state.cacheTick;
+      lovrRetain(pcm);
+      mtx_unlock(&state.cacheLock);
+      return pcm;
+    }
+  }
+  mtx_unlock(&state.cacheLock);
+
+  Sound* pcm = lovrSoundCreateFromFile(blob, true);
+
+  // Not caching isn't an error, the Source streams the Sound instead
+  if (!pcm) {
+    lovrClearError();
+    return NULL;
+  }
+
+  size = lovrSoundGetFrameCount(pcm) * lovrSoundGetStride(pcm) + blob->size;
+
+  mtx_lock(&state.cacheLock);
+
+  // Another thread may have decoded the same Sound in the meantime, it's fine to keep both
+  while (state.cacheSize + size > state.cacheBudget && state.cache.length > 0) {
+    size_t oldest = 0;
+    for (size_t i = 1; i < state.cache.length; i++) {
+      if (state.cache.data[i].lastUsed < state.cache.data[oldest].lastUsed) {
+        oldest = i;
+      }
+    }
+    evictSample(oldest);
+  }
+
+  arr_push(&state.cache, ((CacheEntry) { hash, blob, frames, pcm, size, ++state.cacheTick }));
+  state.cacheSize += size;
+  lovrRetain(blob);
+  lovrRetain(pcm);
+
+  mtx_unlock(&state.cacheLock);
+  return pcm;
+}
+
+// Voices
+
+// Rough loudness estimate used to rank Sources, it ignores spatializer-specific effects.  Streams
+// always rank first since they need to keep being consumed.
+static float getAudibility(Source* source) {
+  if (lovrSoundIsStream(source->sound)) {
+    return HUGE_VALF;
+  }
+
+  float audibility = source->targetVolume;
+
+  if (source->spatial && (source->mixParams.effects & (1 << EFFECT_ATTENUATION))) {
+    float distance = vec3_distance(source->mixParams.position, state.listenerPosition);
+    audibility /= MAX(distance, 1.f);
+  }
+
+  // Favor Sources that already have a voice so they don't flip back and forth
+  return source->index == ~0u ? audibility : audibility * 1.25f;
+}
+
+static bool outranks(Source* a, Source* b) {
+  return a->mixPriority != b->mixPriority ? a->mixPriority > b->mixPriority : a->audibility > b->audibility;
+}
+
+// Time keeps passing for virtual Sources even though nothing is decoded.  Streams have no cursor,
+// the frames they would have played are read and dropped so they resume with current audio.
+static void advanceVirtual(Source* source, uint32_t count) {
+  float frames = count * source->ratio + source->phase;
+  uint32_t whole = (uint32_t) frames;
+  source->phase = frames - whole;
+
+  if (lovrSoundIsStream(source->sound)) {
+    char scratch[4096];
+    uint32_t capacity = (uint32_t) (sizeof(scratch) / lovrSoundGetStride(source->sound));
+    while (whole > 0) {
+      uint32_t read = lovrSoundRead(source->sound, 0, MIN(whole, capacity), scratch);
+      if (read == 0) break;
+      whole -= read;
+    }
+    return;
+  }
+
+  uint32_t length = lovrSoundGetFrameCount(source->sound);
+  source->cursor += whole;
+
+  if (source->cursor >= length) {
+    if (source->mixLooping && length > 0) {
+      source->cursor %= length;
+    } else {
+      source->cursor = 0;
+      finishSource(source);
+    }
+  }
+
+  atomic_store(&source->offset, source->cursor);
+}
+
+// Drops stopped Sources, ranks the rest, and gives voices to the best ones, returns the number of
+// Sources to mix written to real: the ones with voices sorted by rank, then the fading ones
+static uint32_t assignVoices(Source** real) {
+  uint32_t budget = atomic_load(&state.maxVoices);
+  uint32_t count = 0;
+
+  for (Source** link = &state.sources; *link;) {
+    Source* source = *link;
+
+    if (!lovrSourceIsPlaying(source)) {
+      *link = source->next;
+      unregisterSource(source);
       continue;
     }
 
-    // Read and convert raw frames until there's BUFFER_SIZE converted frames
-    // - No converter: just read frames into raw (it has enough space for BUFFER_SIZE frames).
-    // - Converter: keep reading as many frames as possible/needed into raw and convert into aux.
-    // - If EOF is reached, rewind and continue for looping sources, otherwise pad end with zero.
-    buf = source->converter ? aux : raw;
-    float* cursor = buf; // Edge of processed frames
-    uint32_t channelsOut = source->spatial ? 1 : 2; // If spatializer isn't converting to stereo, converter must do it
-    uint32_t framesRemaining = BUFFER_SIZE;
-    while (framesRemaining > 0) {
-      uint32_t framesRead;
-
-      if (source->converter) {
-        uint32_t channelsIn = lovrSoundGetChannelCount(source->sound);
-        uint32_t capacity = sizeof(raw) / (channelsIn * sizeof(float));
-        ma_uint64 chunk;
-        ma_data_converter_get_required_input_frame_count(source->converter, framesRemaining, &chunk);
-        framesRead = lovrSoundRead(source->sound, source->offset, MIN(chunk, capacity), raw);
-      } else {
-        framesRead = lovrSoundRead(source->sound, source->offset, framesRemaining, cursor);
+    link = &source->next;
+    source->selected = false;
+    source->audibility = getAudibility(source);
+
+    if (source->audibility <= 0.f) {
+      continue;
+    }
+
+    // Insertion into the sorted list of the best Sources so far
+    uint32_t i;
+    if (count < budget) {
+      i = count++;
+    } else if (outranks(source, real[budget - 1])) {
+      i = budget - 1;
+    } else {
+      continue;
+    }
+
+    while (i > 0 && outranks(source, real[i - 1])) {
+      real[i] = real[i - 1];
+      i--;
+    }
+
+    real[i] = source;
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    real[i]->selected = true;
+    real[i]->fading = false;
+  }
+
+  // A Source that loses its voice keeps it for one more buffer to fade out instead of cutting off,
+  // then the voice is released.  Release voices before acquiring any so the slots are free.
+  for (Source* source = state.sources; source; source = source->next) {
+    if (source->selected) {
+      continue;
+    } else if (source->index != ~0u && !source->fading) {
+      source->fading = true;
+      continue;
+    } else if (source->index != ~0u) {
+      releaseVoice(source);
+      source->phase = 0.f;
+    }
+
+    atomic_store(&source->virtual, true);
+    advanceVirtual(source, state.mixFrames);
+  }
+
+  // If fading Sources hold every slot, the rest of the selected Sources wait a buffer for a voice
+  uint32_t voices = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    Source* source = real[i];
+
+    if (source->index == ~0u) {
+      if (state.voiceMask == ~0ull) {
+        atomic_store(&source->virtual, true);
+        advanceVirtual(source, state.mixFrames);
+        continue;
       }
 
-      if (framesRead == 0) {
-        if (source->looping) {
-          source->offset = 0;
-          continue;
-        } else {
-          source->offset = 0;
-          source->playing = false;
-          memset(cursor, 0, framesRemaining * channelsOut * sizeof(float));
-          break;
-        }
+      acquireVoice(source);
+    }
+
+    real[voices++] = source;
+  }
+
+  for (Source* source = state.sources; source; source = source->next) {
+    if (source->fading) {
+      real[voices++] = source;
+    }
+  }
+
+  return voices;
+}
+
+// Mixing
+
+// Adds frames of a real Source into dst, safe to call for different Sources at once if the
+// spatializer allows it
+static void mixSource(Source* source, float* dst, uint32_t frames) {
+  float raw[BUFFER_SIZE * 2];
+  float aux[BUFFER_SIZE * 2];
+  float mix[BUFFER_SIZE * 2];
+
+  // Read and convert raw frames until there's enough converted frames
+  // - No converter: just read frames into raw (it has enough space for BUFFER_SIZE frames).
+  //   16 bit samples are read into aux first and expanded to floats in raw.
+  // - Converter: keep reading as many frames as possible/needed into raw and convert into aux.
+  // - If EOF is reached, rewind and continue for looping sources, otherwise pad end with zero.
+  float* buf = source->converter ? aux : raw; // The "current" buffer (used for fast paths)
+  float* cursor = buf; // Edge of processed frames
+  uint32_t channelsOut = source->spatial ? 1 : 2; // If spatializer isn't converting to stereo, converter must do it
+  uint32_t framesRemaining = frames;
+
+  // A stream that was just played or seeked outputs silence until the worker catches up
+  if (source->stream && !isStreamReady(source)) {
+    memset(cursor, 0, framesRemaining * channelsOut * sizeof(float));
+    framesRemaining = 0;
+  }
+
+  while (framesRemaining > 0) {
+    uint32_t framesRead;
+
+    if (source->converter) {
+      uint32_t channelsIn = lovrSoundGetChannelCount(source->sound);
+      uint32_t capacity = sizeof(raw) / (channelsIn * sizeof(float));
+      ma_uint64 chunk;
+      ma_data_converter_get_required_input_frame_count(source->converter, framesRemaining, &chunk);
+      framesRead = readSource(source, MIN(chunk, capacity), raw);
+    } else if (lovrSoundGetFormat(source->sound) == SAMPLE_I16) {
+      framesRead = readSource(source, framesRemaining, aux);
+      mix_i16ToF32(cursor, (int16_t*) aux, framesRead * channelsOut);
+    } else {
+      framesRead = readSource(source, framesRemaining, cursor);
+    }
+
+    if (framesRead == 0) {
+      if (source->mixLooping) {
+        source->cursor = 0;
+        continue;
       } else {
-        source->offset += framesRead;
+        source->cursor = 0;
+        finishSource(source);
+        memset(cursor, 0, framesRemaining * channelsOut * sizeof(float));
+        break;
       }
+    } else {
+      source->cursor += framesRead;
+    }
 
-      if (source->converter) {
-        ma_uint64 framesIn = framesRead;
-        ma_uint64 framesOut = framesRemaining;
+    if (source->converter) {
+      ma_uint64 framesIn = framesRead;
+      ma_uint64 framesOut = framesRemaining;
+
+      if (source->converter->hasResampler) {
+        double start = os_get_time();
         ma_data_converter_process_pcm_frames(source->converter, raw, &framesIn, cursor, &framesOut);
-        cursor += framesOut * channelsOut;
-        framesRemaining -= framesOut;
+        uint32_t micros = (uint32_t) ((os_get_time() - start) * 1e6 + .5);
+        atomic_fetch_add(&state.resampledFrames[source->resampler], (uint32_t) framesOut);
+        atomic_fetch_add(&state.resampleTime[source->resampler], micros);
       } else {
-        cursor += framesRead * channelsOut;
-        framesRemaining -= framesRead;
+        ma_data_converter_process_pcm_frames(source->converter, raw, &framesIn, cursor, &framesOut);
       }
+      cursor += framesOut * channelsOut;
+      framesRemaining -= framesOut;
+    } else {
+      cursor += framesRead * channelsOut;
+      framesRemaining -= framesRead;
+    }
+  }
+
+  atomic_store(&source->offset, source->cursor);
+
+  // Spatialize
+  if (source->spatial) {
+    state.spatializer->apply(source, buf, mix, frames, frames);
+    buf = mix;
+  }
+
+  // Mix, ramping the volume across the buffer to avoid zipper noise
+  float volume = source->fading ? 0.f : source->targetVolume;
+  mix_addRamp(dst, buf, source->gain, volume, frames);
+  source->gain = volume;
+}
+
+// Low-pass and compressor, in place.  Volume and the reverb send are applied when the Bus is added
+// to the output.
+static void processBus(Bus* bus, uint32_t frames) {
+  BusParams* params = &bus->mixParams;
+  float* data = bus->buffer;
+
+  if (params->cutoff > 0.f) {
+    float alpha = 1.f - expf(-2.f * (float) M_PI * params->cutoff / state.sampleRate);
+    for (uint32_t i = 0; i < frames; i++) {
+      bus->filter[0] += alpha * (data[2 * i + 0] - bus->filter[0]);
+      bus->filter[1] += alpha * (data[2 * i + 1] - bus->filter[1]);
+      data[2 * i + 0] = bus->filter[0];
+      data[2 * i + 1] = bus->filter[1];
+    }
+  } else {
+    // Keep tracking the input so turning the filter on doesn't click
+    bus->filter[0] = data[2 * frames - 2];
+    bus->filter[1] = data[2 * frames - 1];
+  }
+
+  if (params->ratio > 1.f) {
+    float attack = expf(-1.f / (MAX(params->attack, 1e-4f) * state.sampleRate));
+    float release = expf(-1.f / (MAX(params->release, 1e-4f) * state.sampleRate));
+    float slope = 1.f - 1.f / params->ratio;
+    for (uint32_t i = 0; i < frames; i++) {
+      float peak = MAX(fabsf(data[2 * i + 0]), fabsf(data[2 * i + 1]));
+      float over = peak > 1e-6f ? MAX(linearToDb(peak) - params->threshold, 0.f) * slope : 0.f;
+      float coefficient = over > bus->envelope ? attack : release;
+      bus->envelope = over + coefficient * (bus->envelope - over);
+      float gain = dbToLinear(-bus->envelope);
+      data[2 * i + 0] *= gain;
+      data[2 * i + 1] *= gain;
+    }
+  } else {
+    bus->envelope = 0.f;
+  }
+}
+
+// Schroeder reverb shared by all Buses: parallel damped combs into series allpasses, per channel.
+// The right channel's delays are slightly longer to decorrelate it from the left.
+static void applyReverb(float* dst, uint32_t frames) {
+  for (uint32_t c = 0; c < 2; c++) {
+    for (uint32_t i = 0; i < frames; i++) {
+      float x = state.reverbInput[2 * i + c] * REVERB_GAIN;
+      float y = 0.f;
+
+      for (uint32_t j = 0; j < COUNTOF(state.combs[c]); j++) {
+        Delay* comb = &state.combs[c][j];
+        float out = comb->data[comb->index];
+        comb->filter = out + REVERB_DAMPING * (comb->filter - out);
+        comb->data[comb->index] = x + comb->filter * REVERB_FEEDBACK;
+        comb->index = comb->index + 1 == comb->size ? 0 : comb->index + 1;
+        y += out;
+      }
+
+      for (uint32_t j = 0; j < COUNTOF(state.allpasses[c]); j++) {
+        Delay* allpass = &state.allpasses[c][j];
+        float out = allpass->data[allpass->index];
+        allpass->data[allpass->index] = y + out * .5f;
+        allpass->index = allpass->index + 1 == allpass->size ? 0 : allpass->index + 1;
+        y = out - y;
+      }
+
+      dst[2 * i + c] += y;
+    }
+  }
+}
+
+static bool readsSound(Source* source) {
+  return !source->stream && !source->pcm && (lovrSoundIsCompressed(source->sound) || lovrSoundIsStream(source->sound));
+}
+
+static void runTask(MixTask* task) {
+  memset(task->bus->buffer, 0, sizeof(task->bus->buffer));
+
+  for (uint32_t i = 0; i < task->count; i++) {
+    mixSource(task->sources[i], task->bus->buffer, state.mixFrames);
+  }
+
+  processBus(task->bus, state.mixFrames);
+}
+
+// The task count and the next task share a word, so a claim always sees the count of the buffer it
+// belongs to.  A claim past the count is a no-op, and the mixer only waits for claims below it.
+static void runTasks(void) {
+  for (;;) {
+    uint32_t ticket = atomic_fetch_add(&state.claim, 1);
+    uint32_t index = ticket & 0xfff;
+    uint32_t count = (ticket >> 12) & 0xfff;
+
+    if (index >= count) {
+      break;
     }
 
-    // Spatialize
-    if (source->spatial) {
-      state.spatializer->apply(source, buf, mix, BUFFER_SIZE, BUFFER_SIZE);
-      buf = mix;
+    runTask(&state.tasks[index]);
+    atomic_fetch_add(&state.tasksDone, 1);
+  }
+}
+
+// Workers sleep until the mixer bumps the generation.  The mixer signals without taking the lock,
+// so a wakeup can be missed, which only means the mixer does more of that buffer's work itself.
+static int mixLoop(void* arg) {
+  uint32_t generation = 0;
+
+  for (;;) {
+    mtx_lock(&state.mixLock);
+    while (atomic_load(&state.mixGeneration) == generation && !state.mixQuit) {
+      cnd_wait(&state.mixCond, &state.mixLock);
     }
+    generation = atomic_load(&state.mixGeneration);
+    bool quit = state.mixQuit;
+    mtx_unlock(&state.mixLock);
 
-    // Mix
-    float volume = source->volume;
-    for (uint32_t i = 0; i < OUTPUT_CHANNELS * BUFFER_SIZE; i++) {
-      dst[i] += buf[i] * volume;
+    if (quit) {
+      break;
     }
+
+    runTasks();
+  }
+
+  return 0;
+}
+
+// Mixes frames (at most BUFFER_SIZE) into dst.  Workers read the frame count from the state, it's
+// set before the generation is bumped.
+static void mixSources(float* dst, uint32_t frames) {
+  float aux[BUFFER_SIZE * 2];
+  float mix[BUFFER_SIZE * 2];
+
+  state.mixFrames = frames;
+  flushCommands();
+
+  Source* real[MAX_SOURCES];
+  uint32_t count = assignVoices(real);
+
+  // Group the real Sources by Bus, keeping their rank order within each group.  Sources without a
+  // Bus mix straight into the output.
+  Source* grouped[MAX_SOURCES];
+  uint32_t direct = 0;
+  uint32_t taskCount = 0;
+  state.mixTick++;
+
+  for (uint32_t i = 0; i < count; i++) {
+    Bus* bus = real[i]->mixBus;
+    if (!bus) {
+      direct++;
+    } else if (bus->tick != state.mixTick) {
+      bus->tick = state.mixTick;
+      bus->task = taskCount++;
+      state.tasks[bus->task] = (MixTask) { .bus = bus };
+    }
+
+    if (bus) {
+      state.tasks[bus->task].count++;
+    }
+  }
+
+  // Decoders and Sound streams can't be read from two threads at once, so Sources that read them
+  // directly stay on the mixer thread: tasks with any such Source are moved after the ones workers
+  // can claim.  Direct Sources are always mixed by the mixer.
+  uint32_t shared = taskCount;
+  for (uint32_t i = 0; i < count; i++) {
+    Bus* bus = real[i]->mixBus;
+    if (bus && bus->task < shared && readsSound(real[i])) {
+      MixTask task = state.tasks[bus->task];
+      state.tasks[bus->task] = state.tasks[--shared];
+      state.tasks[shared] = task;
+      state.tasks[bus->task].bus->task = bus->task;
+      bus->task = shared;
+    }
+  }
+
+  for (uint32_t i = 0, offset = direct; i < taskCount; i++) {
+    state.tasks[i].sources = grouped + offset;
+    offset += state.tasks[i].count;
+    state.tasks[i].count = 0;
+  }
+
+  for (uint32_t i = 0, d = 0; i < count; i++) {
+    if (real[i]->mixBus) {
+      MixTask* task = &state.tasks[real[i]->mixBus->task];
+      task->sources[task->count++] = real[i];
+    } else {
+      grouped[d++] = real[i];
+    }
+  }
+
+  bool parallel =
+    shared > 0 &&
+    taskCount + (direct > 0) > 1 &&
+    count >= PARALLEL_VOICES &&
+    state.spatializer->parallel &&
+    state.serialBuffers == 0 &&
+    atomic_load(&state.mixWorkerCount) > 0;
+
+  if (parallel) {
+    atomic_store(&state.tasksDone, 0);
+    atomic_store(&state.claim, shared << 12);
+    atomic_fetch_add(&state.mixGeneration, 1);
+    cnd_broadcast(&state.mixCond);
+  } else if (state.serialBuffers > 0) {
+    state.serialBuffers--;
+  }
+
+  for (uint32_t i = 0; i < direct; i++) {
+    mixSource(grouped[i], dst, frames);
+  }
+
+  for (uint32_t i = parallel ? shared : 0; i < taskCount; i++) {
+    runTask(&state.tasks[i]);
+  }
+
+  if (parallel) {
+    runTasks();
+
+    // Only tasks a worker already started are left.  If a worker was descheduled in the middle of
+    // one, the wait can't be skipped, but workers are left out for a while so it doesn't repeat.
+    if (atomic_load(&state.tasksDone) < shared) {
+      double start = os_get_time();
+
+      while (atomic_load(&state.tasksDone) < shared) {
+        thrd_yield();
+      }
+
+      if (os_get_time() - start > MIX_WAIT_LIMIT * BUFFER_SIZE / state.sampleRate) {
+        state.serialBuffers = SERIAL_BUFFERS;
+      }
+    }
+
+    atomic_store(&state.claim, 0);
+  }
+
+  // Sum the Buses in a fixed order, so the output doesn't depend on which thread mixed what
+  bool reverb = false;
+  memset(state.reverbInput, 0, sizeof(state.reverbInput));
+
+  for (uint32_t i = 0; i < taskCount; i++) {
+    Bus* bus = state.tasks[i].bus;
+    float volume = bus->mixParams.volume;
+    float send = volume * bus->mixParams.reverb;
+    mix_addRamp(dst, bus->buffer, bus->gain, volume, frames);
+    bus->gain = volume;
+
+    if (bus->send > 0.f || send > 0.f) {
+      mix_addRamp(state.reverbInput, bus->buffer, bus->send, send, frames);
+      reverb = true;
+    }
+
+    bus->send = send;
+  }
+
+  if (reverb) {
+    state.reverbTail = state.sampleRate * 4;
+  }
+
+  if (state.reverbTail > 0) {
+    applyReverb(dst, frames);
+    state.reverbTail -= MIN(state.reverbTail, frames);
   }
 
   // Tail
-  uint32_t tailCount = state.spatializer->tail(aux, mix, BUFFER_SIZE);
-  for (uint32_t i = 0; i < tailCount * OUTPUT_CHANNELS; i++) {
-    dst[i] += mix[i];
+  uint32_t tailCount = state.spatializer->tail(aux, mix, frames);
+  mix_add(dst, mix, tailCount * OUTPUT_CHANNELS);
+}
+
+// Device callbacks
+
+static void onPlayback(ma_device* device, void* out, const void* in, uint32_t count) {
+  if (count != BUFFER_SIZE) {
+    return;
   }
 
-  ma_mutex_unlock(&state.lock);
+  float* dst = out;
+
+  atomic_store(&state.mixing, true);
+
+  if (!atomic_load(&state.paused)) {
+    mixSources(dst, BUFFER_SIZE);
+  }
+
+  atomic_store(&state.mixing, false);
+
+  Sound* sink = state.sinks[AUDIO_PLAYBACK];
 
-  if (state.sinks[AUDIO_PLAYBACK]) {
-    uint64_t capacity = sizeof(aux) / lovrSoundGetChannelCount(state.sinks[AUDIO_PLAYBACK]) / sizeof(float);
+  if (sink && lovrSoundGetChannelCount(sink) == OUTPUT_CHANNELS && lovrSoundGetSampleRate(sink) == state.sampleRate) {
+    if (lovrSoundGetFormat(sink) == SAMPLE_I16) {
+      int16_t samples[BUFFER_SIZE * OUTPUT_CHANNELS];
+      mix_f32ToI16(samples, dst, count * OUTPUT_CHANNELS);
+      lovrSoundWrite(sink, 0, count, samples, NULL);
+    } else {
+      lovrSoundWrite(sink, 0, count, dst, NULL);
+    }
+  } else if (sink) {
+    float aux[BUFFER_SIZE * 2];
+    uint64_t capacity = sizeof(aux) / lovrSoundGetChannelCount(sink) / sizeof(float);
     while (count > 0) {
       ma_uint64 framesConsumed = count;
       ma_uint64 framesWritten = capacity;
       ma_data_converter_process_pcm_frames(&state.playbackConverter, dst, &framesConsumed, aux, &framesWritten);
-      lovrSoundWrite(state.sinks[AUDIO_PLAYBACK], 0, framesWritten, aux, NULL);
+      lovrSoundWrite(sink, 0, framesWritten, aux, NULL);
       dst += framesConsumed * OUTPUT_CHANNELS;
       count -= framesConsumed;
     }
@@ -196,7 +1287,7 @@ static Spatializer* spatializers[] = {
 
 // Entry
 
-bool lovrAudioInit(const char* spatializer, uint32_t sampleRate) {
+bool lovrAudioInit(const char* spatializer, uint32_t sampleRate, float readAhead) {
   if (atomic_fetch_add(&state.ref, 1)) return true;
 
   ma_result result = ma_context_init(NULL, 0, NULL, &state.context);
@@ -233,6 +1324,65 @@ bool lovrAudioInit(const char* spatializer, uint32_t sampleRate) {
 
   quat_identity(state.orientation);
   state.sampleRate = sampleRate;
+  state.maxVoices = MAX_SOURCES;
+  state.readAhead = readAhead;
+
+  mtx_init(&state.cacheLock, mtx_plain);
+  arr_init(&state.cache);
+  state.cacheDuration = 2.f;
+  state.cacheBudget = 16 << 20;
+
+  lovrResamplerInit();
+  state.resampler = RESAMPLER_LINEAR;
+
+  mtx_init(&state.mixLock, mtx_plain);
+  cnd_init(&state.mixCond);
+
+  // Delay lengths are Freeverb's, tuned for 44.1kHz
+  uint32_t combSizes[] = { 1116, 1188, 1277, 1356 };
+  uint32_t allpassSizes[] = { 556, 441 };
+  uint32_t total = 0;
+
+  for (uint32_t c = 0; c < 2; c++) {
+    for (uint32_t i = 0; i < COUNTOF(combSizes); i++) {
+      state.combs[c][i].size = (uint32_t) ((combSizes[i] + 23 * c) * (sampleRate / 44100.f));
+      total += state.combs[c][i].size;
+    }
+
+    for (uint32_t i = 0; i < COUNTOF(allpassSizes); i++) {
+      state.allpasses[c][i].size = (uint32_t) ((allpassSizes[i] + 23 * c) * (sampleRate / 44100.f));
+      total += state.allpasses[c][i].size;
+    }
+  }
+
+  float* data = state.reverbData = lovrCalloc(total * sizeof(float));
+
+  for (uint32_t c = 0; c < 2; c++) {
+    for (uint32_t i = 0; i < COUNTOF(combSizes); i++) {
+      state.combs[c][i].data = data;
+      data += state.combs[c][i].size;
+    }
+
+    for (uint32_t i = 0; i < COUNTOF(allpassSizes); i++) {
+      state.allpasses[c][i].data = data;
+      data += state.allpasses[c][i].size;
+    }
+  }
+
+  if (readAhead > 0.f) {
+    arr_init(&state.streams);
+    mtx_init(&state.decodeLock, mtx_plain);
+    cnd_init(&state.decodeCond);
+    state.decoding = true;
+
+    if (thrd_create(&state.decoder, decodeLoop, NULL) != thrd_success) {
+      state.decoding = false;
+      state.readAhead = 0.f;
+      mtx_destroy(&state.decodeLock);
+      cnd_destroy(&state.decodeCond);
+    }
+  }
+
   return true;
 }
 
@@ -242,8 +1392,40 @@ void lovrAudioDestroy(void) {
     ma_device_uninit(&state.devices[i]);
     lovrFree(state.deviceInfo[i]);
   }
-  Source* source;
-  FOREACH_SOURCE(source) lovrRelease(source, lovrSourceDestroy);
+  flushCommands();
+  while (state.sources) {
+    Source* source = state.sources;
+    state.sources = source->next;
+    unregisterSource(source);
+  }
+  if (state.decoding) {
+    mtx_lock(&state.decodeLock);
+    state.decoding = false;
+    cnd_signal(&state.decodeCond);
+    mtx_unlock(&state.decodeLock);
+    thrd_join(state.decoder, NULL);
+    for (size_t i = 0; i < state.streams.length; i++) {
+      lovrRelease(state.streams.data[i], lovrStreamDestroy);
+    }
+    arr_free(&state.streams);
+    mtx_destroy(&state.decodeLock);
+    cnd_destroy(&state.decodeCond);
+  }
+  while (state.cache.length > 0) {
+    evictSample(0);
+  }
+  arr_free(&state.cache);
+  mtx_destroy(&state.cacheLock);
+  mtx_lock(&state.mixLock);
+  state.mixQuit = true;
+  cnd_broadcast(&state.mixCond);
+  mtx_unlock(&state.mixLock);
+  for (uint32_t i = 0; i < state.mixWorkerCount; i++) {
+    thrd_join(state.mixWorkers[i], NULL);
+  }
+  mtx_destroy(&state.mixLock);
+  cnd_destroy(&state.mixCond);
+  lovrFree(state.reverbData);
   ma_mutex_uninit(&state.lock);
   ma_context_uninit(&state.context);
   lovrRelease(state.sinks[AUDIO_PLAYBACK], lovrSoundDestroy);
@@ -391,16 +1573,113 @@ void lovrAudioGetPose(float position[3], float orientation[4]) {
 }
 
 void lovrAudioSetPose(float position[3], float orientation[4]) {
-  state.spatializer->setListenerPose(position, orientation);
+  vec3_init(state.position, position);
+  quat_init(state.orientation, orientation);
+  Command command = { .type = COMMAND_LISTENER };
+  vec3_init(command.pose.position, position);
+  quat_init(command.pose.orientation, orientation);
+  pushCommand(&command);
 }
 
 bool lovrAudioSetGeometry(float* vertices, uint32_t* indices, uint32_t vertexCount, uint32_t indexCount, AudioMaterial material) {
   ma_mutex_lock(&state.lock);
+  pauseMixer();
   bool success = state.spatializer->setGeometry(vertices, indices, vertexCount, indexCount, material);
+  resumeMixer();
   ma_mutex_unlock(&state.lock);
   return success;
 }
 
+uint32_t lovrAudioGetMaxVoices(void) {
+  return atomic_load(&state.maxVoices);
+}
+
+void lovrAudioSetMaxVoices(uint32_t count) {
+  count = CLAMP(count, 1, MAX_SOURCES);
+  ma_mutex_lock(&state.lock);
+  state.spatializer->reserveVoices(MIN(count * 2, MAX_SOURCES));
+  atomic_store(&state.maxVoices, count);
+  ma_mutex_unlock(&state.lock);
+}
+
+// Runs the mixer on the calling thread as fast as possible, the device outputs silence meanwhile
+Sound* lovrAudioRender(uint32_t frames, double* averageTime, double* peakTime) {
+  Sound* sound = lovrSoundCreateRaw(frames, SAMPLE_F32, CHANNEL_STEREO, state.sampleRate, NULL);
+  float buffer[BUFFER_SIZE * OUTPUT_CHANNELS];
+  double total = 0.;
+  double peak = 0.;
+  uint32_t count = 0;
+
+  ma_mutex_lock(&state.lock);
+  pauseMixer();
+  state.rendering = true;
+
+  // The last buffer only mixes the frames that are left, so Sources end up exactly frames ahead
+  for (uint32_t offset = 0; offset < frames; offset += BUFFER_SIZE, count++) {
+    uint32_t chunk = MIN(BUFFER_SIZE, frames - offset);
+    memset(buffer, 0, sizeof(buffer));
+    double start = os_get_time();
+    mixSources(buffer, chunk);
+    double time = os_get_time() - start;
+    lovrSoundWrite(sound, offset, chunk, buffer, NULL);
+    peak = MAX(peak, time);
+    total += time;
+  }
+
+  state.rendering = false;
+  resumeMixer();
+  ma_mutex_unlock(&state.lock);
+
+  *averageTime = count > 0 ? total / count : 0.;
+  *peakTime = peak;
+  return sound;
+}
+
+void lovrAudioGetSampleCache(float* duration, size_t* budget, size_t* size, uint32_t* count) {
+  mtx_lock(&state.cacheLock);
+  *duration = state.cacheDuration;
+  *budget = state.cacheBudget;
+  *size = state.cacheSize;
+  *count = (uint32_t) state.cache.length;
+  mtx_unlock(&state.cacheLock);
+}
+
+void lovrAudioSetSampleCache(float duration, size_t budget) {
+  mtx_lock(&state.cacheLock);
+  state.cacheDuration = duration;
+  state.cacheBudget = budget;
+  while (state.cacheSize > state.cacheBudget) {
+    size_t oldest = 0;
+    for (size_t i = 1; i < state.cache.length; i++) {
+      if (state.cache.data[i].lastUsed < state.cache.data[oldest].lastUsed) {
+        oldest = i;
+      }
+    }
+    evictSample(oldest);
+  }
+  mtx_unlock(&state.cacheLock);
+}
+
+ResamplerMode lovrAudioGetResampler(void) {
+  return state.resampler;
+}
+
+void lovrAudioSetResampler(ResamplerMode mode) {
+  state.resampler = mode;
+}
+
+// Counters wrap, so report the difference since the last call
+void lovrAudioGetResamplerStats(uint32_t frames[3], double time[3]) {
+  for (uint32_t i = 0; i < 3; i++) {
+    uint32_t totalFrames = atomic_load(&state.resampledFrames[i]);
+    uint32_t totalTime = atomic_load(&state.resampleTime[i]);
+    frames[i] = totalFrames - state.seenFrames[i];
+    time[i] = (totalTime - state.seenTime[i]) / 1e6;
+    state.seenFrames[i] = totalFrames;
+    state.seenTime[i] = totalTime;
+  }
+}
+
 const char* lovrAudioGetSpatializer(void) {
   return state.spatializer->name;
 }
@@ -415,13 +1694,23 @@ void lovrAudioGetAbsorption(float absorption[3]) {
 
 void lovrAudioSetAbsorption(float absorption[3]) {
   ma_mutex_lock(&state.lock);
+  pauseMixer();
   memcpy(state.absorption, absorption, 3 * sizeof(float));
+  resumeMixer();
   ma_mutex_unlock(&state.lock);
 }
 
 // Source
 
-Source* lovrSourceCreate(Sound* sound, bool pitchable, bool spatial, uint32_t effects) {
+static void setResampler(ma_data_converter_config* config, ResamplerMode mode) {
+  if (mode != RESAMPLER_LINEAR) {
+    config->resampling.algorithm = ma_resample_algorithm_custom;
+    config->resampling.pBackendVTable = &lovrResamplerBackend;
+    config->resampling.pBackendUserData = (void*) (uintptr_t) mode;
+  }
+}
+
+Source* lovrSourceCreate(Sound* sound, bool pitchable, bool spatial, uint32_t effects, ResamplerMode resampler) {
   lovrCheck(lovrSoundGetChannelLayout(sound) != CHANNEL_AMBISONIC, "Ambisonic Sources are not currently supported");
 
   Source* source = lovrCalloc(sizeof(Source));
@@ -430,10 +1719,15 @@ Source* lovrSourceCreate(Sound* sound, bool pitchable, bool spatial, uint32_t ef
   source->sound = sound;
   source->pitch = 1.f;
   source->volume = 1.f;
+  source->gain = 1.f;
+  source->targetVolume = 1.f;
+  source->ratio = (float) lovrSoundGetSampleRate(sound) / state.sampleRate;
   source->pitchable = pitchable;
   source->spatial = spatial;
-  source->effects = spatial ? effects : 0;
-  quat_identity(source->orientation);
+  source->resampler = resampler;
+  source->params.effects = spatial ? effects : 0;
+  quat_identity(source->params.orientation);
+  source->mixParams = source->params;
 
   ma_data_converter_config config = ma_data_converter_config_init_default();
   config.formatIn = miniaudioFormats[lovrSoundGetFormat(sound)];
@@ -443,8 +1737,10 @@ Source* lovrSourceCreate(Sound* sound, bool pitchable, bool spatial, uint32_t ef
   config.sampleRateIn = lovrSoundGetSampleRate(sound);
   config.sampleRateOut = state.sampleRate;
   config.allowDynamicSampleRate = pitchable;
+  setResampler(&config, resampler);
 
-  if (pitchable || config.formatIn != config.formatOut || config.channelsIn != config.channelsOut || config.sampleRateIn != config.sampleRateOut) {
+  // The mixer converts 16 bit samples itself, so a format mismatch alone doesn't need a converter
+  if (pitchable || config.channelsIn != config.channelsOut || config.sampleRateIn != config.sampleRateOut) {
     source->converter = lovrMalloc(sizeof(ma_data_converter));
     ma_result status = ma_data_converter_init(&config, NULL, source->converter);
 
@@ -456,6 +1752,10 @@ Source* lovrSourceCreate(Sound* sound, bool pitchable, bool spatial, uint32_t ef
     }
   }
 
+  if ((source->pcm = getCachedSample(sound)) == NULL && state.readAhead > 0.f && lovrSoundIsCompressed(sound)) {
+    source->streaming = true;
+  }
+
   lovrRetain(source->sound);
   return source;
 }
@@ -467,15 +1767,22 @@ Source* lovrSourceClone(Source* source) {
   clone->sound = source->sound;
   clone->pitch = source->pitch;
   clone->volume = source->volume;
-  vec3_init(clone->position, source->position);
-  quat_init(clone->orientation, source->orientation);
-  clone->radius = source->radius;
-  clone->dipoleWeight = source->dipoleWeight;
-  clone->dipolePower = source->dipolePower;
-  clone->effects = source->effects;
+  clone->gain = source->volume;
+  clone->targetVolume = source->volume;
+  clone->ratio = source->pitch * lovrSoundGetSampleRate(source->sound) / state.sampleRate;
+  clone->priority = source->priority;
+  clone->mixPriority = source->priority;
+  clone->params = source->params;
+  clone->mixParams = source->params;
   clone->looping = source->looping;
+  clone->mixLooping = source->looping;
   clone->pitchable = source->pitchable;
   clone->spatial = source->spatial;
+  clone->resampler = source->resampler;
+  clone->bus = source->bus;
+  clone->mixBus = source->bus;
+  lovrRetain(clone->bus);
+  lovrRetain(clone->mixBus);
 
   if (source->converter) {
     ma_data_converter_config config = ma_data_converter_config_init_default();
@@ -486,6 +1793,7 @@ Source* lovrSourceClone(Source* source) {
     config.sampleRateIn = source->converter->sampleRateIn;
     config.sampleRateOut = source->converter->sampleRateOut;
     config.allowDynamicSampleRate = clone->pitchable;
+    setResampler(&config, clone->resampler);
 
     clone->converter = lovrMalloc(sizeof(ma_data_converter));
     ma_result status = ma_data_converter_init(&config, NULL, clone->converter);
@@ -496,15 +1804,30 @@ Source* lovrSourceClone(Source* source) {
       lovrFree(clone);
       return NULL;
     }
+
+    if (clone->pitchable) {
+      ma_data_converter_set_rate_ratio(clone->converter, clone->ratio);
+    }
   }
 
+  clone->pcm = source->pcm;
+  clone->streaming = source->streaming;
+  lovrRetain(clone->pcm);
+
   lovrRetain(clone->sound);
   return clone;
 }
 
 void lovrSourceDestroy(void* ref) {
   Source* source = ref;
+  if (source->stream) {
+    atomic_store(&source->stream->dead, true);
+    lovrRelease(source->stream, lovrStreamDestroy);
+  }
+  lovrRelease(source->pcm, lovrSoundDestroy);
   lovrRelease(source->sound, lovrSoundDestroy);
+  lovrRelease(source->bus, lovrBusDestroy);
+  lovrRelease(source->mixBus, lovrBusDestroy);
   ma_data_converter_uninit(source->converter, NULL);
   lovrFree(source->converter);
   lovrFree(source);
@@ -515,31 +1838,27 @@ Sound* lovrSourceGetSound(Source* source) {
 }
 
 bool lovrSourcePlay(Source* source) {
-  // If too many sources already running, refuse to play
-  if (state.sourceMask == ~0ull) {
-    return false;
+  // The mixer can't see the stream before the play command is pushed
+  if (source->streaming && !source->stream) {
+    source->stream = createStream(source->sound);
+    atomic_store(&source->stream->looping, source->looping);
   }
 
-  ma_mutex_lock(&state.lock);
-
-  source->playing = true;
-
-  // If the source isn't tracked, set its index to the right-most zero bit in the mask
-  if (source->index == ~0u) {
-    uint32_t index = state.sourceMask ? CTZL(~state.sourceMask) : 0;
-    state.sourceMask |= (1ull << index);
-    state.sources[index] = source;
-    source->index = index;
-    lovrRetain(source);
-    state.spatializer->sourceCreate(source);
+  // Per-voice spatializer resources are allocated here, since the mixer assigns voices
+  if (source->spatial) {
+    ma_mutex_lock(&state.lock);
+    state.spatializer->reserveVoices(MIN(atomic_load(&state.maxVoices) * 2, MAX_SOURCES));
+    ma_mutex_unlock(&state.lock);
   }
 
-  ma_mutex_unlock(&state.lock);
+  uint32_t playback = atomic_load(&source->playback);
+  while (!atomic_compare_exchange_weak(&source->playback, &playback, (playback + 2) | 1));
+  pushCommand(&(Command) { .type = COMMAND_PLAY, .source = source, .playback = (playback + 2) | 1 });
   return true;
 }
 
 void lovrSourcePause(Source* source) {
-  source->playing = false;
+  atomic_fetch_and(&source->playback, ~1u);
 }
 
 void lovrSourceStop(Source* source) {
@@ -548,7 +1867,7 @@ void lovrSourceStop(Source* source) {
 }
 
 bool lovrSourceIsPlaying(Source* source) {
-  return source->playing;
+  return atomic_load(&source->playback) & 1;
 }
 
 bool lovrSourceIsLooping(Source* source) {
@@ -557,7 +1876,13 @@ bool lovrSourceIsLooping(Source* source) {
 
 bool lovrSourceSetLooping(Source* source, bool loop) {
   lovrCheck(loop == false || lovrSoundIsStream(source->sound) == false, "Can't loop streams");
-  source->looping = loop;
+
+  if (source->looping != loop) {
+    source->looping = loop;
+    if (source->stream) atomic_store(&source->stream->looping, loop);
+    pushCommand(&(Command) { .type = COMMAND_LOOPING, .source = source, .looping = loop });
+  }
+
   return true;
 }
 
@@ -571,10 +1896,8 @@ bool lovrSourceSetPitch(Source* source, float pitch) {
 
   if (source->pitch != pitch) {
     source->pitch = pitch;
-    ma_mutex_lock(&state.lock);
     float ratio = (float) lovrSoundGetSampleRate(source->sound) / state.sampleRate;
-    ma_data_converter_set_rate_ratio(source->converter, pitch * ratio);
-    ma_mutex_unlock(&state.lock);
+    pushCommand(&(Command) { .type = COMMAND_PITCH, .source = source, .ratio = pitch * ratio });
   }
 
   return true;
@@ -586,17 +1909,38 @@ float lovrSourceGetVolume(Source* source, VolumeUnit units) {
 
 void lovrSourceSetVolume(Source* source, float volume, VolumeUnit units) {
   if (units == UNIT_DECIBELS) volume = dbToLinear(volume);
-  source->volume = CLAMP(volume, 0.f, 1.f);
+  volume = CLAMP(volume, 0.f, 1.f);
+
+  if (source->volume != volume) {
+    source->volume = volume;
+    pushCommand(&(Command) { .type = COMMAND_VOLUME, .source = source, .volume = volume });
+  }
 }
 
 void lovrSourceSeek(Source* source, double time, TimeUnit units) {
-  ma_mutex_lock(&state.lock);
-  source->offset = units == UNIT_SECONDS ? (uint32_t) (time * lovrSoundGetSampleRate(source->sound) + .5) : (uint32_t) time;
-  ma_mutex_unlock(&state.lock);
+  uint32_t offset = units == UNIT_SECONDS ? (uint32_t) (time * lovrSoundGetSampleRate(source->sound) + .5) : (uint32_t) time;
+  atomic_store(&source->offset, offset);
+  pushCommand(&(Command) { .type = COMMAND_SEEK, .source = source, .offset = offset });
+}
+
+int lovrSourceGetPriority(Source* source) {
+  return source->priority;
+}
+
+void lovrSourceSetPriority(Source* source, int priority) {
+  if (source->priority != priority) {
+    source->priority = priority;
+    pushCommand(&(Command) { .type = COMMAND_PRIORITY, .source = source, .priority = priority });
+  }
+}
+
+bool lovrSourceIsVirtual(Source* source) {
+  return atomic_load(&source->virtual);
 }
 
 double lovrSourceTell(Source* source, TimeUnit units) {
-  return units == UNIT_SECONDS ? (double) source->offset / lovrSoundGetSampleRate(source->sound) : source->offset;
+  uint32_t offset = atomic_load(&source->offset);
+  return units == UNIT_SECONDS ? (double) offset / lovrSoundGetSampleRate(source->sound) : offset;
 }
 
 double lovrSourceGetDuration(Source* source, TimeUnit units) {
@@ -604,56 +1948,75 @@ double lovrSourceGetDuration(Source* source, TimeUnit units) {
   return units == UNIT_SECONDS ? (double) frames / lovrSoundGetSampleRate(source->sound) : frames;
 }
 
+ResamplerMode lovrSourceGetResampler(Source* source) {
+  return source->resampler;
+}
+
 bool lovrSourceIsSpatial(Source* source) {
   return source->spatial;
 }
 
 void lovrSourceGetPose(Source* source, float position[3], float orientation[4]) {
-  vec3_init(position, source->position);
-  quat_init(orientation, source->orientation);
+  vec3_init(position, source->params.position);
+  quat_init(orientation, source->params.orientation);
 }
 
 void lovrSourceSetPose(Source* source, float position[3], float orientation[4]) {
-  ma_mutex_lock(&state.lock);
-  if (position) vec3_init(source->position, position);
-  if (orientation) quat_init(source->orientation, orientation);
-  ma_mutex_unlock(&state.lock);
+  if (position) vec3_init(source->params.position, position);
+  if (orientation) quat_init(source->params.orientation, orientation);
+  pushParams(source);
 }
 
 float lovrSourceGetRadius(Source* source) {
-  return source->radius;
+  return source->params.radius;
 }
 
 void lovrSourceSetRadius(Source* source, float radius) {
-  source->radius = radius;
+  source->params.radius = radius;
+  pushParams(source);
 }
 
 void lovrSourceGetDirectivity(Source* source, float* weight, float* power) {
-  *weight = source->dipoleWeight;
-  *power = source->dipolePower;
+  *weight = source->params.dipoleWeight;
+  *power = source->params.dipolePower;
 }
 
 void lovrSourceSetDirectivity(Source* source, float weight, float power) {
-  source->dipoleWeight = weight;
-  source->dipolePower = power;
+  source->params.dipoleWeight = weight;
+  source->params.dipolePower = power;
+  pushParams(source);
 }
 
 bool lovrSourceIsEffectEnabled(Source* source, Effect effect) {
-  return source->effects & (1 << effect);
+  return source->params.effects & (1 << effect);
 }
 
 bool lovrSourceSetEffectEnabled(Source* source, Effect effect, bool enabled) {
   lovrCheck(source->spatial, "Sources must be created with the spatial flag to enable effects");
 
   if (enabled) {
-    source->effects |= (1 << effect);
+    source->params.effects |= (1 << effect);
   } else {
-    source->effects &= ~(1 << effect);
+    source->params.effects &= ~(1 << effect);
   }
 
+  pushParams(source);
   return true;
 }
 
+Bus* lovrSourceGetBus(Source* source) {
+  return source->bus;
+}
+
+void lovrSourceSetBus(Source* source, Bus* bus) {
+  if (source->bus != bus) {
+    lovrRetain(bus);
+    lovrRelease(source->bus, lovrBusDestroy);
+    source->bus = bus;
+    pushCommand(&(Command) { .type = COMMAND_ROUTE, .source = source, .bus = bus });
+  }
+}
+
 intptr_t* lovrSourceGetSpatializerMemoField(Source* source) {
   return &source->spatializerMemo;
 }
@@ -661,3 +2024,90 @@ intptr_t* lovrSourceGetSpatializerMemoField(Source* source) {
 uint32_t lovrSourceGetIndex(Source* source) {
   return source->index;
 }
+
+SpatialParams* lovrSourceGetSpatialParams(Source* source) {
+  return &source->mixParams;
+}
+
+// Bus
+
+// Mix workers are started with the first Bus, since Buses are the only work they can do
+static void startMixWorkers(void) {
+  ma_mutex_lock(&state.lock);
+
+  if (atomic_load(&state.mixWorkerCount) == 0) {
+    uint32_t cores = os_get_core_count();
+    uint32_t count = MIN(cores > 2 ? cores - 2 : 0, MAX_MIX_WORKERS);
+    uint32_t started = 0;
+
+    while (started < count && thrd_create(&state.mixWorkers[started], mixLoop, NULL) == thrd_success) {
+      started++;
+    }
+
+    atomic_store(&state.mixWorkerCount, started);
+  }
+
+  ma_mutex_unlock(&state.lock);
+}
+
+Bus* lovrBusCreate(void) {
+  Bus* bus = lovrCalloc(sizeof(Bus));
+  bus->ref = 1;
+  bus->params.volume = 1.f;
+  bus->params.threshold = 0.f;
+  bus->params.ratio = 1.f;
+  bus->params.attack = .01f;
+  bus->params.release = .1f;
+  bus->mixParams = bus->params;
+  bus->gain = 1.f;
+  startMixWorkers();
+  return bus;
+}
+
+void lovrBusDestroy(void* ref) {
+  Bus* bus = ref;
+  lovrFree(bus);
+}
+
+float lovrBusGetVolume(Bus* bus, VolumeUnit units) {
+  return units == UNIT_LINEAR ? bus->params.volume : linearToDb(bus->params.volume);
+}
+
+void lovrBusSetVolume(Bus* bus, float volume, VolumeUnit units) {
+  if (units == UNIT_DECIBELS) volume = dbToLinear(volume);
+  bus->params.volume = MAX(volume, 0.f);
+  pushBusParams(bus);
+}
+
+float lovrBusGetLowPass(Bus* bus) {
+  return bus->params.cutoff;
+}
+
+void lovrBusSetLowPass(Bus* bus, float cutoff) {
+  bus->params.cutoff = MAX(cutoff, 0.f);
+  pushBusParams(bus);
+}
+
+void lovrBusGetCompressor(Bus* bus, float* threshold, float* ratio, float* attack, float* release) {
+  *threshold = bus->params.threshold;
+  *ratio = bus->params.ratio;
+  *attack = bus->params.attack;
+  *release = bus->params.release;
+}
+
+void lovrBusSetCompressor(Bus* bus, float threshold, float ratio, float attack, float release) {
+  bus->params.threshold = threshold;
+  bus->params.ratio = MAX(ratio, 1.f);
+  bus->params.attack = MAX(attack, 0.f);
+  bus->params.release = MAX(release, 0.f);
+  pushBusParams(bus);
+}
+
+float lovrBusGetReverb(Bus* bus) {
+  return bus->params.reverb;
+}
+
+void lovrBusSetReverb(Bus* bus, float send) {
+  bus->params.reverb = CLAMP(send, 0.f, 1.f);
+  pushBusParams(bus);
+}
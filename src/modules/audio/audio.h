@@ -5,11 +5,12 @@
 #pragma once
 
 #define BUFFER_SIZE 256
-#define MAX_SOURCES 64
+#define MAX_SOURCES 64 // Real voices, any number of Sources can play with the rest virtualized
 
 struct Sound;
 
 typedef struct Source Source;
+typedef struct Bus Bus;
 
 typedef enum {
   EFFECT_ABSORPTION,
@@ -61,9 +62,15 @@ typedef enum {
   UNIT_DECIBELS
 } VolumeUnit;
 
+typedef enum {
+  RESAMPLER_LINEAR,
+  RESAMPLER_CUBIC,
+  RESAMPLER_SINC
+} ResamplerMode;
+
 typedef void AudioDeviceCallback(AudioDevice* device, void* userdata);
 
-bool lovrAudioInit(const char* spatializer, uint32_t sampleRate);
+bool lovrAudioInit(const char* spatializer, uint32_t sampleRate, float readAhead);
 void lovrAudioDestroy(void);
 void lovrAudioEnumerateDevices(AudioType type, AudioDeviceCallback* callback, void* userdata);
 bool lovrAudioGetDevice(AudioType type, AudioDevice* device);
@@ -76,6 +83,14 @@ void lovrAudioSetVolume(float volume, VolumeUnit units);
 void lovrAudioGetPose(float position[3], float orientation[4]);
 void lovrAudioSetPose(float position[3], float orientation[4]);
 bool lovrAudioSetGeometry(float* vertices, uint32_t* indices, uint32_t vertexCount, uint32_t indexCount, AudioMaterial material);
+struct Sound* lovrAudioRender(uint32_t frames, double* averageTime, double* peakTime);
+uint32_t lovrAudioGetMaxVoices(void);
+void lovrAudioSetMaxVoices(uint32_t count);
+void lovrAudioGetSampleCache(float* duration, size_t* budget, size_t* size, uint32_t* count);
+void lovrAudioSetSampleCache(float duration, size_t budget);
+ResamplerMode lovrAudioGetResampler(void);
+void lovrAudioSetResampler(ResamplerMode mode);
+void lovrAudioGetResamplerStats(uint32_t frames[3], double time[3]);
 const char* lovrAudioGetSpatializer(void);
 uint32_t lovrAudioGetSampleRate(void);
 void lovrAudioGetAbsorption(float absorption[3]);
@@ -83,7 +98,7 @@ void lovrAudioSetAbsorption(float absorption[3]);
 
 // Source
 
-Source* lovrSourceCreate(struct Sound* sound, bool pitch, bool spatial, uint32_t effects);
+Source* lovrSourceCreate(struct Sound* sound, bool pitch, bool spatial, uint32_t effects, ResamplerMode resampler);
 Source* lovrSourceClone(Source* source);
 void lovrSourceDestroy(void* ref);
 struct Sound* lovrSourceGetSound(Source* source);
@@ -99,9 +114,13 @@ float lovrSourceGetVolume(Source* source, VolumeUnit units);
 void lovrSourceSetVolume(Source* source, float volume, VolumeUnit units);
 void lovrSourceSeek(Source* source, double time, TimeUnit units);
 double lovrSourceTell(Source* source, TimeUnit units);
+int lovrSourceGetPriority(Source* source);
+void lovrSourceSetPriority(Source* source, int priority);
+bool lovrSourceIsVirtual(Source* source);
 double lovrSourceGetDuration(Source* source, TimeUnit units);
 bool lovrSourceIsPitchable(Source* source);
 bool lovrSourceIsSpatial(Source* source);
+ResamplerMode lovrSourceGetResampler(Source* source);
 void lovrSourceGetPose(Source* source, float position[3], float orientation[4]);
 void lovrSourceSetPose(Source* source, float position[3], float orientation[4]);
 float lovrSourceGetRadius(Source* source);
@@ -110,3 +129,18 @@ void lovrSourceGetDirectivity(Source* source, float* weight, float* power);
 void lovrSourceSetDirectivity(Source* source, float weight, float power);
 bool lovrSourceIsEffectEnabled(Source* source, Effect effect);
 bool lovrSourceSetEffectEnabled(Source* Source, Effect effect, bool enabled);
+Bus* lovrSourceGetBus(Source* source);
+void lovrSourceSetBus(Source* source, Bus* bus);
+
+// Bus
+
+Bus* lovrBusCreate(void);
+void lovrBusDestroy(void* ref);
+float lovrBusGetVolume(Bus* bus, VolumeUnit units);
+void lovrBusSetVolume(Bus* bus, float volume, VolumeUnit units);
+float lovrBusGetLowPass(Bus* bus);
+void lovrBusSetLowPass(Bus* bus, float cutoff);
+void lovrBusGetCompressor(Bus* bus, float* threshold, float* ratio, float* attack, float* release);
+void lovrBusSetCompressor(Bus* bus, float threshold, float ratio, float attack, float release);
+float lovrBusGetReverb(Bus* bus);
+void lovrBusSetReverb(Bus* bus, float send);
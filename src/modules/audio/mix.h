@@ -0,0 +1,188 @@
+#include <stdint.h>
+#include <math.h>
+
+#pragma once
+
+// Mixing kernels.  SIMD paths are selected at compile time, define MIX_NO_SIMD to use the scalar
+// code everywhere.  Counts are in samples unless noted otherwise, and buffers don't need alignment.
+
+#if !defined(MIX_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MIX_SSE
+#include <emmintrin.h>
+#elif !defined(MIX_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#define MIX_NEON
+#include <arm_neon.h>
+#endif
+
+// dst += src
+static inline void mix_add(float* dst, const float* src, uint32_t count) {
+  uint32_t i = 0;
+#if defined(MIX_SSE)
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+  }
+#elif defined(MIX_NEON)
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] += src[i];
+  }
+}
+
+// dst += src * gain, for interleaved stereo.  The gain starts at from and ramps linearly to reach to
+// at the end of the buffer.  Count is in frames.
+static inline void mix_addRamp(float* dst, const float* src, float from, float to, uint32_t count) {
+  float step = (to - from) / count;
+  uint32_t i = 0;
+#if defined(MIX_SSE)
+  if (from == to) {
+    __m128 g = _mm_set1_ps(from);
+    for (; i + 2 <= count; i += 2) {
+      _mm_storeu_ps(dst + 2 * i, _mm_add_ps(_mm_loadu_ps(dst + 2 * i), _mm_mul_ps(_mm_loadu_ps(src + 2 * i), g)));
+    }
+  } else {
+    __m128 g = _mm_setr_ps(from, from, from + step, from + step);
+    __m128 d = _mm_set1_ps(2.f * step);
+    for (; i + 2 <= count; i += 2) {
+      _mm_storeu_ps(dst + 2 * i, _mm_add_ps(_mm_loadu_ps(dst + 2 * i), _mm_mul_ps(_mm_loadu_ps(src + 2 * i), g)));
+      g = _mm_add_ps(g, d);
+    }
+  }
+#elif defined(MIX_NEON)
+  float32x4_t g = { from, from, from + step, from + step };
+  float32x4_t d = vdupq_n_f32(2.f * step);
+  for (; i + 2 <= count; i += 2) {
+    vst1q_f32(dst + 2 * i, vmlaq_f32(vld1q_f32(dst + 2 * i), vld1q_f32(src + 2 * i), g));
+    g = vaddq_f32(g, d);
+  }
+#endif
+  for (; i < count; i++) {
+    float gain = from + step * i;
+    dst[2 * i + 0] += src[2 * i + 0] * gain;
+    dst[2 * i + 1] += src[2 * i + 1] * gain;
+  }
+}
+
+// Spreads a mono signal to interleaved stereo with a constant gain per channel.  Count is in frames.
+static inline void mix_spread(float* dst, const float* src, float left, float right, uint32_t count) {
+  uint32_t i = 0;
+#if defined(MIX_SSE)
+  __m128 g = _mm_setr_ps(left, right, left, right);
+  for (; i + 4 <= count; i += 4) {
+    __m128 x = _mm_loadu_ps(src + i);
+    _mm_storeu_ps(dst + 2 * i + 0, _mm_mul_ps(_mm_unpacklo_ps(x, x), g));
+    _mm_storeu_ps(dst + 2 * i + 4, _mm_mul_ps(_mm_unpackhi_ps(x, x), g));
+  }
+#elif defined(MIX_NEON)
+  for (; i + 4 <= count; i += 4) {
+    float32x4x2_t x;
+    x.val[0] = vmulq_n_f32(vld1q_f32(src + i), left);
+    x.val[1] = vmulq_n_f32(vld1q_f32(src + i), right);
+    vst2q_f32(dst + 2 * i, x);
+  }
+#endif
+  for (; i < count; i++) {
+    dst[2 * i + 0] = src[i] * left;
+    dst[2 * i + 1] = src[i] * right;
+  }
+}
+
+// The plain loop is left to the compiler, intrinsics benchmarked slower than its vectorized code
+static inline void mix_i16ToF32(float* restrict dst, const int16_t* restrict src, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    dst[i] = src[i] * (1.f / 32768.f);
+  }
+}
+
+// Clamps to [-1, 1] and rounds to nearest
+static inline void mix_f32ToI16(int16_t* dst, const float* src, uint32_t count) {
+  uint32_t i = 0;
+#if defined(MIX_SSE)
+  __m128 scale = _mm_set1_ps(32767.f);
+  __m128 min = _mm_set1_ps(-1.f);
+  __m128 max = _mm_set1_ps(1.f);
+  for (; i + 8 <= count; i += 8) {
+    __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 0), min), max);
+    __m128 y = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), min), max);
+    __m128i lo = _mm_cvtps_epi32(_mm_mul_ps(x, scale));
+    __m128i hi = _mm_cvtps_epi32(_mm_mul_ps(y, scale));
+    _mm_storeu_si128((__m128i*) (dst + i), _mm_packs_epi32(lo, hi));
+  }
+#elif defined(MIX_NEON)
+  for (; i + 8 <= count; i += 8) {
+    int32x4_t lo = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i + 0), 32767.f));
+    int32x4_t hi = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i + 4), 32767.f));
+    vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+  }
+#endif
+  for (; i < count; i++) {
+    float x = src[i] < -1.f ? -1.f : (src[i] > 1.f ? 1.f : src[i]);
+    dst[i] = (int16_t) lrintf(x * 32767.f);
+  }
+}
+
+// dst = a + (b - a) * t
+// Also left to the compiler, like mix_i16ToF32
+static inline void mix_lerp(float* restrict dst, const float* a, const float* b, float t, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    dst[i] = a[i] + (b[i] - a[i]) * t;
+  }
+}
+
+// Weighted sum of taps interleaved frames, one output frame: dst[c] = sum(src[k * channels + c] * kernel[k]).
+// Taps must be a multiple of 4.
+static inline void mix_convolve(float* dst, const float* src, const float* kernel, uint32_t taps, uint32_t channels) {
+#if defined(MIX_SSE)
+  if (channels == 1) {
+    __m128 sum = _mm_setzero_ps();
+    for (uint32_t k = 0; k < taps; k += 4) {
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + k), _mm_loadu_ps(kernel + k)));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    dst[0] = _mm_cvtss_f32(sum);
+    return;
+  } else if (channels == 2) {
+    __m128 sum = _mm_setzero_ps();
+    for (uint32_t k = 0; k < taps; k += 4) {
+      __m128 w = _mm_loadu_ps(kernel + k);
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + 2 * k + 0), _mm_unpacklo_ps(w, w)));
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + 2 * k + 4), _mm_unpackhi_ps(w, w)));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    _mm_store_ss(dst + 0, sum);
+    _mm_store_ss(dst + 1, _mm_shuffle_ps(sum, sum, 1));
+    return;
+  }
+#elif defined(MIX_NEON)
+  if (channels == 1) {
+    float32x4_t sum = vdupq_n_f32(0.f);
+    for (uint32_t k = 0; k < taps; k += 4) {
+      sum = vmlaq_f32(sum, vld1q_f32(src + k), vld1q_f32(kernel + k));
+    }
+    dst[0] = vaddvq_f32(sum);
+    return;
+  } else if (channels == 2) {
+    float32x4_t left = vdupq_n_f32(0.f);
+    float32x4_t right = vdupq_n_f32(0.f);
+    for (uint32_t k = 0; k < taps; k += 4) {
+      float32x4x2_t x = vld2q_f32(src + 2 * k);
+      float32x4_t w = vld1q_f32(kernel + k);
+      left = vmlaq_f32(left, x.val[0], w);
+      right = vmlaq_f32(right, x.val[1], w);
+    }
+    dst[0] = vaddvq_f32(left);
+    dst[1] = vaddvq_f32(right);
+    return;
+  }
+#endif
+  for (uint32_t c = 0; c < channels; c++) {
+    float sum = 0.f;
+    for (uint32_t k = 0; k < taps; k++) {
+      sum += src[k * channels + c] * kernel[k];
+    }
+    dst[c] = sum;
+  }
+}
@@ -0,0 +1,227 @@
+#include "audio/resampler.h"
+#include "audio/mix.h"
+#include "util.h"
+#include <string.h>
+#include <math.h>
+
+#define MAX_CHANNELS 2
+#define SINC_HALF 16
+#define SINC_TAPS (2 * SINC_HALF)
+#define SINC_PHASES 256
+#define SINC_CUTOFF .95
+
+// Time is 32.32 fixed point, in input frames from the start of the history.  The output frame at
+// time t is a weighted sum of the 2 * half input frames around it, so the history keeps the last
+// 2 * half frames from the previous call.  Because time is exact, the required input count always
+// matches what process consumes.
+typedef struct {
+  uint32_t channels;
+  uint32_t half;
+  uint64_t time;
+  uint64_t step;
+  float* history; // 2 * half frames
+  float* edge; // 4 * half frames, the history followed by the start of the input
+} Resampler;
+
+// Windowed sinc, one row of taps per phase with an extra row so phases can be interpolated
+static float sincTable[SINC_PHASES + 1][SINC_TAPS];
+
+void lovrResamplerInit(void) {
+  for (uint32_t p = 0; p <= SINC_PHASES; p++) {
+    double fraction = (double) p / SINC_PHASES;
+    double sum = 0.;
+
+    for (uint32_t k = 0; k < SINC_TAPS; k++) {
+      double x = (double) k - (SINC_HALF - 1) - fraction;
+      double y = M_PI * SINC_CUTOFF * x;
+      double sinc = fabs(y) < 1e-9 ? 1. : sin(y) / y;
+      double window = .42 + .5 * cos(M_PI * x / SINC_HALF) + .08 * cos(2. * M_PI * x / SINC_HALF);
+      sincTable[p][k] = (float) (sinc * window);
+      sum += sinc * window;
+    }
+
+    // Normalize each phase so there's no gain ripple across fractional positions
+    for (uint32_t k = 0; k < SINC_TAPS; k++) {
+      sincTable[p][k] /= (float) sum;
+    }
+  }
+}
+
+static uint32_t getHalfWidth(void* userdata) {
+  return (ResamplerMode) (uintptr_t) userdata == RESAMPLER_SINC ? SINC_HALF : 2;
+}
+
+static void getKernel(Resampler* resampler, uint32_t fraction, float* kernel) {
+  float t = fraction * (1.f / 4294967296.f);
+
+  if (resampler->half == 2) {
+    // Catmull-Rom
+    float t2 = t * t;
+    float t3 = t2 * t;
+    kernel[0] = .5f * (-t3 + 2.f * t2 - t);
+    kernel[1] = .5f * (3.f * t3 - 5.f * t2 + 2.f);
+    kernel[2] = .5f * (-3.f * t3 + 4.f * t2 + t);
+    kernel[3] = .5f * (t3 - t2);
+  } else {
+    float phase = t * SINC_PHASES;
+    uint32_t index = MIN((uint32_t) phase, SINC_PHASES - 1);
+    mix_lerp(kernel, sincTable[index], sincTable[index + 1], phase - index, SINC_TAPS);
+  }
+}
+
+static ma_result resampler_getHeapSize(void* userdata, const ma_resampler_config* config, size_t* size) {
+  if (config->channels > MAX_CHANNELS) {
+    return MA_INVALID_ARGS;
+  }
+
+  uint32_t half = getHalfWidth(userdata);
+  *size = ALIGN(sizeof(Resampler), 16) + 6 * half * config->channels * sizeof(float);
+  return MA_SUCCESS;
+}
+
+static ma_result resampler_reset(void* userdata, ma_resampling_backend* backend) {
+  Resampler* resampler = backend;
+  memset(resampler->history, 0, 2 * resampler->half * resampler->channels * sizeof(float));
+  resampler->time = (uint64_t) (2 * resampler->half) << 32;
+  return MA_SUCCESS;
+}
+
+static ma_result resampler_setRate(void* userdata, ma_resampling_backend* backend, ma_uint32 rateIn, ma_uint32 rateOut) {
+  Resampler* resampler = backend;
+  resampler->step = ((uint64_t) rateIn << 32) / rateOut;
+  return resampler->step > 0 ? MA_SUCCESS : MA_INVALID_ARGS;
+}
+
+static ma_result resampler_init(void* userdata, const ma_resampler_config* config, void* heap, ma_resampling_backend** backend) {
+  if (config->format != ma_format_f32 || config->channels > MAX_CHANNELS) {
+    return MA_INVALID_ARGS;
+  }
+
+  Resampler* resampler = heap;
+  resampler->channels = config->channels;
+  resampler->half = getHalfWidth(userdata);
+  resampler->history = (float*) ((char*) heap + ALIGN(sizeof(Resampler), 16));
+  resampler->edge = resampler->history + 2 * resampler->half * resampler->channels;
+  resampler_reset(userdata, resampler);
+  *backend = resampler;
+  return resampler_setRate(userdata, resampler, config->sampleRateIn, config->sampleRateOut);
+}
+
+static void resampler_uninit(void* userdata, ma_resampling_backend* backend, const ma_allocation_callbacks* allocator) {
+  // The Resampler lives in miniaudio's heap
+}
+
+static ma_result resampler_process(void* userdata, ma_resampling_backend* backend, const void* input, ma_uint64* frameCountIn, void* output, ma_uint64* frameCountOut) {
+  Resampler* resampler = backend;
+  uint32_t channels = resampler->channels;
+  uint32_t half = resampler->half;
+  uint32_t taps = 2 * half;
+  uint64_t countIn = *frameCountIn;
+  uint64_t countOut = *frameCountOut;
+  const float* in = input;
+  float* out = output;
+
+  // Kernels that start in the history read from the edge buffer, the rest read the input directly.
+  // A NULL input is silence.
+  static const float zeros[SINC_TAPS * MAX_CHANNELS];
+  uint64_t head = MIN(countIn, taps);
+  float* edge = resampler->edge;
+  memcpy(edge, resampler->history, taps * channels * sizeof(float));
+  memset(edge + taps * channels, 0, taps * channels * sizeof(float));
+  if (in) memcpy(edge + taps * channels, in, head * channels * sizeof(float));
+
+  float kernel[SINC_TAPS];
+  uint64_t produced = 0;
+  uint64_t last = 0;
+
+  while (produced < countOut) {
+    uint64_t index = resampler->time >> 32;
+
+    if (index + half >= taps + countIn) {
+      break;
+    }
+
+    uint64_t start = index + 1 - half;
+
+    if (out) {
+      const float* frames = start < taps ? edge + start * channels : (in ? in + (start - taps) * channels : zeros);
+      getKernel(resampler, (uint32_t) resampler->time, kernel);
+      mix_convolve(out + produced * channels, frames, kernel, taps, channels);
+    }
+
+    last = index;
+    resampler->time += resampler->step;
+    produced++;
+  }
+
+  // Input is only consumed up to the last frame a produced output needed, unless it ran out
+  uint64_t consumed;
+  if (produced < countOut) {
+    consumed = countIn;
+  } else if (produced == 0) {
+    consumed = 0;
+  } else {
+    consumed = last + half + 1 > taps ? MIN(last + half + 1 - taps, countIn) : 0;
+  }
+
+  // The new history is the last taps frames of the old history followed by the consumed input
+  float* history = resampler->history;
+  if (consumed >= taps) {
+    if (in) {
+      memcpy(history, in + (consumed - taps) * channels, taps * channels * sizeof(float));
+    } else {
+      memset(history, 0, taps * channels * sizeof(float));
+    }
+  } else if (consumed > 0) {
+    uint32_t kept = taps - (uint32_t) consumed;
+    memmove(history, history + consumed * channels, kept * channels * sizeof(float));
+    if (in) {
+      memcpy(history + kept * channels, in, consumed * channels * sizeof(float));
+    } else {
+      memset(history + kept * channels, 0, consumed * channels * sizeof(float));
+    }
+  }
+
+  resampler->time -= consumed << 32;
+  *frameCountIn = consumed;
+  *frameCountOut = produced;
+  return MA_SUCCESS;
+}
+
+static ma_uint64 resampler_getInputLatency(void* userdata, const ma_resampling_backend* backend) {
+  return getHalfWidth(userdata);
+}
+
+static ma_result resampler_getRequiredInputFrameCount(void* userdata, const ma_resampling_backend* backend, ma_uint64 frameCountOut, ma_uint64* frameCountIn) {
+  const Resampler* resampler = backend;
+
+  if (frameCountOut == 0) {
+    *frameCountIn = 0;
+    return MA_SUCCESS;
+  }
+
+  uint64_t last = (resampler->time + (frameCountOut - 1) * resampler->step) >> 32;
+  uint64_t needed = last + resampler->half + 1;
+  uint64_t taps = 2 * resampler->half;
+  *frameCountIn = needed > taps ? needed - taps : 0;
+  return MA_SUCCESS;
+}
+
+static ma_result resampler_getExpectedOutputFrameCount(void* userdata, const ma_resampling_backend* backend, ma_uint64 frameCountIn, ma_uint64* frameCountOut) {
+  const Resampler* resampler = backend;
+  uint64_t limit = (uint64_t) (resampler->half + frameCountIn) << 32;
+  *frameCountOut = resampler->time < limit ? (limit - resampler->time + resampler->step - 1) / resampler->step : 0;
+  return MA_SUCCESS;
+}
+
+ma_resampling_backend_vtable lovrResamplerBackend = {
+  .onGetHeapSize = resampler_getHeapSize,
+  .onInit = resampler_init,
+  .onUninit = resampler_uninit,
+  .onProcess = resampler_process,
+  .onSetRate = resampler_setRate,
+  .onGetInputLatency = resampler_getInputLatency,
+  .onGetRequiredInputFrameCount = resampler_getRequiredInputFrameCount,
+  .onGetExpectedOutputFrameCount = resampler_getExpectedOutputFrameCount,
+  .onReset = resampler_reset
+};
@@ -0,0 +1,10 @@
+#include "audio.h"
+#include "lib/miniaudio/miniaudio.h"
+
+#pragma once
+
+// miniaudio resampling backend for the cubic and sinc ResamplerModes, the mode is passed as the
+// backend's user data.  The linear mode uses miniaudio's own resampler.
+
+void lovrResamplerInit(void);
+extern ma_resampling_backend_vtable lovrResamplerBackend;
@@ -1,8 +1,19 @@
 #include "audio.h"
 
+// Spatial parameters of a Source, as seen by the mixer
+typedef struct {
+  float position[3];
+  float orientation[4];
+  float radius;
+  float dipoleWeight;
+  float dipolePower;
+  uint32_t effects;
+} SpatialParams;
+
 // Private Source functions for spatializer use
 intptr_t* lovrSourceGetSpatializerMemoField(Source* source);
 uint32_t lovrSourceGetIndex(Source* source);
+SpatialParams* lovrSourceGetSpatialParams(Source* source);
 
 typedef struct {
   bool (*init)(void);
@@ -15,11 +26,19 @@ typedef struct {
   // output is stereo, frames is stereo frames, scratch is a buffer the length of output (in case that helps)
   // return value is number of stereo frames written.
   uint32_t (*tail)(float* scratch, float* output, uint32_t frames);
+  // called on the mixer thread when a listener pose command is consumed
   void (*setListenerPose)(float position[3], float orientation[4]);
   bool (*setGeometry)(float* vertices, uint32_t* indices, uint32_t vertexCount, uint32_t indexCount, AudioMaterial material);
+  // called on the game thread with the number of voice slots before a spatial Source plays, so
+  // per-voice resources for the first count slots can be allocated off of the mixer thread.  This is
+  // twice the voice limit, since a Source fading out holds its slot for an extra buffer.
+  void (*reserveVoices)(uint32_t count);
+  // called on the mixer thread when a spatial Source gets or loses a voice, these must not allocate
   void (*sourceCreate)(Source* source);
   void (*sourceDestroy)(Source* source);
   const char* name;
+  // apply can be called for different Sources on different threads at the same time
+  bool parallel;
 } Spatializer;
 
 #ifdef LOVR_ENABLE_PHONON_SPATIALIZER
@@ -90,17 +90,9 @@ struct {
 
   bool poseUpdated; // setListenerPose has been called since the last playback
   ovrPoseStatef pose;
-  ma_mutex poseLock; // Using ma_mutex in case holding a lovr lock inside a ma lock is weird
-  bool poseLockInited;
 } state;
 
 static bool oculus_init(void) {
-  if (!state.poseLockInited) {
-    int mutexStatus = ma_mutex_init(&state.poseLock);
-    lovrAssert(mutexStatus == MA_SUCCESS, "Failed to create audio mutex");
-    state.poseLockInited = true;
-  }
-
   // Initialize Oculus
   ovrAudioContextConfiguration config = { 0 };
 
@@ -118,7 +110,6 @@ static bool oculus_init(void) {
 
 static void oculus_destroy(void) {
   ovrAudio_DestroyContext(state.context);
-  ma_mutex_uninit(&state.poseLock);
   memset(&state, 0, sizeof(state));
 }
 
@@ -142,11 +133,8 @@ static uint32_t oculus_apply(Source* source, const float* input, float* output,
     if (state.poseUpdated) {
       { // Tell Oculus Audio where the headset is
         ovrPoseStatef pose;
-
-        ma_mutex_lock(&state.poseLock); // Do nothing inside lock but make a copy of the pose
         memcpy(&pose, &state.pose, sizeof(pose));
         state.poseUpdated = false;
-        ma_mutex_unlock(&state.poseLock);
 
         ovrAudio_SetListenerPoseStatef(state.context, &pose); // Upload pose
       }
@@ -192,7 +180,7 @@ static uint32_t oculus_apply(Source* source, const float* input, float* output,
       state.sources[idx].occupied = true;
       ovrAudio_ResetAudioSource(state.context, idx);
       ovrAudio_SetAudioSourceAttenuationMode(state.context, idx,
-        lovrSourceIsEffectEnabled(source, EFFECT_ATTENUATION) ? ovrAudioSourceAttenuationMode_InverseSquare : ovrAudioSourceAttenuationMode_None, 1.0f);
+        (lovrSourceGetSpatialParams(source)->effects & (1 << EFFECT_ATTENUATION)) ? ovrAudioSourceAttenuationMode_InverseSquare : ovrAudioSourceAttenuationMode_None, 1.0f);
     }
   }
 
@@ -201,9 +189,7 @@ static uint32_t oculus_apply(Source* source, const float* input, float* output,
     uint32_t outStatus = 0;
     state.sources[idx].usedSourceThisPlayback = true;
 
-    float position[3], orientation[4];
-    lovrSourceGetPose(source, position, orientation);
-
+    const float* position = lovrSourceGetSpatialParams(source)->position;
     ovrAudio_SetAudioSourcePos(state.context, idx, position[0], position[1], position[2]);
 
     ovrAudio_SpatializeMonoSourceInterleaved(state.context, idx, &outStatus, output, input);
@@ -272,16 +258,18 @@ static void oculus_setListenerPose(float position[3], float orientation[4]) {
 
   oculusRecreatePose(&pose, position, orientation);
 
-  ma_mutex_lock(&state.poseLock); // Do nothing inside lock but make a copy of the pose
-  memcpy(&state.pose, &pose, sizeof(state.pose));
+  memcpy(&state.pose, &pose, sizeof(state.pose)); // Called on the mixer thread
   state.poseUpdated = true;
-  ma_mutex_unlock(&state.poseLock);
 }
 
 bool oculus_setGeometry(float* vertices, uint32_t* indices, uint32_t vertexCount, uint32_t indexCount, AudioMaterial material) {
   return false;
 }
 
+static void oculus_reserveVoices(uint32_t count) {
+  // Oculus Audio allocates every source up front in ovrAudio_CreateContext
+}
+
 static void oculus_sourceCreate(Source* source) {
   intptr_t* spatializerMemo = lovrSourceGetSpatializerMemoField(source);
   *spatializerMemo = -1;
@@ -301,6 +289,7 @@ Spatializer oculusSpatializer = {
   .tail = oculus_tail,
   .setListenerPose = oculus_setListenerPose,
   .setGeometry = oculus_setGeometry,
+  .reserveVoices = oculus_reserveVoices,
   .sourceCreate = oculus_sourceCreate,
   .sourceDestroy = oculus_sourceDestroy, // Need noop
   .name = "oculus"
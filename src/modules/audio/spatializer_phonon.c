@@ -190,6 +190,7 @@ uint32_t phonon_apply(Source* source, const float* input, float* output, uint32_
   IPLAudioBuffer out = { .format = STEREO, .numSamples = frames, .interleavedBuffer = output };
 
   uint32_t index = lovrSourceGetIndex(source);
+  SpatialParams* params = lovrSourceGetSpatialParams(source);
 
   float x[3], y[3], z[3];
   vec3_set(y, 0.f, 1.f, 0.f);
@@ -202,7 +203,8 @@ uint32_t phonon_apply(Source* source, const float* input, float* output, uint32_
 
   // TODO maybe this should use a matrix
   float position[3], orientation[4];
-  lovrSourceGetPose(source, position, orientation);
+  vec3_init(position, params->position);
+  quat_init(orientation, params->orientation);
   vec3_set(x, 1.f, 0.f, 0.f);
   vec3_set(y, 0.f, 1.f, 0.f);
   vec3_set(z, 0.f, 0.f, -1.f);
@@ -210,8 +212,8 @@ uint32_t phonon_apply(Source* source, const float* input, float* output, uint32_
   quat_rotate(orientation, y);
   quat_rotate(orientation, z);
 
-  float weight, power;
-  lovrSourceGetDirectivity(source, &weight, &power);
+  float weight = params->dipoleWeight;
+  float power = params->dipolePower;
 
   IPLSource iplSource = {
     .position = (IPLVector3) { position[0], position[1], position[2] },
@@ -230,10 +232,10 @@ uint32_t phonon_apply(Source* source, const float* input, float* output, uint32_
   float radius = 0.f;
   IPLint32 rays = 0;
 
-  if (state.mesh && lovrSourceIsEffectEnabled(source, EFFECT_OCCLUSION)) {
-    bool transmission = lovrSourceIsEffectEnabled(source, EFFECT_TRANSMISSION);
+  if (state.mesh && (params->effects & (1 << EFFECT_OCCLUSION))) {
+    bool transmission = (params->effects & (1 << EFFECT_TRANSMISSION));
     occlusion = transmission ? IPL_DIRECTOCCLUSION_TRANSMISSIONBYFREQUENCY : IPL_DIRECTOCCLUSION_NOTRANSMISSION;
-    radius = lovrSourceGetRadius(source);
+    radius = params->radius;
 
     if (radius > 0.f) {
       volumetric = IPL_DIRECTOCCLUSION_VOLUMETRIC;
@@ -244,8 +246,8 @@ uint32_t phonon_apply(Source* source, const float* input, float* output, uint32_
   IPLDirectSoundPath path = phonon_iplGetDirectSoundPath(state.environment, listener, forward, up, iplSource, radius, rays, occlusion, volumetric);
 
   IPLDirectSoundEffectOptions options = {
-    .applyDistanceAttenuation = lovrSourceIsEffectEnabled(source, EFFECT_ATTENUATION) ? IPL_TRUE : IPL_FALSE,
-    .applyAirAbsorption = lovrSourceIsEffectEnabled(source, EFFECT_ABSORPTION) ? IPL_TRUE : IPL_FALSE,
+    .applyDistanceAttenuation = (params->effects & (1 << EFFECT_ATTENUATION)) ? IPL_TRUE : IPL_FALSE,
+    .applyAirAbsorption = (params->effects & (1 << EFFECT_ABSORPTION)) ? IPL_TRUE : IPL_FALSE,
     .applyDirectivity = weight > 0.f && power > 0.f ? IPL_TRUE : IPL_FALSE,
     .directOcclusionMode = occlusion
   };
@@ -256,7 +258,7 @@ uint32_t phonon_apply(Source* source, const float* input, float* output, uint32_
   IPLHrtfInterpolation interpolation = IPL_HRTFINTERPOLATION_NEAREST;
   phonon_iplApplyBinauralEffect(state.binauralEffect[index], state.binauralRenderer, tmp, path.direction, interpolation, blend, out);
 
-  if (state.mesh && lovrSourceIsEffectEnabled(source, EFFECT_REVERB)) {
+  if (state.mesh && (params->effects & (1 << EFFECT_REVERB))) {
     phonon_iplSetDryAudioForConvolutionEffect(state.convolutionEffect[index], iplSource, in);
   }
 
@@ -368,21 +370,25 @@ fail:
   return false;
 }
 
-void phonon_sourceCreate(Source* source) {
-  uint32_t index = lovrSourceGetIndex(source);
+void phonon_reserveVoices(uint32_t count) {
+  for (uint32_t index = 0; index < count; index++) {
+    if (!state.binauralEffect[index]) {
+      phonon_iplCreateBinauralEffect(state.binauralRenderer, MONO, STEREO, &state.binauralEffect[index]);
+    }
 
-  if (!state.binauralEffect[index]) {
-    phonon_iplCreateBinauralEffect(state.binauralRenderer, MONO, STEREO, &state.binauralEffect[index]);
-  }
+    if (!state.directSoundEffect[index]) {
+      phonon_iplCreateDirectSoundEffect(MONO, MONO, state.renderingSettings, &state.directSoundEffect[index]);
+    }
 
-  if (!state.directSoundEffect[index]) {
-    phonon_iplCreateDirectSoundEffect(MONO, MONO, state.renderingSettings, &state.directSoundEffect[index]);
+    if (!state.convolutionEffect[index]) {
+      IPLBakedDataIdentifier id = { 0 };
+      phonon_iplCreateConvolutionEffect(state.environmentalRenderer, id, IPL_SIMTYPE_REALTIME, MONO, AMBISONIC, &state.convolutionEffect[index]);
+    }
   }
+}
 
-  if (!state.convolutionEffect[index]) {
-    IPLBakedDataIdentifier id = { 0 };
-    phonon_iplCreateConvolutionEffect(state.environmentalRenderer, id, IPL_SIMTYPE_REALTIME, MONO, AMBISONIC, &state.convolutionEffect[index]);
-  }
+void phonon_sourceCreate(Source* source) {
+  // Effects are created in phonon_reserveVoices and flushed when a voice is released
 }
 
 void phonon_sourceDestroy(Source* source) {
@@ -399,6 +405,7 @@ Spatializer phononSpatializer = {
   .tail = phonon_tail,
   .setListenerPose = phonon_setListenerPose,
   .setGeometry = phonon_setGeometry,
+  .reserveVoices = phonon_reserveVoices,
   .sourceCreate = phonon_sourceCreate,
   .sourceDestroy = phonon_sourceDestroy,
   .name = "phonon"
@@ -1,4 +1,5 @@
 #include "spatializer.h"
+#include "mix.h"
 #include "core/maf.h"
 #include "util.h"
 #include <math.h>
@@ -18,14 +19,17 @@ static void simple_destroy(void) {
 }
 
 static uint32_t simple_apply(Source* source, const float* input, float* output, uint32_t frames, uint32_t _frames) {
+  SpatialParams* params = lovrSourceGetSpatialParams(source);
+
   float sourcePos[3], sourceOrientation[4];
-  lovrSourceGetPose(source, sourcePos, sourceOrientation);
+  vec3_init(sourcePos, params->position);
+  quat_init(sourceOrientation, params->orientation);
 
   float listenerPos[3];
   mat4_getPosition(state.listener, listenerPos);
 
   float target[2] = { 1.f, 1.f };
-  if (lovrSourceIsEffectEnabled(source, EFFECT_SPATIALIZATION)) {
+  if (params->effects & (1 << EFFECT_SPATIALIZATION)) {
     float leftEar[3] = { -0.1f, 0.0f, 0.0f };
     float rightEar[3] = { 0.1f, 0.0f, 0.0f };
     mat4_mulPoint(state.listener, leftEar);
@@ -36,8 +40,8 @@ static uint32_t simple_apply(Source* source, const float* input, float* output,
     target[1] = .5f + (ldistance - rdistance) * 2.5f;
   }
 
-  float weight, power;
-  lovrSourceGetDirectivity(source, &weight, &power);
+  float weight = params->dipoleWeight;
+  float power = params->dipolePower;
   if (weight > 0.f && power > 0.f) {
     float sourceDirection[3];
     float sourceToListener[3];
@@ -49,7 +53,7 @@ static uint32_t simple_apply(Source* source, const float* input, float* output,
     target[1] *= factor;
   }
 
-  if (lovrSourceIsEffectEnabled(source, EFFECT_ATTENUATION)) {
+  if (params->effects & (1 << EFFECT_ATTENUATION)) {
     float distance = vec3_distance(sourcePos, listenerPos);
     float attenuation = 1.f / MAX(distance, 1.f);
     target[0] *= attenuation;
@@ -63,22 +67,28 @@ static uint32_t simple_apply(Source* source, const float* input, float* output,
   float lerpFrames = lovrAudioGetSampleRate() * lerpDuration;
   float lerpRate = 1.f / lerpFrames;
 
+  uint32_t lerpCount[2];
   for (uint32_t c = 0; c < 2; c++) {
     float sign = target[c] > gain[c] ? 1.f : -1.f;
 
-    uint32_t lerpCount = fabsf(target[c] - gain[c]) / lerpRate;
-    lerpCount = MIN(lerpCount, frames);
+    lerpCount[c] = fabsf(target[c] - gain[c]) / lerpRate;
+    lerpCount[c] = MIN(lerpCount[c], frames);
 
-    for (uint32_t i = 0; i < lerpCount; i++) {
+    for (uint32_t i = 0; i < lerpCount[c]; i++) {
       output[i * 2 + c] = input[i] * gain[c];
       gain[c] += lerpRate * sign;
     }
+  }
 
-    for (uint32_t i = lerpCount; i < frames; i++) {
+  // Once both channels have settled, the rest of the buffer uses constant gains
+  uint32_t settled = MAX(lerpCount[0], lerpCount[1]);
+  for (uint32_t c = 0; c < 2; c++) {
+    for (uint32_t i = lerpCount[c]; i < settled; i++) {
       output[i * 2 + c] = input[i] * gain[c];
     }
   }
 
+  mix_spread(output + settled * 2, input + settled, gain[0], gain[1], frames - settled);
   return frames;
 }
 
@@ -96,6 +106,10 @@ static bool simple_setGeometry(float* vertices, uint32_t* indices, uint32_t vert
   return false;
 }
 
+static void simple_reserveVoices(uint32_t count) {
+  //
+}
+
 static void simple_sourceCreate(Source* source) {
   uint32_t index = lovrSourceGetIndex(source);
   state.gain[index][0] = 0.f;
@@ -113,7 +127,9 @@ Spatializer simpleSpatializer = {
   .tail = simple_tail,
   .setListenerPose = simple_setListenerPose,
   .setGeometry = simple_setGeometry,
+  .reserveVoices = simple_reserveVoices,
   .sourceCreate = simple_sourceCreate,
   .sourceDestroy = simple_sourceDestroy,
-  .name = "simple"
+  .name = "simple",
+  .parallel = true
 };
@@ -633,3 +633,16 @@ uint32_t lovrRasterizerGetAtlasGlyph(Rasterizer* rasterizer, size_t index, uint1
 
   return glyph->codepoint;
 }
+
+uint64_t lovrRasterizerGetHash(Rasterizer* rasterizer) {
+  uint64_t hash[2];
+
+  if (rasterizer->blob) {
+    hash[0] = hash64(rasterizer->blob->data, rasterizer->blob->size);
+  } else {
+    hash[0] = hash64(etc_VarelaRound_ttf, etc_VarelaRound_ttf_len);
+  }
+
+  hash[1] = hash64(&rasterizer->size, sizeof(rasterizer->size));
+  return hash64(hash, sizeof(hash));
+}
@@ -36,3 +36,4 @@ bool lovrRasterizerGetCurves(Rasterizer* rasterizer, uint32_t codepoint, void (*
 bool lovrRasterizerGetPixels(Rasterizer* rasterizer, uint32_t codepoint, float* pixels, uint32_t width, uint32_t height, double spread);
 struct Image* lovrRasterizerGetAtlas(Rasterizer* rasterizer);
 uint32_t lovrRasterizerGetAtlasGlyph(Rasterizer* rasterizer, size_t index, uint16_t* x, uint16_t* y);
+uint64_t lovrRasterizerGetHash(Rasterizer* rasterizer);
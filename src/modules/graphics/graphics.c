@@ -28,6 +28,7 @@
 
 #define MAX_PIPELINES 8192
 #define MAX_TALLIES 255
+#define MAX_TIMERS 64
 #define TRANSFORM_STACK_SIZE 16
 #define PIPELINE_STACK_SIZE 8
 #define MAX_SHADER_RESOURCES 32
@@ -190,12 +191,25 @@ struct Material {
 };
 
 typedef struct {
+  uint32_t codepoint;
   float advance;
   uint16_t x, y;
   uint16_t uv[4];
   float box[4];
 } Glyph;
 
+#define TEXT_CACHE_SIZE 64
+
+typedef struct {
+  uint64_t hash;
+  uint32_t tick;
+  uint32_t glyphCount;
+  uint32_t lineCount;
+  GlyphVertex* vertices;
+  char* key; // TextKey and the strings the vertices were built from
+  size_t keySize;
+} CachedText;
+
 struct Font {
   uint32_t ref;
   FontInfo info;
@@ -211,6 +225,9 @@ struct Font {
   uint32_t rowHeight;
   uint32_t atlasX;
   uint32_t atlasY;
+  uint32_t version;
+  uint32_t textTick;
+  CachedText textCache[TEXT_CACHE_SIZE];
 };
 
 struct Mesh {
@@ -315,6 +332,7 @@ typedef enum {
 
 typedef struct {
   Pass* pass;
+  uint32_t zone;
   double cpuTime;
 } TimingInfo;
 
@@ -336,6 +354,9 @@ struct Readback {
     struct {
       TimingInfo* times;
       uint32_t count;
+      GraphicsTiming* zones;
+      uint32_t* slots;
+      uint32_t zoneCount;
     };
   };
 };
@@ -518,6 +539,34 @@ typedef struct {
   Buffer* buffer;
 } Tally;
 
+typedef struct {
+  Buffer* buffer;
+  uint32_t header;
+  uint32_t texels;
+  uint32_t size[2]; // Of the depth texture
+  uint32_t levels;
+  float viewProjection[16];
+} DepthPyramid;
+
+typedef struct {
+  const char* label;
+  uint32_t parent;
+  uint32_t start;
+  uint32_t end;
+  double cpuTime;
+} Timer;
+
+typedef struct {
+  Timer* list;
+  uint16_t* events;
+  uint32_t count;
+  uint32_t eventCount;
+  uint32_t active;
+  uint32_t base;
+  uint32_t stride;
+  uint32_t cursor;
+} Timers;
+
 struct Pass {
   uint32_t ref;
   uint32_t flags;
@@ -549,6 +598,8 @@ struct Pass {
   uint32_t drawCapacity;
   Draw* draws;
   Tally tally;
+  Timers timers;
+  DepthPyramid pyramid;
   PassStats stats;
   char* label;
 };
@@ -582,6 +633,14 @@ static struct {
   gpu_barrier transferBarrier;
   gpu_tally* timestamps;
   uint32_t timestampCount;
+  arr_t(GraphicsTiming) timings;
+  arr_t(void*) timingBlocks;
+  uint32_t timingTick;
+#ifdef LOVR_PROFILE
+  uint64_t gpuTimestamp;
+  uint16_t gpuQuery;
+  bool gpuContext;
+#endif
   uint32_t tick;
   float background[4];
   TextureFormat depthFormat;
@@ -692,6 +751,8 @@ bool lovrGraphicsInit(GraphicsConfig* config) {
 
   state.config = *config;
   state.timingEnabled = config->debug;
+  arr_init(&state.timings);
+  arr_init(&state.timingBlocks);
 
   state.pipelines = lovrMalloc(MAX_PIPELINES * gpu_sizeof_pipeline());
   map_init(&state.pipelineLookup, 64);
@@ -889,6 +950,11 @@ void lovrGraphicsDestroy(void) {
   }
   if (state.timestamps) gpu_tally_destroy(state.timestamps);
   lovrFree(state.timestamps);
+  for (size_t i = 0; i < state.timingBlocks.length; i++) {
+    lovrFree(state.timingBlocks.data[i]);
+  }
+  arr_free(&state.timingBlocks);
+  arr_free(&state.timings);
   lovrRelease(state.window, lovrTextureDestroy);
   lovrRelease(state.windowPass, lovrPassDestroy);
   lovrRelease(state.defaultFont, lovrFontDestroy);
@@ -1054,6 +1120,39 @@ void lovrGraphicsSetTimingEnabled(bool enable) {
   state.timingEnabled = enable;
 }
 
+const GraphicsTiming* lovrGraphicsGetTimings(uint32_t* count) {
+  *count = (uint32_t) state.timings.length;
+  return state.timings.data;
+}
+
+// Writes timestamps for all of the timer events that happened before a draw.  Timestamps written
+// inside a multiview render pass use one query per view, so outside the render pass the remaining
+// queries are filled in manually.
+static void markTimers(Pass* pass, gpu_stream* stream, uint32_t drawIndex, bool inside) {
+  Timers* timers = &pass->timers;
+
+  if (!state.timingEnabled) {
+    return;
+  }
+
+  while (timers->cursor < timers->eventCount) {
+    uint16_t event = timers->events[timers->cursor];
+    Timer* timer = &timers->list[event >> 1];
+
+    if ((event & 1 ? timer->end : timer->start) > drawIndex) {
+      break;
+    }
+
+    uint32_t slot = timers->base + event * timers->stride;
+
+    for (uint32_t i = 0; i < (inside ? 1 : timers->stride); i++) {
+      gpu_tally_mark(stream, state.timestamps, slot + i);
+    }
+
+    timers->cursor++;
+  }
+}
+
 static bool recordComputePass(Pass* pass, gpu_stream* stream) {
   if (pass->computeCount == 0) {
     return true;
@@ -1336,6 +1435,7 @@ static bool recordRenderPass(Pass* pass, gpu_stream* stream) {
 
   if (activeDrawCount == 0) {
     gpu_render_begin(stream, &pass->target);
+    markTimers(pass, stream, ~0u, true);
     gpu_render_end(stream, &pass->target);
     return true;
   }
@@ -1504,6 +1604,8 @@ static bool recordRenderPass(Pass* pass, gpu_stream* stream) {
   for (uint32_t i = 0; i < activeDrawCount; i++) {
     Draw* draw = &pass->draws[activeDraws[i]];
 
+    markTimers(pass, stream, activeDraws[i], true);
+
     if (pass->tally.buffer && draw->tally != tally) {
       if (tally != 0xff) gpu_tally_finish(stream, pass->tally.gpu, tally * pass->views);
       if (draw->tally != 0xff) gpu_tally_begin(stream, pass->tally.gpu, draw->tally * pass->views);
@@ -1600,6 +1702,8 @@ static bool recordRenderPass(Pass* pass, gpu_stream* stream) {
     gpu_tally_finish(stream, pass->tally.gpu, tally * pass->views);
   }
 
+  markTimers(pass, stream, ~0u, true);
+
   gpu_render_end(stream, &pass->target);
 
   // Automipmap
@@ -1796,16 +1900,74 @@ bool lovrGraphicsSubmit(Pass** passes, uint32_t count) {
   }
 
   TimingInfo* times = NULL;
+  GraphicsTiming* zones = NULL;
+  uint32_t* slots = NULL;
+  uint32_t zoneCount = 0;
+  uint32_t timestampCount = 2 * count;
 
   if (state.timingEnabled && count > 0) {
     times = lovrMalloc(count * sizeof(TimingInfo));
 
+    // Each pass gets a zone, followed by a zone for each of its timers
+    size_t labelSize = 0;
     for (uint32_t i = 0; i < count; i++) {
-      times[i].pass = passes[i];
-      lovrRetain(passes[i]);
-    }
+      Timers* timers = &passes[i]->timers;
+
+      while (timers->active != ~0u) {
+        lovrPassEndTimer(passes[i]);
+      }
 
-    uint32_t timestampCount = 2 * count;
+      timers->base = timestampCount;
+      timers->stride = MAX(passes[i]->views, 1);
+      timers->cursor = 0;
+      timestampCount += 2 * timers->count * timers->stride;
+
+      labelSize += passes[i]->label ? strlen(passes[i]->label) + 1 : 1;
+      for (uint32_t j = 0; j < timers->count; j++) {
+        labelSize += strlen(timers->list[j].label) + 1;
+      }
+
+      zoneCount += 1 + timers->count;
+    }
+
+    // Zones are stored in one block along with their timestamp slots and labels, so they can
+    // outlive the Pass (which is probably going to be reset before the timestamps are ready)
+    zones = lovrMalloc(zoneCount * (sizeof(GraphicsTiming) + 2 * sizeof(uint32_t)) + labelSize);
+    slots = (uint32_t*) (zones + zoneCount);
+    char* label = (char*) (slots + 2 * zoneCount);
+
+    for (uint32_t i = 0, z = 0; i < count; i++) {
+      Pass* pass = passes[i];
+      Timers* timers = &pass->timers;
+
+      times[i].pass = pass;
+      times[i].zone = z;
+      lovrRetain(pass);
+
+      size_t length = pass->label ? strlen(pass->label) : 0;
+      zones[z].label = memcpy(label, pass->label ? pass->label : "", length + 1);
+      zones[z].parent = ~0u;
+      zones[z].cpuTime = 0.;
+      zones[z].gpuTime = 0.;
+      slots[2 * z + 0] = 2 * i + 0;
+      slots[2 * z + 1] = 2 * i + 1;
+      label += length + 1;
+
+      for (uint32_t j = 0; j < timers->count; j++) {
+        Timer* timer = &timers->list[j];
+        GraphicsTiming* zone = &zones[z + 1 + j];
+        length = strlen(timer->label);
+        zone->label = memcpy(label, timer->label, length + 1);
+        zone->parent = timer->parent == ~0u ? z : z + 1 + timer->parent;
+        zone->cpuTime = timer->cpuTime;
+        zone->gpuTime = 0.;
+        slots[2 * (z + 1 + j) + 0] = timers->base + (2 * j + 0) * timers->stride;
+        slots[2 * (z + 1 + j) + 1] = timers->base + (2 * j + 1) * timers->stride;
+        label += length + 1;
+      }
+
+      z += 1 + timers->count;
+    }
 
     if (timestampCount > state.timestampCount) {
       if (state.timestamps) {
@@ -1848,6 +2010,9 @@ bool lovrGraphicsSubmit(Pass** passes, uint32_t count) {
       goto fail;
     }
 
+    // Timers in passes without a render pass still need their timestamps written
+    markTimers(passes[i], stream, ~0u, false);
+
     gpu_sync(stream, &renderBarriers[i], 1);
 
     if (state.timingEnabled) {
@@ -1864,11 +2029,15 @@ bool lovrGraphicsSubmit(Pass** passes, uint32_t count) {
 
     // Timestamp Readback
     if (state.timingEnabled) {
-      BufferView view = getBuffer(GPU_BUFFER_DOWNLOAD, 2 * count * sizeof(uint32_t), 4);
+      BufferView view = getBuffer(GPU_BUFFER_DOWNLOAD, timestampCount * sizeof(uint32_t), 4);
       if (!view.buffer) goto fail;
-      gpu_copy_tally_buffer(stream, state.timestamps, view.buffer, 0, view.offset, 2 * count);
+      gpu_copy_tally_buffer(stream, state.timestamps, view.buffer, 0, view.offset, timestampCount);
       Readback* readback = lovrReadbackCreateTimestamp(times, count, view);
       if (!readback) goto fail;
+      readback->zones = zones;
+      readback->slots = slots;
+      readback->zoneCount = zoneCount;
+      zones = NULL;
       lovrRelease(readback, lovrReadbackDestroy); // It gets freed when it completes
     }
 
@@ -1973,6 +2142,7 @@ bool lovrGraphicsSubmit(Pass** passes, uint32_t count) {
   state.stream = NULL;
   return true;
 fail:
+  lovrFree(zones);
   stackPop(&thread.stack, stack);
   atomic_store(&state.newPipelines, NULL);
   return false;
@@ -3277,6 +3447,15 @@ ShaderSource lovrGraphicsGetDefaultShaderSource(DefaultShader type, ShaderStage
     },
     [SHADER_TALLY_MERGE] = {
       [STAGE_COMPUTE] = { STAGE_COMPUTE, lovr_shader_tallymerge_comp, sizeof(lovr_shader_tallymerge_comp) }
+    },
+    [SHADER_PYRAMID] = {
+      [STAGE_COMPUTE] = { STAGE_COMPUTE, lovr_shader_pyramid_comp, sizeof(lovr_shader_pyramid_comp) }
+    },
+    [SHADER_CULL] = {
+      [STAGE_COMPUTE] = { STAGE_COMPUTE, lovr_shader_cull_comp, sizeof(lovr_shader_cull_comp) }
+    },
+    [SHADER_FRUSTUM] = {
+      [STAGE_COMPUTE] = { STAGE_COMPUTE, lovr_shader_frustum_comp, sizeof(lovr_shader_frustum_comp) }
     }
   };
 
@@ -3287,12 +3466,13 @@ Shader* lovrGraphicsGetDefaultShader(DefaultShader type) {
   Shader* shader = atomic_load(&state.defaultShaders[type]);
 
   if (!shader) {
-    if (type == SHADER_ANIMATOR || type == SHADER_BLENDER || type == SHADER_TALLY_MERGE) {
+    // Default compute shaders are the ones with a compute stage in the source table
+    ShaderSource compute = lovrGraphicsGetDefaultShaderSource(type, STAGE_COMPUTE);
+
+    if (compute.code) {
       shader = lovrShaderCreate(&(ShaderInfo) {
         .type = SHADER_COMPUTE,
-        .stages = (ShaderSource[1]) {
-          lovrGraphicsGetDefaultShaderSource(type, STAGE_COMPUTE)
-        },
+        .stages = &compute,
         .stageCount = 1,
         .flags = &(ShaderFlag) { NULL, 0, state.device.subgroupSize },
         .flagCount = 1,
@@ -4059,6 +4239,7 @@ Font* lovrFontCreate(const FontInfo* info) {
       Glyph* glyph = &font->glyphs.data[font->glyphs.length++];
       uint32_t codepoint = lovrRasterizerGetAtlasGlyph(info->rasterizer, i, &glyph->x, &glyph->y);
       map_set(&font->glyphLookup, hash64(&codepoint, 4), font->glyphs.length - 1);
+      glyph->codepoint = codepoint;
 
       lovrRasterizerGetGlyphBoundingBox(info->rasterizer, codepoint, glyph->box);
 
@@ -4087,8 +4268,19 @@ Font* lovrFontCreate(const FontInfo* info) {
   return font;
 }
 
+static void lovrFontClearTextCache(Font* font) {
+  for (uint32_t i = 0; i < TEXT_CACHE_SIZE; i++) {
+    lovrFree(font->textCache[i].vertices);
+    lovrFree(font->textCache[i].key);
+  }
+
+  memset(font->textCache, 0, sizeof(font->textCache));
+  font->version++;
+}
+
 void lovrFontDestroy(void* ref) {
   Font* font = ref;
+  lovrFontClearTextCache(font);
   lovrRelease(font->info.rasterizer, lovrRasterizerDestroy);
   lovrRelease(font->material, lovrMaterialDestroy);
   lovrRelease(font->atlas, lovrTextureDestroy);
@@ -4117,7 +4309,8 @@ void lovrFontSetLineSpacing(Font* font, float spacing) {
   font->lineSpacing = spacing;
 }
 
-static Glyph* lovrFontGetGlyph(Font* font, uint32_t codepoint, bool* resized) {
+// If pixels is NULL the glyph is rasterized here, otherwise it contains the already rasterized glyph
+static Glyph* lovrFontGetGlyph(Font* font, uint32_t codepoint, float* pixels, bool* resized) {
   uint64_t hash = hash64(&codepoint, 4);
   uint64_t index = map_get(&font->glyphLookup, hash);
 
@@ -4128,6 +4321,7 @@ static Glyph* lovrFontGetGlyph(Font* font, uint32_t codepoint, bool* resized) {
 
   arr_expand(&font->glyphs, 1);
   Glyph* glyph = &font->glyphs.data[font->glyphs.length];
+  glyph->codepoint = codepoint;
   glyph->advance = lovrRasterizerGetAdvance(font->info.rasterizer, codepoint);
 
   if (lovrRasterizerIsGlyphEmpty(font->info.rasterizer, codepoint)) {
@@ -4240,6 +4434,8 @@ static Glyph* lovrFontGetGlyph(Font* font, uint32_t codepoint, bool* resized) {
       }
     }
 
+    // Glyph uvs changed, so any cached vertices are stale
+    lovrFontClearTextCache(font);
     if (resized) *resized = true;
     wrap = false;
   }
@@ -4260,8 +4456,10 @@ static Glyph* lovrFontGetGlyph(Font* font, uint32_t codepoint, bool* resized) {
   font->rowHeight = MAX(font->rowHeight, pixelHeight);
 
   size_t stack = stackPush(&thread.stack);
-  float* pixels = allocate(&thread.stack, pixelWidth * pixelHeight * 4 * sizeof(float));
-  lovrRasterizerGetPixels(font->info.rasterizer, codepoint, pixels, pixelWidth, pixelHeight, font->info.spread);
+  if (!pixels) {
+    pixels = allocate(&thread.stack, pixelWidth * pixelHeight * 4 * sizeof(float));
+    lovrRasterizerGetPixels(font->info.rasterizer, codepoint, pixels, pixelWidth, pixelHeight, font->info.spread);
+  }
   float* src = pixels;
   uint8_t* dst = bufferView.pointer;
   for (uint32_t y = 0; y < pixelHeight; y++) {
@@ -4413,7 +4611,7 @@ static void aline(GlyphVertex* vertices, uint32_t head, uint32_t tail, float wid
   }
 }
 
-bool lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, GlyphVertex* vertices, uint32_t* glyphCount, uint32_t* lineCount, Material** material, bool flip) {
+static bool lovrFontLayout(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, GlyphVertex* vertices, uint32_t* glyphCount, uint32_t* lineCount, bool flip) {
   uint32_t vertexCount = 0;
   uint32_t lineStart = 0;
   uint32_t wordStart = 0;
@@ -4468,14 +4666,14 @@ bool lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, flo
       }
 
       bool resized = false;
-      Glyph* glyph = lovrFontGetGlyph(font, codepoint, &resized);
+      Glyph* glyph = lovrFontGetGlyph(font, codepoint, NULL, &resized);
 
       if (!glyph) {
         return false;
       }
 
       if (resized) {
-        return lovrFontGetVertices(font, strings, count, wrap, halign, valign, vertices, glyphCount, lineCount, material, flip);
+        return lovrFontLayout(font, strings, count, wrap, halign, valign, vertices, glyphCount, lineCount, flip);
       }
 
       // Keming
@@ -4525,8 +4723,415 @@ bool lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, flo
 
   // Align last line
   aline(vertices, lineStart, vertexCount, x, halign);
+  return true;
+}
+
+// Layout parameters, followed in a cache key by each string's length, color, and bytes
+typedef struct {
+  float wrap;
+  float lineSpacing;
+  uint32_t halign;
+  uint32_t valign;
+  uint32_t flip;
+  uint32_t count;
+} TextKey;
+
+typedef struct {
+  size_t length;
+  float color[4];
+} TextKeyString;
+
+static uint64_t lovrFontHashText(TextKey* params, ColoredString* strings) {
+  struct {
+    uint64_t hash;
+    uint64_t string;
+    float color[4];
+  } chain;
+
+  chain.hash = hash64(params, sizeof(*params));
+
+  for (uint32_t i = 0; i < params->count; i++) {
+    chain.string = hash64(strings[i].string, strings[i].length);
+    memcpy(chain.color, strings[i].color, sizeof(chain.color));
+    chain.hash = hash64(&chain, sizeof(chain));
+  }
+
+  return chain.hash;
+}
+
+static char* lovrFontCreateTextKey(TextKey* params, ColoredString* strings, size_t* size) {
+  *size = sizeof(TextKey);
+  for (uint32_t i = 0; i < params->count; i++) {
+    *size += sizeof(TextKeyString) + strings[i].length;
+  }
+
+  char* key = lovrMalloc(*size);
+  char* cursor = key + sizeof(TextKey);
+  memcpy(key, params, sizeof(TextKey));
+
+  for (uint32_t i = 0; i < params->count; i++) {
+    TextKeyString header = { .length = strings[i].length };
+    memcpy(header.color, strings[i].color, sizeof(header.color));
+    memcpy(cursor, &header, sizeof(header));
+    memcpy(cursor + sizeof(header), strings[i].string, strings[i].length);
+    cursor += sizeof(header) + strings[i].length;
+  }
+
+  return key;
+}
+
+// A hash match only counts if the text and layout parameters match the cached key exactly
+static bool lovrFontMatchText(CachedText* entry, TextKey* params, ColoredString* strings) {
+  if (!entry->key || memcmp(entry->key, params, sizeof(TextKey))) {
+    return false;
+  }
+
+  const char* cursor = entry->key + sizeof(TextKey);
+  const char* end = entry->key + entry->keySize;
+
+  for (uint32_t i = 0; i < params->count; i++) {
+    TextKeyString header;
+    memcpy(&header, cursor, sizeof(header));
+    cursor += sizeof(header);
+
+    if (
+      header.length != strings[i].length ||
+      memcmp(header.color, strings[i].color, sizeof(header.color)) ||
+      memcmp(cursor, strings[i].string, strings[i].length)
+    ) {
+      return false;
+    }
+
+    cursor += header.length;
+  }
+
+  return cursor == end;
+}
+
+// Layouts are cached by the hash of the text and its layout parameters, and a hit is checked
+// against the full key.  Text is only cached once it has been seen twice, so strings that change
+// every frame don't churn the cache.
+bool lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, GlyphVertex* vertices, uint32_t* glyphCount, uint32_t* lineCount, Material** material, bool flip) {
+  TextKey params = { wrap, font->lineSpacing, halign, valign, flip, count };
+  uint64_t hash = lovrFontHashText(&params, strings);
+  CachedText* entry = NULL;
+  CachedText* oldest = &font->textCache[0];
+  font->textTick++;
+
+  for (uint32_t i = 0; i < TEXT_CACHE_SIZE; i++) {
+    if (font->textCache[i].hash == hash) {
+      entry = &font->textCache[i];
+      break;
+    } else if (font->textCache[i].tick < oldest->tick) {
+      oldest = &font->textCache[i];
+    }
+  }
+
+  uint32_t version = font->version;
+
+  // On a collision, lay out the text without touching the entry
+  bool collision = entry && entry->vertices && !lovrFontMatchText(entry, &params, strings);
+
+  if (entry && entry->vertices && !collision) {
+    memcpy(vertices, entry->vertices, entry->glyphCount * 4 * sizeof(GlyphVertex));
+    *glyphCount = entry->glyphCount;
+    *lineCount = entry->lineCount;
+    *material = font->material;
+    entry->tick = font->textTick;
+    return true;
+  }
+
+  if (!lovrFontLayout(font, strings, count, wrap, halign, valign, vertices, glyphCount, lineCount, flip)) {
+    return false;
+  }
 
   *material = font->material;
+
+  // Adding glyphs can resize the atlas, which clears the cache
+  if (font->version != version || collision) {
+    return true;
+  }
+
+  if (entry) {
+    entry->vertices = lovrMalloc(MAX(*glyphCount, 1) * 4 * sizeof(GlyphVertex));
+    memcpy(entry->vertices, vertices, *glyphCount * 4 * sizeof(GlyphVertex));
+    entry->key = lovrFontCreateTextKey(&params, strings, &entry->keySize);
+    entry->glyphCount = *glyphCount;
+    entry->lineCount = *lineCount;
+    entry->tick = font->textTick;
+  } else {
+    lovrFree(oldest->vertices);
+    lovrFree(oldest->key);
+    oldest->hash = hash;
+    oldest->tick = font->textTick;
+    oldest->vertices = NULL;
+    oldest->key = NULL;
+    oldest->keySize = 0;
+  }
+
+  return true;
+}
+
+typedef struct {
+  Rasterizer* rasterizer;
+  double spread;
+  uint32_t codepoint;
+  uint32_t width;
+  uint32_t height;
+  float* pixels;
+} GlyphJob;
+
+typedef struct {
+  GlyphJob* glyphs;
+  uint32_t count;
+} GlyphBatch;
+
+static void rasterizeGlyphs(void* arg) {
+  GlyphBatch* batch = arg;
+  for (uint32_t i = 0; i < batch->count; i++) {
+    GlyphJob* glyph = &batch->glyphs[i];
+    lovrRasterizerGetPixels(glyph->rasterizer, glyph->codepoint, glyph->pixels, glyph->width, glyph->height, glyph->spread);
+  }
+}
+
+bool lovrFontPrewarm(Font* font, const uint32_t* codepoints, uint32_t count) {
+  Rasterizer* rasterizer = font->info.rasterizer;
+
+  // BMFont glyphs are all added to the atlas when the Font is created
+  if (lovrRasterizerGetType(rasterizer) != RASTERIZER_TTF) {
+    return true;
+  }
+
+  GlyphJob* glyphs = lovrMalloc(MAX(count, 1) * sizeof(GlyphJob));
+  uint32_t glyphCount = 0;
+  size_t pixelCount = 0;
+
+  map_t pending;
+  map_init(&pending, 0);
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t codepoint = codepoints[i];
+    uint64_t hash = hash64(&codepoint, 4);
+
+    if (map_get(&font->glyphLookup, hash) != MAP_NIL || map_get(&pending, hash) != MAP_NIL) {
+      continue;
+    }
+
+    // Empty glyphs don't need to be rasterized
+    if (lovrRasterizerIsGlyphEmpty(rasterizer, codepoint)) {
+      if (!lovrFontGetGlyph(font, codepoint, NULL, NULL)) {
+        map_free(&pending);
+        lovrFree(glyphs);
+        return false;
+      }
+      continue;
+    }
+
+    float box[4];
+    lovrRasterizerGetGlyphBoundingBox(rasterizer, codepoint, box);
+
+    GlyphJob* glyph = &glyphs[glyphCount];
+    glyph->rasterizer = rasterizer;
+    glyph->spread = font->info.spread;
+    glyph->codepoint = codepoint;
+    glyph->width = 2 * font->padding + (uint32_t) ceilf(box[2] - box[0]);
+    glyph->height = 2 * font->padding + (uint32_t) ceilf(box[3] - box[1]);
+    glyph->pixels = (float*) (uintptr_t) pixelCount; // Offset for now, turned into a pointer below
+    pixelCount += glyph->width * glyph->height * 4;
+    map_set(&pending, hash, glyphCount++);
+  }
+
+  map_free(&pending);
+
+  if (glyphCount == 0) {
+    lovrFree(glyphs);
+    return true;
+  }
+
+  float* pixels = lovrMalloc(pixelCount * sizeof(float));
+
+  for (uint32_t i = 0; i < glyphCount; i++) {
+    glyphs[i].pixels = pixels + (uintptr_t) glyphs[i].pixels;
+  }
+
+  // Rasterize on worker threads, in batches to avoid running out of jobs
+  GlyphBatch batches[32];
+  job* jobs[COUNTOF(batches)];
+  uint32_t batchCount = MIN(glyphCount, COUNTOF(batches));
+  uint32_t batchSize = (glyphCount + batchCount - 1) / batchCount;
+
+  for (uint32_t i = 0; i < batchCount; i++) {
+    uint32_t start = i * batchSize;
+    batches[i].glyphs = glyphs + start;
+    batches[i].count = start < glyphCount ? MIN(batchSize, glyphCount - start) : 0;
+    jobs[i] = job_start(rasterizeGlyphs, &batches[i]);
+  }
+
+  for (uint32_t i = 0; i < batchCount; i++) {
+    job_wait(jobs[i]);
+  }
+
+  // Packing into the atlas and uploading happens on this thread
+  bool success = true;
+  for (uint32_t i = 0; i < glyphCount && success; i++) {
+    success = lovrFontGetGlyph(font, glyphs[i].codepoint, glyphs[i].pixels, NULL);
+  }
+
+  lovrFree(pixels);
+  lovrFree(glyphs);
+  return success;
+}
+
+#define FONT_CACHE_MAGIC 0x43464c4c // LLFC
+#define FONT_CACHE_VERSION 1
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t key;
+  uint32_t glyphCount;
+  uint32_t atlasWidth;
+  uint32_t atlasHeight;
+  uint32_t atlasX;
+  uint32_t atlasY;
+  uint32_t rowHeight;
+} FontCacheHeader;
+
+static uint64_t getFontCacheKey(Font* font) {
+  struct { uint64_t rasterizer; double spread; uint32_t padding; uint32_t glyphSize; } key;
+  memset(&key, 0, sizeof(key));
+  key.rasterizer = lovrRasterizerGetHash(font->info.rasterizer);
+  key.spread = font->info.spread;
+  key.padding = font->padding;
+  key.glyphSize = sizeof(Glyph);
+  return hash64(&key, sizeof(key));
+}
+
+Blob* lovrFontGetCache(Font* font) {
+  lovrCheck(lovrRasterizerGetType(font->info.rasterizer) == RASTERIZER_TTF, "Only TTF fonts can be cached");
+
+  Image* image = NULL;
+
+  if (font->atlas) {
+    image = lovrTextureGetPixels(font->atlas, (uint32_t[4]) { 0 }, (uint32_t[3]) { ~0u, ~0u, 1 });
+    if (!image) return NULL;
+  }
+
+  size_t glyphSize = font->glyphs.length * sizeof(Glyph);
+  size_t pixelSize = image ? font->atlasWidth * font->atlasHeight * 4 : 0;
+  size_t size = sizeof(FontCacheHeader) + glyphSize + pixelSize;
+  char* data = lovrMalloc(size);
+
+  FontCacheHeader* header = (FontCacheHeader*) data;
+  header->magic = FONT_CACHE_MAGIC;
+  header->version = FONT_CACHE_VERSION;
+  header->key = getFontCacheKey(font);
+  header->glyphCount = (uint32_t) font->glyphs.length;
+  header->atlasWidth = image ? font->atlasWidth : 0;
+  header->atlasHeight = image ? font->atlasHeight : 0;
+  header->atlasX = font->atlasX;
+  header->atlasY = font->atlasY;
+  header->rowHeight = font->rowHeight;
+
+  memcpy(data + sizeof(FontCacheHeader), font->glyphs.data, glyphSize);
+
+  if (image) {
+    memcpy(data + sizeof(FontCacheHeader) + glyphSize, lovrImageGetLayerData(image, 0, 0), pixelSize);
+    lovrRelease(image, lovrImageDestroy);
+  }
+
+  return lovrBlobCreate(data, size, "Font Cache");
+}
+
+bool lovrFontLoadCache(Font* font, Blob* blob, bool* loaded) {
+  lovrCheck(lovrRasterizerGetType(font->info.rasterizer) == RASTERIZER_TTF, "Only TTF fonts can be cached");
+
+  *loaded = false;
+
+  // Caches from a different font, a different version, or that are truncated are ignored
+  FontCacheHeader header;
+  if (blob->size < sizeof(header)) return true;
+  memcpy(&header, blob->data, sizeof(header));
+  if (header.magic != FONT_CACHE_MAGIC || header.version != FONT_CACHE_VERSION) return true;
+  if (header.key != getFontCacheKey(font)) return true;
+  if (header.atlasWidth > 65536 || header.atlasHeight > 65536) return true;
+
+  size_t glyphSize = (size_t) header.glyphCount * sizeof(Glyph);
+  size_t pixelSize = (size_t) header.atlasWidth * header.atlasHeight * 4;
+  if (blob->size != sizeof(header) + glyphSize + pixelSize) return true;
+
+  const char* data = (const char*) blob->data + sizeof(header);
+  Texture* atlas = NULL;
+  Material* material = NULL;
+
+  if (pixelSize > 0) {
+    Image* image = lovrImageCreateRaw(header.atlasWidth, header.atlasHeight, FORMAT_RGBA8, false);
+    if (!image) return false;
+
+    memcpy(lovrImageGetLayerData(image, 0, 0), data + glyphSize, pixelSize);
+
+    atlas = lovrTextureCreate(&(TextureInfo) {
+      .type = TEXTURE_2D,
+      .format = FORMAT_RGBA8,
+      .width = header.atlasWidth,
+      .height = header.atlasHeight,
+      .layers = 1,
+      .mipmaps = 1,
+      .samples = 1,
+      .usage = TEXTURE_SAMPLE | TEXTURE_TRANSFER,
+      .imageCount = 1,
+      .images = &image,
+      .label = "Font Atlas"
+    });
+
+    lovrRelease(image, lovrImageDestroy);
+
+    if (!atlas) {
+      return false;
+    }
+
+    material = lovrMaterialCreate(&(MaterialInfo) {
+      .data.color = { 1.f, 1.f, 1.f, 1.f },
+      .data.uvScale = { 1.f, 1.f },
+      .data.sdfRange = { font->info.spread / header.atlasWidth, font->info.spread / header.atlasHeight },
+      .texture = atlas
+    });
+
+    if (!material) {
+      lovrTextureDestroy(atlas);
+      return false;
+    }
+  }
+
+  lovrRelease(font->material, lovrMaterialDestroy);
+  lovrRelease(font->atlas, lovrTextureDestroy);
+  font->material = material;
+  font->atlas = atlas;
+
+  // An empty atlas keeps the initial size computed when the Font was created
+  if (atlas) {
+    font->atlasWidth = header.atlasWidth;
+    font->atlasHeight = header.atlasHeight;
+  }
+
+  font->atlasX = header.atlasX;
+  font->atlasY = header.atlasY;
+  font->rowHeight = header.rowHeight;
+  lovrFontClearTextCache(font);
+
+  arr_clear(&font->glyphs);
+  arr_expand(&font->glyphs, header.glyphCount);
+  memcpy(font->glyphs.data, data, glyphSize);
+  font->glyphs.length = header.glyphCount;
+
+  map_free(&font->glyphLookup);
+  map_init(&font->glyphLookup, header.glyphCount);
+  for (uint32_t i = 0; i < header.glyphCount; i++) {
+    uint32_t codepoint = font->glyphs.data[i].codepoint;
+    map_set(&font->glyphLookup, hash64(&codepoint, 4), i);
+  }
+
+  *loaded = true;
   return true;
 }
 
@@ -5720,6 +6325,9 @@ static Readback* lovrReadbackCreateTimestamp(TimingInfo* times, uint32_t count,
   readback->view = buffer;
   readback->times = times;
   readback->count = count;
+  readback->zones = NULL;
+  readback->slots = NULL;
+  readback->zoneCount = 0;
   return readback;
 }
 
@@ -5739,6 +6347,7 @@ void lovrReadbackDestroy(void* ref) {
         lovrRelease(readback->times[i].pass, lovrPassDestroy);
       }
       lovrFree(readback->times);
+      lovrFree(readback->zones);
       break;
     default: break;
   }
@@ -5905,6 +6514,7 @@ void lovrPassDestroy(void* ref) {
     gpu_tally_destroy(pass->tally.gpu);
     lovrRelease(pass->tally.tempBuffer, lovrBufferDestroy);
   }
+  lovrRelease(pass->pyramid.buffer, lovrBufferDestroy);
   destroyBuffers(&pass->buffers);
   lovrFree(pass->allocator.memory);
   lovrFree(pass->label);
@@ -5932,6 +6542,12 @@ void lovrPassReset(Pass* pass) {
   pass->tally.active = false;
   pass->tally.count = 0;
 
+  pass->timers.list = NULL;
+  pass->timers.events = NULL;
+  pass->timers.count = 0;
+  pass->timers.eventCount = 0;
+  pass->timers.active = ~0u;
+
   pass->transformIndex = 0;
   mat4_identity(pass->transform);
 
@@ -8287,15 +8903,55 @@ bool lovrPassSetTallyBuffer(Pass* pass, Buffer* buffer, uint32_t offset) {
   return true;
 }
 
-bool lovrPassCompute(Pass* pass, uint32_t x, uint32_t y, uint32_t z, Buffer* indirect, uint32_t offset) {
+bool lovrPassBeginTimer(Pass* pass, const char* label) {
+  Timers* timers = &pass->timers;
+  lovrCheck(timers->count < MAX_TIMERS, "Pass has too many timers!");
+
+  if (!timers->list) {
+    timers->list = lovrPassAllocate(pass, MAX_TIMERS * sizeof(Timer));
+    timers->events = lovrPassAllocate(pass, 2 * MAX_TIMERS * sizeof(uint16_t));
+  }
+
+  size_t length = strlen(label);
+  char* copy = lovrPassAllocate(pass, length + 1);
+  memcpy(copy, label, length + 1);
+
+  Timer* timer = &timers->list[timers->count];
+  timer->label = copy;
+  timer->parent = timers->active;
+  timer->start = pass->drawCount;
+  timer->end = ~0u;
+  timer->cpuTime = os_get_time();
+
+  timers->events[timers->eventCount++] = (uint16_t) (timers->count << 1);
+  timers->active = timers->count++;
+  return true;
+}
+
+bool lovrPassEndTimer(Pass* pass) {
+  Timers* timers = &pass->timers;
+  lovrCheck(timers->active != ~0u, "Trying to end a timer, but no timer was started");
+  Timer* timer = &timers->list[timers->active];
+  timer->end = pass->drawCount;
+  timer->cpuTime = os_get_time() - timer->cpuTime;
+  timers->events[timers->eventCount++] = (uint16_t) ((timers->active << 1) | 1);
+  timers->active = timer->parent;
+  return true;
+}
+
+static Compute* lovrPassAddCompute(Pass* pass) {
   if ((pass->computeCount & (pass->computeCount - 1)) == 0) {
     Compute* computes = lovrPassAllocate(pass, MAX(pass->computeCount << 1, 1) * sizeof(Compute));
     if (pass->computes) memcpy(computes, pass->computes, pass->computeCount * sizeof(Compute));
     pass->computes = computes;
   }
 
+  return &pass->computes[pass->computeCount++];
+}
+
+bool lovrPassCompute(Pass* pass, uint32_t x, uint32_t y, uint32_t z, Buffer* indirect, uint32_t offset) {
   Compute* previous = pass->computeCount > 0 ? &pass->computes[pass->computeCount - 1] : NULL;
-  Compute* compute = &pass->computes[pass->computeCount++];
+  Compute* compute = lovrPassAddCompute(pass);
   Shader* shader = pass->pipeline->shader;
 
   lovrCheck(shader->info.type == SHADER_COMPUTE, "To run a compute shader, a compute shader must be active");
@@ -8329,6 +8985,223 @@ void lovrPassBarrier(Pass* pass) {
   }
 }
 
+// Records a dispatch of a builtin compute shader.  Builtin dispatches don't use the Pass's bindings
+// or uniforms, so those are marked dirty to make sure the next dispatch doesn't inherit them.
+static bool lovrPassComputeBuiltin(Pass* pass, Shader* shader, gpu_binding* bindings, void* constants, size_t size, uint32_t count) {
+  lovrPassBarrier(pass);
+
+  uint32_t subgroupSize = state.device.subgroupSize;
+  uint32_t x = (count + subgroupSize - 1) / subgroupSize;
+  lovrCheck(x <= state.limits.workgroupCount[0], "Compute %s count exceeds workgroupCount limit", "x");
+
+  BufferView view = lovrPassGetBuffer(pass, shader->uniformSize, state.limits.uniformBufferAlign);
+  if (!view.buffer) return false;
+  memset(view.pointer, 0, shader->uniformSize);
+  memcpy(view.pointer, constants, MIN(size, shader->uniformSize));
+
+  Compute* compute = lovrPassAddCompute(pass);
+  compute->flags = COMPUTE_BARRIER;
+  compute->shader = shader;
+  compute->bindings = bindings;
+  compute->uniformBuffer = view.buffer;
+  compute->uniformOffset = view.offset;
+  compute->x = x;
+  compute->y = 1;
+  compute->z = 1;
+  lovrRetain(shader);
+
+  pass->flags |= DIRTY_BINDINGS | DIRTY_UNIFORMS;
+  return true;
+}
+
+bool lovrPassBuildDepthPyramid(Pass* pass, Texture* texture, float* viewProjection) {
+  lovrCheck(isDepthFormat(texture->info.format), "Depth pyramids must be built from a depth texture");
+  lovrCheck(texture->info.type == TEXTURE_2D, "Depth pyramids can only be built from 2D textures");
+  lovrCheck(texture->info.samples == 1, "Depth pyramids can not be built from multisampled textures");
+  lovrCheck(texture->info.usage & TEXTURE_SAMPLE, "Texture must be created with the 'sample' usage to build a depth pyramid from it");
+
+  Shader* shader = lovrGraphicsGetDefaultShader(SHADER_PYRAMID);
+  if (!shader) return false;
+
+  DepthPyramid* pyramid = &pass->pyramid;
+
+  // The first level is half the size of the texture, levels are stored back to back in a Buffer
+  uint32_t width = (texture->info.width + 1) / 2;
+  uint32_t height = (texture->info.height + 1) / 2;
+  uint32_t levels = 1;
+  uint32_t texels = width * height;
+
+  for (uint32_t w = width, h = height; w > 1 || h > 1; levels++) {
+    w = (w + 1) / 2;
+    h = (h + 1) / 2;
+    texels += w * h;
+  }
+
+  // The Buffer starts with a header used as a counter when culling
+  uint32_t header = MAX(state.limits.storageBufferAlign, 16);
+  uint32_t size = header + texels * sizeof(float);
+
+  if (!pyramid->buffer || pyramid->buffer->info.size < size) {
+    lovrRelease(pyramid->buffer, lovrBufferDestroy);
+    pyramid->buffer = lovrBufferCreate(&(BufferInfo) { .size = size }, NULL);
+    if (!pyramid->buffer) return false;
+  }
+
+  pyramid->header = header;
+  pyramid->texels = texels;
+  pyramid->size[0] = texture->info.width;
+  pyramid->size[1] = texture->info.height;
+  pyramid->levels = levels;
+
+  if (viewProjection) {
+    mat4_init(pyramid->viewProjection, viewProjection);
+  } else {
+    Camera* camera = getCamera(pass);
+    mat4_init(pyramid->viewProjection, camera->projection);
+    mat4_mul(pyramid->viewProjection, camera->viewMatrix);
+  }
+
+  Buffer* buffer = pyramid->buffer;
+  trackTexture(pass, texture, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_TEXTURE);
+  trackBuffer(pass, buffer, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_STORAGE_WRITE);
+
+  gpu_binding* bindings = lovrPassAllocate(pass, 2 * sizeof(gpu_binding));
+  bindings[0] = (gpu_binding) { 0, GPU_SLOT_TEXTURE_WITH_SAMPLER, .texture = { texture->sampleView, state.defaultSamplers[FILTER_NEAREST]->gpu } };
+  bindings[1] = (gpu_binding) { 1, GPU_SLOT_STORAGE_BUFFER, .buffer = { buffer->gpu, buffer->base + header, texels * sizeof(float) } };
+
+  struct {
+    uint32_t srcSize[2];
+    uint32_t dstSize[2];
+    uint32_t srcOffset;
+    uint32_t dstOffset;
+    uint32_t level;
+  } constants = {
+    .srcSize = { texture->info.width, texture->info.height },
+    .dstSize = { width, height }
+  };
+
+  for (uint32_t i = 0; i < levels; i++) {
+    constants.level = i;
+
+    if (!lovrPassComputeBuiltin(pass, shader, bindings, &constants, sizeof(constants), constants.dstSize[0] * constants.dstSize[1])) {
+      return false;
+    }
+
+    constants.srcOffset = constants.dstOffset;
+    constants.dstOffset += constants.dstSize[0] * constants.dstSize[1];
+    constants.srcSize[0] = constants.dstSize[0];
+    constants.srcSize[1] = constants.dstSize[1];
+    constants.dstSize[0] = (constants.dstSize[0] + 1) / 2;
+    constants.dstSize[1] = (constants.dstSize[1] + 1) / 2;
+  }
+
+  return true;
+}
+
+bool lovrPassCullDraws(Pass* pass, Buffer* bounds, Buffer* draws, Buffer* output, uint32_t count, bool indexed) {
+  DepthPyramid* pyramid = &pass->pyramid;
+  lovrCheck(pyramid->buffer, "A depth pyramid must be built before culling draws");
+
+  uint32_t stride = indexed ? 20 : 16;
+  lovrCheck((uint64_t) count * 24 <= bounds->info.size, "Bounds buffer is too small to cull %d draws", count);
+  lovrCheck((uint64_t) count * stride <= draws->info.size, "Draw buffer is too small to cull %d draws", count);
+  lovrCheck((uint64_t) count * stride <= output->info.size, "Output buffer is too small to cull %d draws", count);
+
+  if (count == 0) {
+    return true;
+  }
+
+  Shader* shader = lovrGraphicsGetDefaultShader(SHADER_CULL);
+  if (!shader) return false;
+
+  Buffer* buffer = pyramid->buffer;
+  trackBuffer(pass, buffer, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_STORAGE_WRITE);
+  trackBuffer(pass, bounds, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_STORAGE_READ);
+  trackBuffer(pass, draws, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_STORAGE_READ);
+  trackBuffer(pass, output, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_STORAGE_WRITE);
+
+  gpu_binding* bindings = lovrPassAllocate(pass, 5 * sizeof(gpu_binding));
+  bindings[0] = (gpu_binding) { 0, GPU_SLOT_STORAGE_BUFFER, .buffer = { buffer->gpu, buffer->base + pyramid->header, pyramid->texels * sizeof(float) } };
+  bindings[1] = (gpu_binding) { 1, GPU_SLOT_STORAGE_BUFFER, .buffer = { buffer->gpu, buffer->base, sizeof(uint32_t) } };
+  bindings[2] = (gpu_binding) { 2, GPU_SLOT_STORAGE_BUFFER, .buffer = { bounds->gpu, bounds->base, count * 24 } };
+  bindings[3] = (gpu_binding) { 3, GPU_SLOT_STORAGE_BUFFER, .buffer = { draws->gpu, draws->base, count * stride } };
+  bindings[4] = (gpu_binding) { 4, GPU_SLOT_STORAGE_BUFFER, .buffer = { output->gpu, output->base, count * stride } };
+
+  struct {
+    float viewProjection[16];
+    uint32_t size[2];
+    uint32_t levels;
+    uint32_t count;
+    uint32_t stride;
+    uint32_t clear;
+  } constants = {
+    .size = { pyramid->size[0], pyramid->size[1] },
+    .levels = pyramid->levels,
+    .count = count,
+    .stride = stride / 4,
+    .clear = true
+  };
+
+  mat4_init(constants.viewProjection, pyramid->viewProjection);
+
+  if (!lovrPassComputeBuiltin(pass, shader, bindings, &constants, sizeof(constants), count)) {
+    return false;
+  }
+
+  constants.clear = false;
+  return lovrPassComputeBuiltin(pass, shader, bindings, &constants, sizeof(constants), count);
+}
+
+bool lovrPassCullInstances(Pass* pass, Buffer* bounds, Buffer* output, Buffer* draws, uint32_t offset, uint32_t count) {
+  lovrCheck(pass->views > 0, "Pass must have a canvas to cull instances");
+  lovrCheck(count * 16 <= bounds->info.size, "Bounds buffer is too small to cull %d instances", count);
+  lovrCheck(count * 4 <= output->info.size, "Output buffer is too small to cull %d instances", count);
+  lovrCheck(offset % 4 == 0, "Draw buffer offset must be a multiple of 4");
+  lovrCheck(offset + 8 <= draws->info.size, "Tried to read past the end of the draw buffer");
+
+  if (count == 0) {
+    return true;
+  }
+
+  Shader* shader = lovrGraphicsGetDefaultShader(SHADER_FRUSTUM);
+  if (!shader) return false;
+
+  trackBuffer(pass, bounds, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_STORAGE_READ);
+  trackBuffer(pass, output, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_STORAGE_WRITE);
+  trackBuffer(pass, draws, GPU_PHASE_SHADER_COMPUTE, GPU_CACHE_STORAGE_WRITE);
+
+  gpu_binding* bindings = lovrPassAllocate(pass, 3 * sizeof(gpu_binding));
+  bindings[0] = (gpu_binding) { 0, GPU_SLOT_STORAGE_BUFFER, .buffer = { bounds->gpu, bounds->base, count * 16 } };
+  bindings[1] = (gpu_binding) { 1, GPU_SLOT_STORAGE_BUFFER, .buffer = { output->gpu, output->base, count * 4 } };
+  bindings[2] = (gpu_binding) { 2, GPU_SLOT_STORAGE_BUFFER, .buffer = { draws->gpu, draws->base, draws->info.size } };
+
+  struct {
+    float viewProjections[6][16];
+    uint32_t views;
+    uint32_t count;
+    uint32_t offset;
+    uint32_t clear;
+  } constants = {
+    .views = pass->views,
+    .count = count,
+    .offset = offset / 4,
+    .clear = true
+  };
+
+  Camera* camera = getCamera(pass);
+  for (uint32_t i = 0; i < pass->views; i++) {
+    mat4_init(constants.viewProjections[i], camera[i].projection);
+    mat4_mul(constants.viewProjections[i], camera[i].viewMatrix);
+  }
+
+  if (!lovrPassComputeBuiltin(pass, shader, bindings, &constants, sizeof(constants), 1)) {
+    return false;
+  }
+
+  constants.clear = false;
+  return lovrPassComputeBuiltin(pass, shader, bindings, &constants, sizeof(constants), count);
+}
+
 // Helpers
 
 static void initAllocator(Allocator* allocator) {
@@ -8511,6 +9384,51 @@ static void flushTransfers(void) {
   }
 }
 
+#ifdef LOVR_PROFILE
+// GPU timestamps are copied as 32 bit values, Tracy wants them to be monotonic
+static uint64_t extendTimestamp(uint32_t timestamp) {
+  uint64_t extended = (state.gpuTimestamp & ~0xffffffffull) | timestamp;
+  if (extended + 0x80000000ull < state.gpuTimestamp) extended += 1ull << 32;
+  return state.gpuTimestamp = extended;
+}
+
+// Zones are emitted in nesting order (a zone's children are emitted between its begin and end)
+static void profileGpuZones(Readback* readback, uint32_t* timestamps, uint32_t index) {
+  GraphicsTiming* zone = &readback->zones[index];
+  uint32_t* slots = readback->slots;
+
+  if (!state.gpuContext) {
+    state.gpuTimestamp = timestamps[slots[2 * index]];
+    ___tracy_emit_gpu_new_context_serial((struct ___tracy_gpu_new_context_data) {
+      .gpuTime = (int64_t) state.gpuTimestamp,
+      .period = state.limits.timestampPeriod,
+      .context = 0,
+      .flags = 0,
+      .type = 2 // Vulkan
+    });
+    state.gpuContext = true;
+  }
+
+  const char* label = *zone->label ? zone->label : "Pass";
+  uint64_t srcloc = ___tracy_alloc_srcloc_name(__LINE__, __FILE__, strlen(__FILE__), __func__, strlen(__func__), label, strlen(label), 0);
+  uint16_t query = state.gpuQuery++;
+  ___tracy_emit_gpu_zone_begin_alloc_serial((struct ___tracy_gpu_zone_begin_data) { .srcloc = srcloc, .queryId = query, .context = 0 });
+  ___tracy_emit_gpu_time_serial((struct ___tracy_gpu_time_data) { .gpuTime = (int64_t) extendTimestamp(timestamps[slots[2 * index + 0]]), .queryId = query, .context = 0 });
+
+  for (uint32_t i = index + 1; i < readback->zoneCount && readback->zones[i].parent != ~0u; i++) {
+    if (readback->zones[i].parent == index) {
+      profileGpuZones(readback, timestamps, i);
+    }
+  }
+
+  query = state.gpuQuery++;
+  ___tracy_emit_gpu_zone_end_serial((struct ___tracy_gpu_zone_end_data) { .queryId = query, .context = 0 });
+  ___tracy_emit_gpu_time_serial((struct ___tracy_gpu_time_data) { .gpuTime = (int64_t) extendTimestamp(timestamps[slots[2 * index + 1]]), .queryId = query, .context = 0 });
+}
+#else
+#define profileGpuZones(readback, timestamps, index) ((void) 0)
+#endif
+
 static void processReadbacks(void) {
   while (state.oldestReadback && gpu_is_complete(state.oldestReadback->tick)) {
     Readback* readback = state.oldestReadback;
@@ -8526,11 +9444,44 @@ static void processReadbacks(void) {
         break;
       case READBACK_TIMESTAMP:;
         uint32_t* timestamps = readback->view.pointer;
+        GraphicsTiming* zones = readback->zones;
+        uint32_t* slots = readback->slots;
+
+        for (uint32_t i = 0; i < readback->zoneCount; i++) {
+          uint32_t duration = timestamps[slots[2 * i + 1]] - timestamps[slots[2 * i + 0]];
+          zones[i].gpuTime = duration * state.limits.timestampPeriod / 1e9;
+        }
+
         for (uint32_t i = 0; i < readback->count; i++) {
           Pass* pass = readback->times[i].pass;
-          pass->stats.submitTime = readback->times[i].cpuTime;
-          pass->stats.gpuTime = (timestamps[2 * i + 1] - timestamps[2 * i + 0]) * state.limits.timestampPeriod / 1e9;
+          GraphicsTiming* zone = &zones[readback->times[i].zone];
+          zone->cpuTime = readback->times[i].cpuTime;
+          pass->stats.submitTime = zone->cpuTime;
+          pass->stats.gpuTime = zone->gpuTime;
+          profileGpuZones(readback, timestamps, readback->times[i].zone);
         }
+
+        // Timings are latched per frame, so the first readback from a new frame replaces them
+        if (readback->tick != state.timingTick) {
+          for (size_t i = 0; i < state.timingBlocks.length; i++) {
+            lovrFree(state.timingBlocks.data[i]);
+          }
+
+          arr_clear(&state.timingBlocks);
+          arr_clear(&state.timings);
+          state.timingTick = readback->tick;
+        }
+
+        uint32_t base = (uint32_t) state.timings.length;
+        arr_append(&state.timings, zones, readback->zoneCount);
+        for (uint32_t i = base; i < state.timings.length; i++) {
+          if (state.timings.data[i].parent != ~0u) {
+            state.timings.data[i].parent += base;
+          }
+        }
+
+        arr_push(&state.timingBlocks, zones);
+        readback->zones = NULL;
         break;
       default: break;
     }
@@ -107,8 +107,16 @@ bool lovrGraphicsIsHDR(void);
 void lovrGraphicsGetBackgroundColor(float background[4]);
 void lovrGraphicsSetBackgroundColor(float background[4]);
 
+typedef struct {
+  const char* label;
+  uint32_t parent;
+  double cpuTime;
+  double gpuTime;
+} GraphicsTiming;
+
 bool lovrGraphicsIsTimingEnabled(void);
 void lovrGraphicsSetTimingEnabled(bool enable);
+const GraphicsTiming* lovrGraphicsGetTimings(uint32_t* count);
 bool lovrGraphicsSubmit(Pass** passes, uint32_t count);
 bool lovrGraphicsPresent(void);
 bool lovrGraphicsWait(void);
@@ -297,6 +305,9 @@ typedef enum {
   SHADER_ANIMATOR,
   SHADER_BLENDER,
   SHADER_TALLY_MERGE,
+  SHADER_PYRAMID,
+  SHADER_CULL,
+  SHADER_FRUSTUM,
   DEFAULT_SHADER_COUNT
 } DefaultShader;
 
@@ -424,6 +435,9 @@ float lovrFontGetKerning(Font* font, uint32_t first, uint32_t second);
 float lovrFontGetWidth(Font* font, ColoredString* strings, uint32_t count);
 void lovrFontGetLines(Font* font, ColoredString* strings, uint32_t count, float wrap, void (*callback)(void* context, const char* string, size_t length), void* context);
 bool lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, GlyphVertex* vertices, uint32_t* glyphCount, uint32_t* lineCount, Material** material, bool flip);
+bool lovrFontPrewarm(Font* font, const uint32_t* codepoints, uint32_t count);
+struct Blob* lovrFontGetCache(Font* font);
+bool lovrFontLoadCache(Font* font, struct Blob* blob, bool* loaded);
 
 // Mesh
 
@@ -668,5 +682,11 @@ bool lovrPassFinishTally(Pass* pass, uint32_t* index);
 Buffer* lovrPassGetTallyBuffer(Pass* pass, uint32_t* offset);
 bool lovrPassSetTallyBuffer(Pass* pass, Buffer* buffer, uint32_t offset);
 
+bool lovrPassBeginTimer(Pass* pass, const char* label);
+bool lovrPassEndTimer(Pass* pass);
+
 bool lovrPassCompute(Pass* pass, uint32_t x, uint32_t y, uint32_t z, Buffer* indirect, uint32_t offset);
 void lovrPassBarrier(Pass* pass);
+bool lovrPassBuildDepthPyramid(Pass* pass, Texture* texture, float* viewProjection);
+bool lovrPassCullDraws(Pass* pass, Buffer* bounds, Buffer* draws, Buffer* output, uint32_t count, bool indexed);
+bool lovrPassCullInstances(Pass* pass, Buffer* bounds, Buffer* output, Buffer* draws, uint32_t offset, uint32_t count);
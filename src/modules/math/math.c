@@ -1,9 +1,11 @@
 #include "math.h"
 #include "core/maf.h"
+#include "core/job.h"
 #include "core/os.h"
 #include "util.h"
 #include "lib/noise/simplexnoise1234.h"
 #include <math.h>
+#include <assert.h>
 #include <stdatomic.h>
 #include <inttypes.h>
 #include <stdlib.h>
@@ -11,9 +13,17 @@
 #include <string.h>
 #include <time.h>
 
+#define CURVE_MAX_POLYNOMIAL_POINTS 6
+#define CURVE_LENGTH_SAMPLES 128
+
 struct Curve {
   uint32_t ref;
   arr_t(float) points;
+  bool dirtyPolynomial;
+  bool dirtyLengths;
+  float polynomial[CURVE_MAX_POLYNOMIAL_POINTS * 4];
+  float derivative[(CURVE_MAX_POLYNOMIAL_POINTS - 1) * 4];
+  float lengths[CURVE_LENGTH_SAMPLES + 1];
 };
 
 struct Pool {
@@ -26,11 +36,23 @@ struct Pool {
 
 struct RandomGenerator {
   uint32_t ref;
+  RandomAlgorithm algorithm;
   Seed seed;
   Seed state;
+  uint64_t xoshiro[4];
   double lastRandomNormal;
 };
 
+struct VectorArray {
+  uint32_t ref;
+  VectorType type;
+  uint32_t components;
+  size_t count;
+  float* data;
+  void* owner;
+  void (*destructor)(void*);
+};
+
 static struct {
   uint32_t ref;
   RandomGenerator* generator;
@@ -38,7 +60,7 @@ static struct {
 
 bool lovrMathInit(void) {
   if (atomic_fetch_add(&state.ref, 1)) return false;
-  state.generator = lovrRandomGeneratorCreate();
+  state.generator = lovrRandomGeneratorCreate(RANDOM_XORSHIFT);
   Seed seed = { .b64 = (uint64_t) time(0) };
   lovrRandomGeneratorSetSeed(state.generator, seed);
   return true;
@@ -82,15 +104,92 @@ double lovrMathNoise4(double x, double y, double z, double w) {
   return snoise4(x, y, z, w) * .5 + .5;
 }
 
+typedef struct {
+  NoiseInfo* info;
+  float* data;
+  uint32_t start;
+  uint32_t count;
+} NoiseBatch;
+
+static void fillNoise(void* arg) {
+  NoiseBatch* batch = arg;
+  NoiseInfo* info = batch->info;
+  uint32_t width = info->size[0];
+  uint32_t height = info->size[1];
+
+  for (uint32_t row = batch->start; row < batch->start + batch->count; row++) {
+    float* data = batch->data + (size_t) row * width;
+    double y = (double) (row % height) + info->offset[1];
+    double z = (double) (row / height) + info->offset[2];
+
+    for (uint32_t i = 0; i < width; i++) {
+      double x = (double) i + info->offset[0];
+      double frequency = info->frequency;
+      double amplitude = 1.;
+      double total = 0.;
+      double sum = 0.;
+
+      for (uint32_t octave = 0; octave < info->octaves; octave++) {
+        switch (info->dimensions) {
+          case 1: sum += amplitude * snoise1(x * frequency); break;
+          case 2: sum += amplitude * snoise2(x * frequency, y * frequency); break;
+          default: sum += amplitude * snoise3(x * frequency, y * frequency, z * frequency); break;
+        }
+        total += amplitude;
+        frequency *= info->lacunarity;
+        amplitude *= info->gain;
+      }
+
+      data[i] = (float) (total > 0. ? sum / total : 0.) * .5f + .5f;
+    }
+  }
+}
+
+bool lovrMathNoiseField(NoiseInfo* info, float* data) {
+  lovrCheck(info->dimensions >= 1 && info->dimensions <= 3, "Noise field must have 1, 2, or 3 dimensions");
+  lovrCheck(info->octaves > 0, "Noise field must have at least 1 octave");
+
+  for (uint32_t i = info->dimensions; i < 3; i++) {
+    info->size[i] = 1;
+  }
+
+  // Rows are generated on worker threads, in batches to avoid running out of jobs
+  uint32_t rows = info->size[1] * info->size[2];
+  lovrCheck(info->size[0] > 0 && rows > 0, "Noise field size must be positive");
+
+  NoiseBatch batches[32];
+  job* jobs[COUNTOF(batches)];
+  uint32_t batchCount = MIN(rows, COUNTOF(batches));
+  uint32_t batchSize = (rows + batchCount - 1) / batchCount;
+
+  for (uint32_t i = 0; i < batchCount; i++) {
+    uint32_t start = i * batchSize;
+    batches[i].info = info;
+    batches[i].data = data;
+    batches[i].start = start;
+    batches[i].count = start < rows ? MIN(batchSize, rows - start) : 0;
+    jobs[i] = job_start(fillNoise, &batches[i]);
+  }
+
+  for (uint32_t i = 0; i < batchCount; i++) {
+    job_wait(jobs[i]);
+  }
+
+  return true;
+}
+
 RandomGenerator* lovrMathGetRandomGenerator(void) {
   return state.generator;
 }
 
 // Curve
 
-// Explicit curve evaluation, unroll simple cases to avoid pow overhead
+// Explicit curve evaluation, with simple cases unrolled
 static void evaluate(float* restrict P, size_t n, float t, vec4 p) {
-  if (n == 2) {
+  if (n < 2) {
+    p[0] = p[1] = p[2] = p[3] = 0.f;
+    if (n == 1) vec4_init(p, P);
+  } else if (n == 2) {
     p[0] = P[0] + (P[4] - P[0]) * t;
     p[1] = P[1] + (P[5] - P[1]) * t;
     p[2] = P[2] + (P[6] - P[2]) * t;
@@ -115,17 +214,134 @@ static void evaluate(float* restrict P, size_t n, float t, vec4 p) {
     p[2] = a * P[2] + b * P[6] + c * P[10] + d * P[14];
     p[3] = a * P[3] + b * P[7] + c * P[11] + d * P[15];
   } else {
-    float b = 1.f;
-    p[0] = p[1] = p[2] = p[3] = 0.f;
-    for (size_t i = 0; i < n; i++, b *= (float) (n - i) / i) {
-      float c1 = powf(1.f - t, n - (i + 1));
-      float c2 = powf(t, i);
-      p[0] += b * c1 * c2 * P[i * 4 + 0];
-      p[1] += b * c1 * c2 * P[i * 4 + 1];
-      p[2] += b * c1 * c2 * P[i * 4 + 2];
-      p[3] += b * c1 * c2 * P[i * 4 + 3];
+    // Horner-like form of the Bernstein sum, O(n) without pow.  Doubles keep the binomials finite up
+    // to about 1000 points.
+    double s = 1. - t;
+    double power = 1.;
+    double binomial = 1.;
+    double q[4] = { P[0] * s, P[1] * s, P[2] * s, P[3] * s };
+    for (size_t i = 1; i < n - 1; i++) {
+      power *= t;
+      binomial = binomial * (n - i) / i;
+      double w = power * binomial;
+      q[0] = (q[0] + w * P[i * 4 + 0]) * s;
+      q[1] = (q[1] + w * P[i * 4 + 1]) * s;
+      q[2] = (q[2] + w * P[i * 4 + 2]) * s;
+      q[3] = (q[3] + w * P[i * 4 + 3]) * s;
+    }
+    power *= t;
+    p[0] = (float) (q[0] + power * P[(n - 1) * 4 + 0]);
+    p[1] = (float) (q[1] + power * P[(n - 1) * 4 + 1]);
+    p[2] = (float) (q[2] + power * P[(n - 1) * 4 + 2]);
+    p[3] = (float) (q[3] + power * P[(n - 1) * 4 + 3]);
+  }
+}
+
+// Horner evaluation of a polynomial with n vec4 coefficients
+static void horner(float* restrict c, size_t n, float t, vec4 p) {
+  vec4_init(p, c + 4 * (n - 1));
+  for (size_t i = n - 1; i-- > 0;) {
+    p[0] = p[0] * t + c[4 * i + 0];
+    p[1] = p[1] * t + c[4 * i + 1];
+    p[2] = p[2] * t + c[4 * i + 2];
+    p[3] = p[3] * t + c[4 * i + 3];
+  }
+}
+
+static double choose(size_t n, size_t k) {
+  double result = 1.;
+  for (size_t i = 1; i <= k; i++) {
+    result = result * (n - k + i) / i;
+  }
+  return result;
+}
+
+// Converts low degree curves from the Bernstein basis to the power basis so they can be evaluated
+// with Horner's method.  Higher degrees stay in the Bernstein basis, which is more stable.
+static void lovrCurveUpdatePolynomial(Curve* curve) {
+  if (!curve->dirtyPolynomial) return;
+
+  size_t n = curve->points.length / 4;
+  float* P = curve->points.data;
+
+  for (size_t j = 0; j < n; j++) {
+    double scale = choose(n - 1, j);
+    for (size_t c = 0; c < 4; c++) {
+      double sum = 0.;
+      for (size_t i = 0; i <= j; i++) {
+        sum += ((j - i) & 1 ? -1. : 1.) * choose(j, i) * P[4 * i + c];
+      }
+      curve->polynomial[4 * j + c] = (float) (scale * sum);
     }
   }
+
+  for (size_t j = 0; j + 1 < n; j++) {
+    vec4_scale(vec4_init(curve->derivative + 4 * j, curve->polynomial + 4 * (j + 1)), (float) (j + 1));
+  }
+
+  curve->dirtyPolynomial = false;
+}
+
+static void lovrCurveSample(Curve* curve, float t, vec4 p) {
+  size_t n = curve->points.length / 4;
+  if (n <= CURVE_MAX_POLYNOMIAL_POINTS) {
+    lovrCurveUpdatePolynomial(curve);
+    horner(curve->polynomial, n, t, p);
+  } else {
+    evaluate(curve->points.data, n, t, p);
+  }
+}
+
+static void lovrCurveUpdateLengths(Curve* curve) {
+  if (!curve->dirtyLengths) return;
+
+  float previous[4], point[4];
+  lovrCurveSample(curve, 0.f, previous);
+  curve->lengths[0] = 0.f;
+
+  for (uint32_t i = 1; i <= CURVE_LENGTH_SAMPLES; i++) {
+    lovrCurveSample(curve, (float) i / CURVE_LENGTH_SAMPLES, point);
+    curve->lengths[i] = curve->lengths[i - 1] + vec3_distance(previous, point);
+    vec4_init(previous, point);
+  }
+
+  curve->dirtyLengths = false;
+}
+
+static void lovrCurveInvalidate(Curve* curve) {
+  curve->dirtyPolynomial = true;
+  curve->dirtyLengths = true;
+}
+
+// Converts a distance along the curve to a curve parameter, using the arc length table
+static float lovrCurveGetParameter(Curve* curve, float distance) {
+  lovrCurveUpdateLengths(curve);
+  float* lengths = curve->lengths;
+
+  if (distance <= 0.f) return 0.f;
+  if (distance >= lengths[CURVE_LENGTH_SAMPLES]) return 1.f;
+
+  uint32_t lo = 0;
+  uint32_t hi = CURVE_LENGTH_SAMPLES;
+  while (hi - lo > 1) {
+    uint32_t mid = (lo + hi) / 2;
+    if (lengths[mid] <= distance) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+
+  float span = lengths[hi] - lengths[lo];
+  float fraction = span > 0.f ? (distance - lengths[lo]) / span : 0.f;
+  return (lo + fraction) / CURVE_LENGTH_SAMPLES;
+}
+
+static float lovrCurveGetDistance(Curve* curve, float t) {
+  lovrCurveUpdateLengths(curve);
+  float x = t * CURVE_LENGTH_SAMPLES;
+  uint32_t i = MIN((uint32_t) x, CURVE_LENGTH_SAMPLES - 1);
+  return curve->lengths[i] + (curve->lengths[i + 1] - curve->lengths[i]) * (x - i);
 }
 
 Curve* lovrCurveCreate(void) {
@@ -133,6 +349,7 @@ Curve* lovrCurveCreate(void) {
   curve->ref = 1;
   arr_init(&curve->points);
   arr_reserve(&curve->points, 16);
+  lovrCurveInvalidate(curve);
   return curve;
 }
 
@@ -145,13 +362,54 @@ void lovrCurveDestroy(void* ref) {
 bool lovrCurveEvaluate(Curve* curve, float t, vec4 p) {
   lovrCheck(curve->points.length >= 8, "Need at least 2 points to evaluate a Curve");
   lovrCheck(t >= 0.f && t <= 1.f, "Curve evaluation interval must be within [0, 1]");
-  evaluate(curve->points.data, curve->points.length / 4, t, p);
+  lovrCurveSample(curve, t, p);
   return true;
 }
 
+bool lovrCurveEvaluateMany(Curve* curve, float t1, float t2, size_t count, bool uniform, float* points, size_t stride) {
+  lovrCheck(curve->points.length >= 8, "Need at least 2 points to evaluate a Curve");
+  lovrCheck(t1 >= 0.f && t1 <= 1.f && t2 >= 0.f && t2 <= 1.f, "Curve evaluation interval must be within [0, 1]");
+  lovrCheck(stride >= 3, "Curve points need at least 3 components");
+
+  float d1 = 0.f, d2 = 0.f;
+  if (uniform) {
+    d1 = lovrCurveGetDistance(curve, t1);
+    d2 = lovrCurveGetDistance(curve, t2);
+  }
+
+  float step = count > 1 ? 1.f / (count - 1) : 0.f;
+  for (size_t i = 0; i < count; i++, points += stride) {
+    float t = uniform ? lovrCurveGetParameter(curve, d1 + (d2 - d1) * i * step) : t1 + (t2 - t1) * i * step;
+    float point[4];
+    lovrCurveSample(curve, t, point);
+    memcpy(points, point, MIN(stride, 4) * sizeof(float));
+  }
+
+  return true;
+}
+
+bool lovrCurveEvaluateDistance(Curve* curve, float distance, float* point) {
+  lovrCheck(curve->points.length >= 8, "Need at least 2 points to evaluate a Curve");
+  lovrCurveSample(curve, lovrCurveGetParameter(curve, distance), point);
+  return true;
+}
+
+float lovrCurveGetLength(Curve* curve) {
+  if (curve->points.length < 8) return 0.f;
+  lovrCurveUpdateLengths(curve);
+  return curve->lengths[CURVE_LENGTH_SAMPLES];
+}
+
 void lovrCurveGetTangent(Curve* curve, float t, vec4 p) {
-  float q[4];
   size_t n = curve->points.length / 4;
+  if (n >= 2 && n <= CURVE_MAX_POLYNOMIAL_POINTS) {
+    lovrCurveUpdatePolynomial(curve);
+    horner(curve->derivative, n - 1, t, p);
+    vec3_normalize(p);
+    return;
+  }
+
+  float q[4];
   evaluate(curve->points.data, n - 1, t, q);
   evaluate(curve->points.data + 4, n - 1, t, p);
   vec4_add(p, vec4_scale(q, -1.f));
@@ -196,6 +454,7 @@ void lovrCurveGetPoint(Curve* curve, size_t index, vec4 point) {
 
 void lovrCurveSetPoint(Curve* curve, size_t index, vec4 point) {
   vec4_init(curve->points.data + 4 * index, point);
+  lovrCurveInvalidate(curve);
 }
 
 void lovrCurveAddPoint(Curve* curve, vec4 point, size_t index) {
@@ -212,16 +471,22 @@ void lovrCurveAddPoint(Curve* curve, vec4 point, size_t index) {
   // Fill the empty space with the new point
   curve->points.length += 4;
   memcpy(dest, point, 4 * sizeof(float));
+  lovrCurveInvalidate(curve);
 }
 
 void lovrCurveRemovePoint(Curve* curve, size_t index) {
   arr_splice(&curve->points, index * 4, 4);
+  lovrCurveInvalidate(curve);
 }
 
 // Pool
 
+// Checked against 32 bits so handles survive a round trip through uintptr_t on 32 bit targets too
+static_assert(sizeof(((Vector*) NULL)->handle) <= sizeof(uint32_t), "Vector handles must fit in 32 bits");
+
+// Every vector takes a multiple of 4 floats, since handles store the index in groups of 4
 static const size_t vectorComponents[] = {
-  [V_VEC2] = 2,
+  [V_VEC2] = 4,
   [V_VEC3] = 4,
   [V_VEC4] = 4,
   [V_QUAT] = 4,
@@ -268,7 +533,7 @@ Vector lovrPoolAllocate(Pool* pool, VectorType type, float** data) {
     .handle = {
       .type = type,
       .generation = pool->generation,
-      .index = pool->cursor
+      .index = pool->cursor >> 2
     }
   };
 
@@ -279,12 +544,12 @@ Vector lovrPoolAllocate(Pool* pool, VectorType type, float** data) {
 
 float* lovrPoolResolve(Pool* pool, Vector vector) {
   lovrCheck(vector.handle.generation == pool->generation, "Attempt to use a temporary vector from a previous frame");
-  return pool->data + vector.handle.index;
+  return pool->data + ((size_t) vector.handle.index << 2);
 }
 
 void lovrPoolDrain(Pool* pool) {
   pool->cursor = 0;
-  pool->generation = (pool->generation + 1) & 0xf;
+  pool->generation = (pool->generation + 1) & 0x3f;
 }
 
 // RandomGenerator (compatible with LÖVE's)
@@ -302,13 +567,46 @@ static uint64_t wangHash64(uint64_t key) {
   return key;
 }
 
+static uint64_t splitmix64(uint64_t* x) {
+  uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
 // 64 bit Xorshift implementation taken from the end of Sec. 3 (page 4) in
 // George Marsaglia, "Xorshift RNGs", Journal of Statistical Software, Vol.8 (Issue 14), 2003
 // Use an 'Xorshift*' variant, as shown here: http://xorshift.di.unimi.it
+// The optional xoshiro256++ generator is from https://prng.di.unimi.it, it has a jump function
+// which can be used to split a seed into non-overlapping streams (e.g. one per thread).
+static uint64_t next(RandomGenerator* generator) {
+  if (generator->algorithm == RANDOM_XOSHIRO) {
+    uint64_t* s = generator->xoshiro;
+    uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+  } else {
+    generator->state.b64 ^= (generator->state.b64 >> 12);
+    generator->state.b64 ^= (generator->state.b64 << 25);
+    generator->state.b64 ^= (generator->state.b64 >> 27);
+    return generator->state.b64 * 2685821657736338717ULL;
+  }
+}
 
-RandomGenerator* lovrRandomGeneratorCreate(void) {
+RandomGenerator* lovrRandomGeneratorCreate(RandomAlgorithm algorithm) {
   RandomGenerator* generator = lovrCalloc(sizeof(RandomGenerator));
   generator->ref = 1;
+  generator->algorithm = algorithm;
   Seed seed = { .b32 = { .lo = 0xCBBF7A44, .hi = 0x0139408D } };
   lovrRandomGeneratorSetSeed(generator, seed);
   generator->lastRandomNormal = HUGE_VAL;
@@ -326,6 +624,14 @@ Seed lovrRandomGeneratorGetSeed(RandomGenerator* generator) {
 void lovrRandomGeneratorSetSeed(RandomGenerator* generator, Seed seed) {
   generator->seed = seed;
 
+  if (generator->algorithm == RANDOM_XOSHIRO) {
+    uint64_t x = seed.b64;
+    for (uint32_t i = 0; i < 4; i++) {
+      generator->xoshiro[i] = splitmix64(&x);
+    }
+    return;
+  }
+
   do {
     seed.b64 = wangHash64(seed.b64);
   } while (seed.b64 == 0);
@@ -334,26 +640,45 @@ void lovrRandomGeneratorSetSeed(RandomGenerator* generator, Seed seed) {
 }
 
 void lovrRandomGeneratorGetState(RandomGenerator* generator, char* state, size_t length) {
-  snprintf(state, length, "0x%" PRIx64, generator->state.b64);
+  if (generator->algorithm == RANDOM_XOSHIRO) {
+    uint64_t* s = generator->xoshiro;
+    snprintf(state, length, "0x%016" PRIx64 "%016" PRIx64 "%016" PRIx64 "%016" PRIx64, s[0], s[1], s[2], s[3]);
+  } else {
+    snprintf(state, length, "0x%" PRIx64, generator->state.b64);
+  }
 }
 
-int lovrRandomGeneratorSetState(RandomGenerator* generator, const char* state) {
+bool lovrRandomGeneratorSetState(RandomGenerator* generator, const char* state) {
+  if (generator->algorithm == RANDOM_XOSHIRO) {
+    const char* digits = state;
+    if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) digits += 2;
+    lovrCheck(strlen(digits) == 64, "Invalid random state %s", state);
+
+    uint64_t words[4];
+    for (uint32_t i = 0; i < 4; i++) {
+      char chunk[17] = { 0 };
+      char* end = NULL;
+      memcpy(chunk, digits + 16 * i, 16);
+      words[i] = strtoull(chunk, &end, 16);
+      lovrCheck(*end == 0, "Invalid random state %s", state);
+    }
+
+    // xoshiro never leaves the all zero state, seeding avoids it too
+    lovrCheck(words[0] | words[1] | words[2] | words[3], "xoshiro random state can not be all zeros");
+    memcpy(generator->xoshiro, words, sizeof(words));
+    return true;
+  }
+
   char* end = NULL;
   Seed newState;
   newState.b64 = strtoull(state, &end, 16);
-  if (end != NULL && *end != 0) {
-    return 1;
-  } else {
-    generator->state = newState;
-    return 0;
-  }
+  lovrCheck(end == NULL || *end == 0, "Invalid random state %s", state);
+  generator->state = newState;
+  return true;
 }
 
 double lovrRandomGeneratorRandom(RandomGenerator* generator) {
-  generator->state.b64 ^= (generator->state.b64 >> 12);
-  generator->state.b64 ^= (generator->state.b64 << 25);
-  generator->state.b64 ^= (generator->state.b64 >> 27);
-  uint64_t r = generator->state.b64 * 2685821657736338717ULL;
+  uint64_t r = next(generator);
   union { uint64_t i; double d; } u;
   u.i = ((0x3FFULL) << 52) | (r >> 12);
   return u.d - 1.;
@@ -373,3 +698,232 @@ double lovrRandomGeneratorRandomNormal(RandomGenerator* generator) {
   generator->lastRandomNormal = r * cos(phi);
   return r * sin(phi);
 }
+
+RandomAlgorithm lovrRandomGeneratorGetAlgorithm(RandomGenerator* generator) {
+  return generator->algorithm;
+}
+
+// Equivalent to 2^128 calls to next, used to generate non-overlapping sequences
+bool lovrRandomGeneratorJump(RandomGenerator* generator) {
+  lovrCheck(generator->algorithm == RANDOM_XOSHIRO, "Only xoshiro RandomGenerators can jump");
+
+  static const uint64_t jump[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+  uint64_t s[4] = { 0 };
+
+  for (uint32_t i = 0; i < COUNTOF(jump); i++) {
+    for (uint32_t b = 0; b < 64; b++) {
+      if (jump[i] & (1ULL << b)) {
+        for (uint32_t j = 0; j < 4; j++) {
+          s[j] ^= generator->xoshiro[j];
+        }
+      }
+      next(generator);
+    }
+  }
+
+  memcpy(generator->xoshiro, s, sizeof(s));
+  return true;
+}
+
+// Scalar distributions write one float per element, sphere distributions write a vec3
+void lovrRandomGeneratorFill(RandomGenerator* generator, float* data, size_t count, size_t stride, RandomDistribution distribution) {
+  switch (distribution) {
+    case RANDOM_UNIFORM:
+      for (size_t i = 0; i < count; i++, data += stride) {
+        *data = (float) lovrRandomGeneratorRandom(generator);
+      }
+      break;
+    case RANDOM_NORMAL:
+      for (size_t i = 0; i < count; i++, data += stride) {
+        *data = (float) lovrRandomGeneratorRandomNormal(generator);
+      }
+      break;
+    case RANDOM_IN_SPHERE:
+    case RANDOM_ON_SPHERE:
+      for (size_t i = 0; i < count; i++, data += stride) {
+        float z = (float) lovrRandomGeneratorRandom(generator) * 2.f - 1.f;
+        float phi = (float) lovrRandomGeneratorRandom(generator) * 2.f * (float) M_PI;
+        float r = sqrtf(MAX(1.f - z * z, 0.f));
+        float radius = 1.f;
+        if (distribution == RANDOM_IN_SPHERE) {
+          radius = cbrtf((float) lovrRandomGeneratorRandom(generator));
+        }
+        data[0] = r * cosf(phi) * radius;
+        data[1] = r * sinf(phi) * radius;
+        data[2] = z * radius;
+      }
+      break;
+    default: break;
+  }
+}
+
+// VectorArray
+
+// Unlike the Pool, vec3 arrays are tightly packed so they can be used as vertex data
+static const uint32_t arrayComponents[] = {
+  [V_VEC2] = 2,
+  [V_VEC3] = 3,
+  [V_VEC4] = 4,
+  [V_MAT4] = 16
+};
+
+VectorArray* lovrVectorArrayCreate(VectorType type, size_t count, float* data, void* owner, void (*destructor)(void*)) {
+  lovrCheck(type != V_QUAT && type != V_NONE && type < MAX_VECTOR_TYPES, "Unsupported VectorArray type");
+  VectorArray* array = lovrCalloc(sizeof(VectorArray));
+  array->ref = 1;
+  array->type = type;
+  array->components = arrayComponents[type];
+  array->count = count;
+
+  if (data) {
+    array->data = data;
+    array->owner = owner;
+    array->destructor = destructor;
+    lovrRetain(owner);
+  } else {
+    array->data = lovrCalloc(MAX(count, 1) * array->components * sizeof(float));
+  }
+
+  return array;
+}
+
+void lovrVectorArrayDestroy(void* ref) {
+  VectorArray* array = ref;
+  if (array->owner) {
+    lovrRelease(array->owner, array->destructor);
+  } else {
+    lovrFree(array->data);
+  }
+  lovrFree(array);
+}
+
+VectorType lovrVectorArrayGetType(VectorArray* array) {
+  return array->type;
+}
+
+size_t lovrVectorArrayGetCount(VectorArray* array) {
+  return array->count;
+}
+
+size_t lovrVectorArrayGetComponents(VectorArray* array) {
+  return array->components;
+}
+
+float* lovrVectorArrayGetData(VectorArray* array) {
+  return array->data;
+}
+
+void* lovrVectorArrayGetOwner(VectorArray* array) {
+  return array->owner;
+}
+
+// These operate on the flat float array so the compiler can vectorize them
+
+bool lovrVectorArrayAdd(VectorArray* array, VectorArray* other, float scale) {
+  lovrCheck(array->type == other->type, "VectorArray types must match");
+  lovrCheck(array->count == other->count, "VectorArray sizes must match");
+  size_t n = array->count * array->components;
+  float* restrict a = array->data;
+  const float* restrict b = other->data;
+  if (array == other) {
+    for (size_t i = 0; i < n; i++) a[i] += a[i] * scale;
+  } else {
+    for (size_t i = 0; i < n; i++) a[i] += b[i] * scale;
+  }
+  return true;
+}
+
+void lovrVectorArrayAddVector(VectorArray* array, float* vector) {
+  uint32_t c = array->components;
+  float* a = array->data;
+  for (size_t i = 0; i < array->count; i++, a += c) {
+    for (uint32_t j = 0; j < c; j++) {
+      a[j] += vector[j];
+    }
+  }
+}
+
+void lovrVectorArrayScale(VectorArray* array, float* scale) {
+  uint32_t c = array->components;
+  float* a = array->data;
+  for (size_t i = 0; i < array->count; i++, a += c) {
+    for (uint32_t j = 0; j < c; j++) {
+      a[j] *= scale[j];
+    }
+  }
+}
+
+void lovrVectorArrayTransform(VectorArray* array, float* transform) {
+  switch (array->type) {
+    case V_VEC2:
+      for (size_t i = 0; i < array->count; i++) {
+        float* v = array->data + 2 * i;
+        float p[4] = { v[0], v[1], 0.f };
+        mat4_mulPoint(transform, p);
+        v[0] = p[0];
+        v[1] = p[1];
+      }
+      break;
+    case V_VEC3: mat4_mulPoint_n(transform, array->data, array->count, 3); break;
+    case V_VEC4:
+      for (size_t i = 0; i < array->count; i++) {
+        mat4_mulVec4(transform, array->data + 4 * i);
+      }
+      break;
+    case V_MAT4:
+      for (size_t i = 0; i < array->count; i++) {
+        float* m = array->data + 16 * i;
+        float result[16];
+        mat4_mul(mat4_init(result, transform), m);
+        mat4_init(m, result);
+      }
+      break;
+    default: break;
+  }
+}
+
+void lovrVectorArrayNormalize(VectorArray* array) {
+  uint32_t c = array->type == V_MAT4 ? 0 : array->components;
+  float* a = array->data;
+  for (size_t i = 0; i < array->count; i++, a += c) {
+    float length2 = 0.f;
+    for (uint32_t j = 0; j < c; j++) {
+      length2 += a[j] * a[j];
+    }
+    if (length2 > 0.f) {
+      float scale = 1.f / sqrtf(length2);
+      for (uint32_t j = 0; j < c; j++) {
+        a[j] *= scale;
+      }
+    }
+  }
+}
+
+bool lovrVectorArrayLerp(VectorArray* array, VectorArray* other, float t) {
+  lovrCheck(array->type == other->type, "VectorArray types must match");
+  lovrCheck(array->count == other->count, "VectorArray sizes must match");
+  size_t n = array->count * array->components;
+  float* a = array->data;
+  const float* b = other->data;
+  for (size_t i = 0; i < n; i++) {
+    a[i] += (b[i] - a[i]) * t;
+  }
+  return true;
+}
+
+void lovrVectorArrayGetBounds(VectorArray* array, float* min, float* max) {
+  uint32_t c = array->components;
+  const float* a = array->data;
+
+  for (uint32_t j = 0; j < c; j++) {
+    min[j] = array->count > 0 ? a[j] : 0.f;
+    max[j] = array->count > 0 ? a[j] : 0.f;
+  }
+
+  for (size_t i = 0; i < array->count; i++, a += c) {
+    for (uint32_t j = 0; j < c; j++) {
+      min[j] = MIN(min[j], a[j]);
+      max[j] = MAX(max[j], a[j]);
+    }
+  }
+}
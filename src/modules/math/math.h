@@ -7,6 +7,17 @@
 typedef struct Curve Curve;
 typedef struct Pool Pool;
 typedef struct RandomGenerator RandomGenerator;
+typedef struct VectorArray VectorArray;
+
+typedef struct {
+  uint32_t dimensions;
+  uint32_t size[3];
+  float frequency;
+  uint32_t octaves;
+  float lacunarity;
+  float gain;
+  float offset[3];
+} NoiseInfo;
 
 bool lovrMathInit(void);
 void lovrMathDestroy(void);
@@ -16,6 +27,7 @@ double lovrMathNoise1(double x);
 double lovrMathNoise2(double x, double y);
 double lovrMathNoise3(double x, double y, double z);
 double lovrMathNoise4(double x, double y, double z, double w);
+bool lovrMathNoiseField(NoiseInfo* info, float* data);
 RandomGenerator* lovrMathGetRandomGenerator(void);
 
 // Curve
@@ -23,6 +35,9 @@ RandomGenerator* lovrMathGetRandomGenerator(void);
 Curve* lovrCurveCreate(void);
 void lovrCurveDestroy(void* ref);
 bool lovrCurveEvaluate(Curve* curve, float t, float* point);
+bool lovrCurveEvaluateMany(Curve* curve, float t1, float t2, size_t count, bool uniform, float* points, size_t stride);
+bool lovrCurveEvaluateDistance(Curve* curve, float distance, float* point);
+float lovrCurveGetLength(Curve* curve);
 void lovrCurveGetTangent(Curve* curve, float t, float* point);
 Curve* lovrCurveSlice(Curve* curve, float t1, float t2);
 size_t lovrCurveGetPointCount(Curve* curve);
@@ -43,13 +58,13 @@ typedef enum {
   MAX_VECTOR_TYPES
 } VectorType;
 
+// The handle has to fit in a 32 bit pointer, so the index counts groups of 4 floats
 typedef union {
   void* pointer;
   struct {
     unsigned type : 4;
-    unsigned generation : 4;
-    unsigned index : 24;
-    unsigned padding : 32;
+    unsigned index : 22;
+    unsigned generation : 6;
   } handle;
 } Vector;
 
@@ -70,11 +85,43 @@ typedef union {
   } b32;
 } Seed;
 
-RandomGenerator* lovrRandomGeneratorCreate(void);
+typedef enum {
+  RANDOM_XORSHIFT,
+  RANDOM_XOSHIRO
+} RandomAlgorithm;
+
+typedef enum {
+  RANDOM_UNIFORM,
+  RANDOM_NORMAL,
+  RANDOM_IN_SPHERE,
+  RANDOM_ON_SPHERE
+} RandomDistribution;
+
+RandomGenerator* lovrRandomGeneratorCreate(RandomAlgorithm algorithm);
 void lovrRandomGeneratorDestroy(void* ref);
 Seed lovrRandomGeneratorGetSeed(RandomGenerator* generator);
 void lovrRandomGeneratorSetSeed(RandomGenerator* generator, Seed seed);
 void lovrRandomGeneratorGetState(RandomGenerator* generator, char* state, size_t length);
-int lovrRandomGeneratorSetState(RandomGenerator* generator, const char* state);
+bool lovrRandomGeneratorSetState(RandomGenerator* generator, const char* state);
 double lovrRandomGeneratorRandom(RandomGenerator* generator);
 double lovrRandomGeneratorRandomNormal(RandomGenerator* generator);
+RandomAlgorithm lovrRandomGeneratorGetAlgorithm(RandomGenerator* generator);
+bool lovrRandomGeneratorJump(RandomGenerator* generator);
+void lovrRandomGeneratorFill(RandomGenerator* generator, float* data, size_t count, size_t stride, RandomDistribution distribution);
+
+// VectorArray
+
+VectorArray* lovrVectorArrayCreate(VectorType type, size_t count, float* data, void* owner, void (*destructor)(void*));
+void lovrVectorArrayDestroy(void* ref);
+VectorType lovrVectorArrayGetType(VectorArray* array);
+size_t lovrVectorArrayGetCount(VectorArray* array);
+size_t lovrVectorArrayGetComponents(VectorArray* array);
+float* lovrVectorArrayGetData(VectorArray* array);
+void* lovrVectorArrayGetOwner(VectorArray* array);
+bool lovrVectorArrayAdd(VectorArray* array, VectorArray* other, float scale);
+void lovrVectorArrayAddVector(VectorArray* array, float* vector);
+void lovrVectorArrayScale(VectorArray* array, float* scale);
+void lovrVectorArrayTransform(VectorArray* array, float* transform);
+void lovrVectorArrayNormalize(VectorArray* array);
+bool lovrVectorArrayLerp(VectorArray* array, VectorArray* other, float t);
+void lovrVectorArrayGetBounds(VectorArray* array, float* min, float* max);
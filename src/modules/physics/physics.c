@@ -8,6 +8,8 @@
 #include <threads.h>
 #include <joltc.h>
 
+#define MAX_CACHED_SHAPES 64
+
 struct Contact {
   uint32_t ref;
   Collider* colliderA;
@@ -22,15 +24,22 @@ struct World {
   JPH_BodyInterface* bodyInterfaceLocked;
   JPH_BodyInterface* bodyInterfaceNoLock;
   JPH_BodyActivationListener* activationListener;
+  JPH_BroadPhaseLayerFilter* broadPhaseLayerFilter;
+  JPH_ObjectLayerFilter* objectLayerFilter;
   JPH_ObjectLayerPairFilter* objectLayerPairFilter;
   JPH_ContactListener* listener;
   Contact contact;
   Collider* colliders;
+  uint32_t colliderSerial;
   Collider** activeColliders;
   uint32_t activeColliderCount;
   Joint* joints;
   uint32_t jointCount;
   WorldCallbacks callbacks;
+  ContactRecord* contacts;
+  uint32_t contactCount;
+  uint32_t contactCapacity;
+  uint32_t contactsDropped;
   float defaultLinearDamping;
   float defaultAngularDamping;
   bool defaultIsSleepingAllowed;
@@ -43,6 +52,11 @@ struct World {
   JPH_JobSystem* jobSystem;
   uint32_t jobCount;
   job* jobs[1024];
+  job* step;
+  float stepDelta;
+  uint32_t stepId;
+  uint32_t poseTick; // Atomic, stamped on colliders that are moved directly or fall asleep
+  bool updating;
   mtx_t lock;
 };
 
@@ -58,10 +72,16 @@ struct Collider {
   uint8_t tag;
   bool enabled;
   bool automaticMass;
+  uint32_t poseTick;
+  uint32_t serial; // Creation order in the World, identifies the Collider in saved states
   uint32_t activeIndex;
+  uint32_t snapshotId;
+  bool snapshotAwake;
   uintptr_t userdata;
   float lastPosition[4];
   float lastOrientation[4];
+  float lastLinearVelocity[4];
+  float lastAngularVelocity[4];
 };
 
 struct Shape {
@@ -89,9 +109,17 @@ struct Joint {
   JointNode a, b, world;
 };
 
+typedef struct {
+  uint64_t hash;
+  JPH_Shape* shape;
+  ShapeType type;
+  uint32_t vertexCount;
+  uint32_t indexCount;
+  uint64_t lastUsed;
+} CachedShape;
+
+// The World's query filters are shared by every thread, they read the mask of the thread querying
 static thread_local struct {
-  JPH_BroadPhaseLayerFilter* broadPhaseLayerFilter;
-  JPH_ObjectLayerFilter* objectLayerFilter;
   uint32_t broadPhaseLayerMask;
   uint32_t objectLayerMask;
   bool locked;
@@ -101,6 +129,11 @@ static struct {
   bool initialized;
   JPH_Shape* emptyShape;
   void (*freeUserData)(void* object, uintptr_t userdata);
+  bool shapeCacheEnabled;
+  arr_t(CachedShape) shapeCache;
+  uint64_t shapeCacheTick;
+  uint32_t shapeCacheHits;
+  mtx_t shapeCacheLock;
 } state;
 
 #define vec3_toJolt(v) &(JPH_Vec3) { v[0], v[1], v[2] }
@@ -108,12 +141,18 @@ static struct {
 #define quat_toJolt(q) &(JPH_Quat) { q[0], q[1], q[2], q[3] }
 #define quat_fromJolt(q, j) quat_set(q, (j)->x, (j)->y, (j)->z, (j)->w)
 
+#define lovrCheckIdle(world) lovrCheck(!(world)->updating, "World is updating, call World:sync first")
+#define lovrCheckJointIdle(joint) lovrCheckIdle(lovrJointGetColliderB(joint)->world)
+
 enum { READ, WRITE };
 
 static JPH_BodyInterface* getBodyInterface(Collider* collider, int access) {
   if (thread.locked) {
     lovrCheck(access == READ, "Tried to write to a Collider inside a collision callback");
     return collider->world->bodyInterfaceNoLock;
+  } else if (collider->world->updating) {
+    lovrCheck(access == READ, "Tried to write to a Collider while its World is updating");
+    return collider->world->bodyInterfaceNoLock;
   } else {
     return collider->world->bodyInterfaceLocked;
   }
@@ -169,17 +208,10 @@ static bool broadPhaseLayerFilter(void* userdata, JPH_BroadPhaseLayer layer) {
 }
 
 static JPH_BroadPhaseLayerFilter* getBroadPhaseLayerFilter(World* world, uint32_t filter) {
-  if (!thread.broadPhaseLayerFilter) {
-    thread.broadPhaseLayerFilter = JPH_BroadPhaseLayerFilter_Create((JPH_BroadPhaseLayerFilter_Procs) {
-      .ShouldCollide = broadPhaseLayerFilter
-    }, NULL);
-  }
-
   thread.broadPhaseLayerMask = 0;
   if (~world->staticTagMask & filter) thread.broadPhaseLayerMask |= 0x1;
   if ( world->staticTagMask & filter) thread.broadPhaseLayerMask |= 0x3;
-
-  return thread.broadPhaseLayerFilter;
+  return world->broadPhaseLayerFilter;
 }
 
 static bool objectLayerFilter(void* userdata, JPH_ObjectLayer layer) {
@@ -187,15 +219,9 @@ static bool objectLayerFilter(void* userdata, JPH_ObjectLayer layer) {
 }
 
 static JPH_ObjectLayerFilter* getObjectLayerFilter(World* world, uint32_t filter) {
-  if (!thread.objectLayerFilter) {
-    thread.objectLayerFilter = JPH_ObjectLayerFilter_Create((JPH_ObjectLayerFilter_Procs) {
-      .ShouldCollide = objectLayerFilter
-    }, NULL);
-  }
-
   // Never include objects on the last layer, reserved for colliders without shapes
   thread.objectLayerMask = filter & ~(1 << (world->tagCount + 1));
-  return thread.objectLayerFilter;
+  return world->objectLayerFilter;
 }
 
 static void onAwake(void* arg, JPH_BodyID id, uint64_t userData) {
@@ -218,6 +244,7 @@ static void onSleep(void* arg, JPH_BodyID id, uint64_t userData) {
   }
   world->activeColliderCount--;
   collider->activeIndex = ~0u;
+  collider->poseTick = atomic_load(&world->poseTick);
   mtx_unlock(&world->lock);
 }
 
@@ -235,13 +262,54 @@ static JPH_ValidateResult onContactValidate(void* userdata, const JPH_Body* body
     JPH_ValidateResult_RejectAllContactsForThisBodyPair;
 }
 
+// Buffered contacts are appended from the solver threads with an atomic cursor and read after the
+// step, records past the capacity are dropped and the buffer grows before the next step
+static void bufferContact(World* world, ContactEvent event, Collider* a, Collider* b, const JPH_ContactManifold* manifold) {
+  uint32_t index = atomic_fetch_add(&world->contactCount, 1);
+
+  if (index >= world->contactCapacity) {
+    return;
+  }
+
+  ContactRecord* record = &world->contacts[index];
+  record->event = event;
+  record->colliderA = a;
+  record->colliderB = b;
+
+  if (manifold) {
+    JPH_Vec3 n, p;
+    JPH_ContactManifold_GetWorldSpaceNormal(manifold, &n);
+    vec3_fromJolt(record->normal, &n);
+    record->overlap = JPH_ContactManifold_GetPenetrationDepth(manifold);
+
+    uint32_t count = JPH_ContactManifold_GetPointCount(manifold);
+    vec3_set(record->position, 0.f, 0.f, 0.f);
+    for (uint32_t i = 0; i < count; i++) {
+      JPH_ContactManifold_GetWorldSpaceContactPointOn2(manifold, i, &p);
+      record->position[0] += p.x;
+      record->position[1] += p.y;
+      record->position[2] += p.z;
+    }
+    if (count > 0) vec3_scale(record->position, 1.f / count);
+  } else {
+    vec3_set(record->position, 0.f, 0.f, 0.f);
+    vec3_set(record->normal, 0.f, 0.f, 0.f);
+    record->overlap = 0.f;
+  }
+}
+
 static void onContactPersisted(void* userdata, const JPH_Body* body1, const JPH_Body* body2, const JPH_ContactManifold* manifold, JPH_ContactSettings* settings) {
   World* world = userdata;
   JPH_BodyID id1 = JPH_Body_GetID(body1);
   JPH_BodyID id2 = JPH_Body_GetID(body2);
+  Collider* a = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body1);
+  Collider* b = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body2);
+
+  if (world->contacts) {
+    bufferContact(world, CONTACT_PERSIST, a, b, manifold);
+  }
+
   if (world->callbacks.contact) {
-    Collider* a = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body1);
-    Collider* b = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body2);
     mtx_lock(&world->lock);
     thread.locked = true;
     world->contact.colliderA = a;
@@ -259,18 +327,25 @@ static void onContactAdded(void* userdata, const JPH_Body* body1, const JPH_Body
   JPH_BodyID id1 = JPH_Body_GetID(body1);
   JPH_BodyID id2 = JPH_Body_GetID(body2);
 
-  if (world->callbacks.enter && !JPH_PhysicsSystem_WereBodiesInContact(world->system, id1, id2)) {
+  if ((world->contacts || world->callbacks.enter) && !JPH_PhysicsSystem_WereBodiesInContact(world->system, id1, id2)) {
     Collider* a = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body1);
     Collider* b = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body2);
-    mtx_lock(&world->lock);
-    thread.locked = true;
-    world->contact.colliderA = a;
-    world->contact.colliderB = b;
-    world->contact.manifold = manifold;
-    world->contact.settings = settings;
-    world->callbacks.enter(world->callbacks.userdata, world, a, b, &world->contact);
-    thread.locked = false;
-    mtx_unlock(&world->lock);
+
+    if (world->contacts) {
+      bufferContact(world, CONTACT_ENTER, a, b, manifold);
+    }
+
+    if (world->callbacks.enter) {
+      mtx_lock(&world->lock);
+      thread.locked = true;
+      world->contact.colliderA = a;
+      world->contact.colliderB = b;
+      world->contact.manifold = manifold;
+      world->contact.settings = settings;
+      world->callbacks.enter(world->callbacks.userdata, world, a, b, &world->contact);
+      thread.locked = false;
+      mtx_unlock(&world->lock);
+    }
   }
 
   onContactPersisted(userdata, body1, body2, manifold, settings);
@@ -283,11 +358,17 @@ static void onContactRemoved(void* userdata, const JPH_SubShapeIDPair* pair) {
     Collider* a = (Collider*) (uintptr_t) JPH_BodyInterface_GetUserData(interface, pair->Body1ID);
     Collider* b = (Collider*) (uintptr_t) JPH_BodyInterface_GetUserData(interface, pair->Body2ID);
     if (a && b) {
-      mtx_lock(&world->lock);
-      thread.locked = true;
-      world->callbacks.exit(world->callbacks.userdata, world, a, b);
-      thread.locked = false;
-      mtx_unlock(&world->lock);
+      if (world->contacts) {
+        bufferContact(world, CONTACT_EXIT, a, b, NULL);
+      }
+
+      if (world->callbacks.exit) {
+        mtx_lock(&world->lock);
+        thread.locked = true;
+        world->callbacks.exit(world->callbacks.userdata, world, a, b);
+        thread.locked = false;
+        mtx_unlock(&world->lock);
+      }
     }
   }
 }
@@ -322,16 +403,124 @@ bool lovrPhysicsInit(void (*freeUserData)(void* object, uintptr_t userdata)) {
   state.emptyShape = (JPH_Shape*) JPH_EmptyShapeSettings_CreateShape(settings);
   JPH_ShapeSettings_Destroy((JPH_ShapeSettings*) settings);
   state.freeUserData = freeUserData;
+  arr_init(&state.shapeCache);
+  mtx_init(&state.shapeCacheLock, mtx_plain);
   return state.initialized = true;
 }
 
 void lovrPhysicsDestroy(void) {
   if (!state.initialized) return;
+  lovrPhysicsClearShapeCache();
+  arr_free(&state.shapeCache);
+  mtx_destroy(&state.shapeCacheLock);
   JPH_Shape_Destroy(state.emptyShape);
   JPH_Shutdown();
   state.initialized = false;
 }
 
+// Convex hulls and mesh BVHs are expensive to build, so they can be cached by the hash of their
+// input geometry.  The cache is off by default, holds a reference to at most MAX_CACHED_SHAPES baked
+// shapes, and evicts the least recently used one when it's full.  Shapes created from a cached
+// shape hold their own reference, so eviction never invalidates them.
+
+bool lovrPhysicsIsShapeCacheEnabled(void) {
+  return state.shapeCacheEnabled;
+}
+
+void lovrPhysicsSetShapeCacheEnabled(bool enable) {
+  state.shapeCacheEnabled = enable;
+  if (!enable) lovrPhysicsClearShapeCache();
+}
+
+void lovrPhysicsClearShapeCache(void) {
+  mtx_lock(&state.shapeCacheLock);
+  for (size_t i = 0; i < state.shapeCache.length; i++) {
+    JPH_Shape_Destroy(state.shapeCache.data[i].shape);
+  }
+  arr_clear(&state.shapeCache);
+  state.shapeCacheHits = 0;
+  mtx_unlock(&state.shapeCacheLock);
+}
+
+void lovrPhysicsGetShapeCacheStats(uint32_t* count, uint32_t* hits) {
+  mtx_lock(&state.shapeCacheLock);
+  *count = (uint32_t) state.shapeCache.length;
+  *hits = state.shapeCacheHits;
+  mtx_unlock(&state.shapeCacheLock);
+}
+
+static uint64_t hashGeometry(const float* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+  uint64_t hash = hash64(vertices, vertexCount * 3 * sizeof(float));
+  if (indices) hash ^= hash64(indices, indexCount * sizeof(uint32_t)) * 0x100000001b3;
+  return hash;
+}
+
+// Caller holds the lock.  The counts are compared too, so a hash collision between different
+// geometry needs the same number of vertices and indices to go unnoticed.
+static CachedShape* findCachedShape(ShapeType type, uint64_t hash, uint32_t vertexCount, uint32_t indexCount) {
+  for (size_t i = 0; i < state.shapeCache.length; i++) {
+    CachedShape* entry = &state.shapeCache.data[i];
+    if (entry->hash == hash && entry->type == type && entry->vertexCount == vertexCount && entry->indexCount == indexCount) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+// Wraps a cached shape in a ScaledShape, returns NULL if it isn't cached
+static JPH_Shape* createCachedShape(ShapeType type, uint64_t hash, uint32_t vertexCount, uint32_t indexCount, float scale) {
+  if (!state.shapeCacheEnabled) return NULL;
+  float scale3[3] = { scale, scale, scale };
+  JPH_Shape* shape = NULL;
+  mtx_lock(&state.shapeCacheLock);
+  CachedShape* entry = findCachedShape(type, hash, vertexCount, indexCount);
+  if (entry) {
+    shape = (JPH_Shape*) JPH_ScaledShape_Create(entry->shape, vec3_toJolt(scale3));
+    entry->lastUsed = ++state.shapeCacheTick;
+    state.shapeCacheHits++;
+  }
+  mtx_unlock(&state.shapeCacheLock);
+  return shape;
+}
+
+// Takes ownership of the shape's reference
+static void cacheShape(ShapeType type, uint64_t hash, uint32_t vertexCount, uint32_t indexCount, JPH_Shape* shape) {
+  if (!state.shapeCacheEnabled) {
+    JPH_Shape_Destroy(shape);
+    return;
+  }
+
+  mtx_lock(&state.shapeCacheLock);
+
+  if (findCachedShape(type, hash, vertexCount, indexCount)) {
+    JPH_Shape_Destroy(shape);
+    mtx_unlock(&state.shapeCacheLock);
+    return;
+  }
+
+  if (state.shapeCache.length >= MAX_CACHED_SHAPES) {
+    size_t oldest = 0;
+    for (size_t i = 1; i < state.shapeCache.length; i++) {
+      if (state.shapeCache.data[i].lastUsed < state.shapeCache.data[oldest].lastUsed) {
+        oldest = i;
+      }
+    }
+    JPH_Shape_Destroy(state.shapeCache.data[oldest].shape);
+    state.shapeCache.data[oldest] = state.shapeCache.data[--state.shapeCache.length];
+  }
+
+  arr_push(&state.shapeCache, ((CachedShape) {
+    .hash = hash,
+    .shape = shape,
+    .type = type,
+    .vertexCount = vertexCount,
+    .indexCount = indexCount,
+    .lastUsed = ++state.shapeCacheTick
+  }));
+
+  mtx_unlock(&state.shapeCacheLock);
+}
+
 World* lovrWorldCreate(WorldInfo* info) {
   World* world = lovrCalloc(sizeof(World));
 
@@ -368,7 +557,7 @@ World* lovrWorldCreate(WorldInfo* info) {
     }
   }
 
-  JPH_ObjectVsBroadPhaseLayerFilter* broadPhaseLayerFilter = JPH_ObjectVsBroadPhaseLayerFilterTable_Create(
+  JPH_ObjectVsBroadPhaseLayerFilter* objectVsBroadPhaseLayerFilter = JPH_ObjectVsBroadPhaseLayerFilterTable_Create(
     broadPhaseLayerInterface, broadPhaseLayerCount,
     world->objectLayerPairFilter, objectLayerCount);
 
@@ -378,7 +567,7 @@ World* lovrWorldCreate(WorldInfo* info) {
     .maxContactConstraints = info->maxColliders,
     .broadPhaseLayerInterface = broadPhaseLayerInterface,
     .objectLayerPairFilter = world->objectLayerPairFilter,
-    .objectVsBroadPhaseLayerFilter = broadPhaseLayerFilter
+    .objectVsBroadPhaseLayerFilter = objectVsBroadPhaseLayerFilter
   };
 
   world->system = JPH_PhysicsSystem_Create(&config);
@@ -414,6 +603,14 @@ World* lovrWorldCreate(WorldInfo* info) {
 
   JPH_PhysicsSystem_SetBodyActivationListener(world->system, world->activationListener);
 
+  world->broadPhaseLayerFilter = JPH_BroadPhaseLayerFilter_Create((JPH_BroadPhaseLayerFilter_Procs) {
+    .ShouldCollide = broadPhaseLayerFilter
+  }, NULL);
+
+  world->objectLayerFilter = JPH_ObjectLayerFilter_Create((JPH_ObjectLayerFilter_Procs) {
+    .ShouldCollide = objectLayerFilter
+  }, NULL);
+
   return world;
 }
 
@@ -428,6 +625,8 @@ void lovrWorldDestruct(World* world) {
     return;
   }
 
+  lovrWorldSync(world);
+
   while (world->colliders) {
     Collider* collider = world->colliders;
     Collider* next = collider->next;
@@ -437,7 +636,10 @@ void lovrWorldDestruct(World* world) {
 
   if (world->listener) JPH_ContactListener_Destroy(world->listener);
   JPH_BodyActivationListener_Destroy(world->activationListener);
+  JPH_BroadPhaseLayerFilter_Destroy(world->broadPhaseLayerFilter);
+  JPH_ObjectLayerFilter_Destroy(world->objectLayerFilter);
   lovrFree(world->activeColliders);
+  lovrFree(world->contacts);
 
   for (uint32_t i = 0; i < world->tagCount; i++) {
     lovrFree(world->tags[i]);
@@ -505,38 +707,327 @@ void lovrWorldGetGravity(World* world, float gravity[3]) {
   vec3_fromJolt(gravity, &g);
 }
 
-void lovrWorldSetGravity(World* world, float gravity[3]) {
+bool lovrWorldSetGravity(World* world, float gravity[3]) {
+  lovrCheckIdle(world);
   JPH_PhysicsSystem_SetGravity(world->system, vec3_toJolt(gravity));
+  return true;
 }
 
-void lovrWorldUpdate(World* world, float dt) {
-  for (uint32_t i = 0; i < world->activeColliderCount; i++) {
-    Collider* collider = world->activeColliders[i];
+// Saves the pose and velocity of a collider before a step, used for interpolation and for reads while
+// an asynchronous step is in flight
+static void snapshotCollider(Collider* collider, bool awake) {
+  JPH_RVec3 position;
+  JPH_Body_GetPosition(collider->body, &position);
+  vec3_fromJolt(collider->lastPosition, &position);
 
-    JPH_RVec3 position;
-    JPH_Body_GetPosition(collider->body, &position);
-    vec3_fromJolt(collider->lastPosition, &position);
+  JPH_Quat orientation;
+  JPH_Body_GetRotation(collider->body, &orientation);
+  quat_fromJolt(collider->lastOrientation, &orientation);
 
-    JPH_Quat orientation;
-    JPH_Body_GetRotation(collider->body, &orientation);
-    quat_fromJolt(collider->lastOrientation, &orientation);
+  JPH_Vec3 velocity;
+  JPH_Body_GetLinearVelocity(collider->body, &velocity);
+  vec3_fromJolt(collider->lastLinearVelocity, &velocity);
+  JPH_Body_GetAngularVelocity(collider->body, &velocity);
+  vec3_fromJolt(collider->lastAngularVelocity, &velocity);
+
+  collider->snapshotId = collider->world->stepId;
+  collider->snapshotAwake = awake;
+}
+
+static void beginStep(World* world, float dt) {
+  world->stepId++;
+  world->stepDelta = dt;
+  world->contactCount = 0;
+  world->contactsDropped = 0;
+
+  for (uint32_t i = 0; i < world->activeColliderCount; i++) {
+    snapshotCollider(world->activeColliders[i], true);
   }
+}
+
+static void stepJob(void* arg) {
+  World* world = arg;
 
-  JPH_PhysicsSystem_Update(world->system, dt, 1, world->jobSystem);
+  JPH_PhysicsSystem_Update(world->system, world->stepDelta, 1, world->jobSystem);
 
   for (uint32_t i = 0; i < world->jobCount; i++) {
     job_wait(world->jobs[i]);
   }
+}
 
-  world->inverseDelta = 1.f / dt;
+static void endStep(World* world) {
+  if (world->contactCount > world->contactCapacity) {
+    world->contactsDropped = world->contactCount - world->contactCapacity;
+    world->contactCount = world->contactCapacity;
+    while (world->contactCapacity < world->contactCount + world->contactsDropped) world->contactCapacity <<= 1;
+    world->contacts = lovrRealloc(world->contacts, world->contactCapacity * sizeof(ContactRecord));
+  }
+
+  world->inverseDelta = 1.f / world->stepDelta;
   world->interpolation = 0.f;
   world->jobCount = 0;
 }
 
+bool lovrWorldUpdate(World* world, float dt) {
+  lovrCheckIdle(world);
+  beginStep(world, dt);
+  stepJob(world);
+  endStep(world);
+  return true;
+}
+
+bool lovrWorldUpdateAsync(World* world, float dt) {
+  lovrCheckIdle(world);
+  WorldCallbacks* callbacks = &world->callbacks;
+  bool hasCallbacks = callbacks->filter || callbacks->enter || callbacks->exit || callbacks->contact;
+  lovrCheck(!hasCallbacks, "World:updateAsync can not be used when collision callbacks are set");
+  beginStep(world, dt);
+
+  // Sleeping colliders can be woken up and moved by the step, so reads during the step use a
+  // snapshot of every collider instead of touching Jolt's bodies
+  for (Collider* collider = world->colliders; collider; collider = collider->next) {
+    if (collider->snapshotId != world->stepId) {
+      snapshotCollider(collider, false);
+    }
+  }
+
+  world->updating = true;
+  world->step = job_start(stepJob, world);
+  return true;
+}
+
+void lovrWorldSync(World* world) {
+  if (!world->updating) return;
+  job_wait(world->step);
+  world->step = NULL;
+  world->updating = false;
+  endStep(world);
+}
+
+bool lovrWorldIsUpdating(World* world) {
+  return world->updating;
+}
+
 void lovrWorldInterpolate(World* world, float alpha) {
   world->interpolation = 1.f - alpha;
 }
 
+// Poses are written as a vec4 position and a quaternion, or a mat4, to match std430 layout
+void lovrWorldGetPoses(World* world, Collider** colliders, uint32_t count, float* data, bool matrices) {
+  uint32_t stride = matrices ? 16 : 8;
+  for (uint32_t i = 0; i < count; i++, data += stride) {
+    Collider* collider = colliders[i];
+    float position[4], orientation[4];
+
+    if (world->updating) {
+      vec3_init(position, collider->lastPosition);
+      quat_init(orientation, collider->lastOrientation);
+    } else {
+      JPH_RVec3 p;
+      JPH_Quat q;
+      JPH_Body_GetPosition(collider->body, &p);
+      JPH_Body_GetRotation(collider->body, &q);
+      vec3_fromJolt(position, &p);
+      quat_fromJolt(orientation, &q);
+    }
+
+    position[3] = 1.f;
+
+    if (!world->updating && collider->activeIndex != ~0u && world->interpolation != 0.f) {
+      vec3_lerp(position, collider->lastPosition, world->interpolation);
+      quat_slerp(orientation, collider->lastOrientation, world->interpolation);
+    }
+
+    if (matrices) {
+      mat4_fromPose(data, position, orientation);
+    } else {
+      vec4_init(data, position);
+      quat_init(data + 4, orientation);
+    }
+  }
+}
+
+// Pose exports are incremental per target: each export gets a new tick, and the next export to the
+// same target only writes colliders that are awake or were stamped with a tick at least that new
+uint32_t lovrWorldAdvancePoseTick(World* world) {
+  return atomic_fetch_add(&world->poseTick, 1) + 1;
+}
+
+// World state is a header, a bitmask of the colliders that are present (all of them unless the
+// state is a delta against a base state), and the collider records.  Records store the serial of
+// their collider, so a state only restores onto the colliders it was saved from (or onto a World
+// that created the same colliders in the same order).  Only poses, velocities, and sleep states are
+// saved.  Jolt's contact cache isn't, so the first step after a restore can come
+// out slightly different from the original one.  Constraint state isn't either, so Worlds with
+// joints are rejected instead of restoring joints with stale impulses and motor state.
+
+#define STATE_MAGIC 0x534c5744 // 'DWLS'
+#define STATE_DELTA 0x1
+
+typedef struct {
+  uint32_t magic;
+  uint32_t flags;
+  uint32_t colliderCount;
+} StateHeader;
+
+typedef struct {
+  uint32_t serial;
+  float position[3];
+  float orientation[4];
+  float linearVelocity[3];
+  float angularVelocity[3];
+  uint32_t awake;
+} ColliderState;
+
+static const StateHeader* checkState(World* world, const void* data, size_t size) {
+  const StateHeader* header = data;
+  lovrCheck(size >= sizeof(StateHeader) && header->magic == STATE_MAGIC, "Invalid World state");
+  lovrCheck(header->colliderCount == lovrWorldGetColliderCount(world), "World state does not match the World's colliders");
+  uint32_t maskSize = (header->colliderCount + 31) / 32 * sizeof(uint32_t);
+  size_t maxSize = sizeof(StateHeader) + maskSize + header->colliderCount * sizeof(ColliderState);
+  lovrCheck(size <= maxSize && size >= sizeof(StateHeader) + maskSize, "Invalid World state");
+  return header;
+}
+
+size_t lovrWorldGetStateSize(World* world) {
+  uint32_t count = lovrWorldGetColliderCount(world);
+  return sizeof(StateHeader) +
+    (count + 31) / 32 * sizeof(uint32_t) +
+    count * sizeof(ColliderState);
+}
+
+bool lovrWorldSaveState(World* world, void* data, size_t* size, const void* base, size_t baseSize) {
+  lovrCheckIdle(world);
+  lovrCheck(world->jointCount == 0, "The state of a World with joints can not be saved");
+
+  uint32_t count = lovrWorldGetColliderCount(world);
+  uint32_t words = (count + 31) / 32;
+  const StateHeader* baseHeader = NULL;
+  const ColliderState* baseColliders = NULL;
+
+  if (base) {
+    baseHeader = checkState(world, base, baseSize);
+    if (!baseHeader) return false;
+    lovrCheck(baseSize == lovrWorldGetStateSize(world) && (~baseHeader->flags & STATE_DELTA), "Base World state can not be a delta");
+    baseColliders = (const ColliderState*) ((const uint32_t*) (baseHeader + 1) + words);
+  }
+
+  StateHeader* header = data;
+  header->magic = STATE_MAGIC;
+  header->flags = base ? STATE_DELTA : 0;
+  header->colliderCount = count;
+
+  uint32_t* mask = (uint32_t*) (header + 1);
+  memset(mask, 0, words * sizeof(uint32_t));
+
+  ColliderState* record = (ColliderState*) (mask + words);
+  JPH_BodyInterface* interface = world->bodyInterfaceNoLock;
+
+  uint32_t index = 0;
+  for (Collider* collider = world->colliders; collider; collider = collider->next, index++) {
+    lovrCheck(!base || baseColliders[index].serial == collider->serial, "Base World state does not match the World's colliders");
+
+    JPH_RVec3 p;
+    JPH_Quat q;
+    JPH_Vec3 v, w;
+    JPH_BodyInterface_GetPositionAndRotation(interface, collider->id, &p, &q);
+    JPH_BodyInterface_GetLinearVelocity(interface, collider->id, &v);
+    JPH_BodyInterface_GetAngularVelocity(interface, collider->id, &w);
+    record->serial = collider->serial;
+    vec3_fromJolt(record->position, &p);
+    quat_fromJolt(record->orientation, &q);
+    vec3_fromJolt(record->linearVelocity, &v);
+    vec3_fromJolt(record->angularVelocity, &w);
+    record->awake = collider->activeIndex != ~0u;
+
+    if (base && !memcmp(record, &baseColliders[index], sizeof(ColliderState))) {
+      continue;
+    }
+
+    mask[index / 32] |= 1u << (index % 32);
+    record++;
+  }
+
+  *size = (char*) record - (char*) data;
+  return true;
+}
+
+bool lovrWorldRestoreState(World* world, const void* data, size_t size, const void* base, size_t baseSize) {
+  lovrCheckIdle(world);
+  lovrCheck(world->jointCount == 0, "The state of a World with joints can not be restored");
+
+  const StateHeader* header = checkState(world, data, size);
+  if (!header) return false;
+
+  uint32_t words = (header->colliderCount + 31) / 32;
+  const uint32_t* mask = (const uint32_t*) (header + 1);
+  const ColliderState* record = (const ColliderState*) (mask + words);
+  const ColliderState* baseRecord = NULL;
+
+  if (header->flags & STATE_DELTA) {
+    lovrCheck(base, "A base World state is required to restore a delta");
+    const StateHeader* baseHeader = checkState(world, base, baseSize);
+    if (!baseHeader) return false;
+    lovrCheck(baseSize == lovrWorldGetStateSize(world) && (~baseHeader->flags & STATE_DELTA), "Base World state can not be a delta");
+    baseRecord = (const ColliderState*) ((const uint32_t*) (baseHeader + 1) + words);
+  }
+
+  uint32_t changed = 0;
+  for (uint32_t i = 0; i < header->colliderCount; i++) {
+    changed += (mask[i / 32] >> (i % 32)) & 1;
+  }
+
+  lovrCheck(size == sizeof(StateHeader) + words * sizeof(uint32_t) + changed * sizeof(ColliderState), "Invalid World state");
+
+  // Every record is checked against its collider before anything is restored
+  const ColliderState* next = record;
+  uint32_t index = 0;
+  for (Collider* collider = world->colliders; collider; collider = collider->next, index++) {
+    if (mask[index / 32] & (1u << (index % 32))) {
+      lovrCheck(next++->serial == collider->serial, "World state does not match the World's colliders");
+    }
+
+    if (baseRecord) {
+      lovrCheck(baseRecord[index].serial == collider->serial, "Base World state does not match the World's colliders");
+    }
+  }
+
+  JPH_BodyInterface* interface = world->bodyInterfaceNoLock;
+
+  index = 0;
+  for (Collider* collider = world->colliders; collider; collider = collider->next, index++) {
+    ColliderState state;
+
+    if (mask[index / 32] & (1u << (index % 32))) {
+      state = *record++;
+    } else if (baseRecord) {
+      state = baseRecord[index];
+    } else {
+      continue;
+    }
+
+    if (!collider->enabled) {
+      continue;
+    }
+
+    JPH_Activation activation = state.awake ? JPH_Activation_Activate : JPH_Activation_DontActivate;
+    JPH_BodyInterface_SetPositionAndRotation(interface, collider->id, vec3_toJolt(state.position), quat_toJolt(state.orientation), activation);
+    JPH_BodyInterface_SetLinearVelocity(interface, collider->id, vec3_toJolt(state.linearVelocity));
+    JPH_BodyInterface_SetAngularVelocity(interface, collider->id, vec3_toJolt(state.angularVelocity));
+
+    if (!state.awake && collider->activeIndex != ~0u) {
+      JPH_BodyInterface_DeactivateBody(interface, collider->id);
+    }
+
+    vec3_init(collider->lastPosition, state.position);
+    quat_init(collider->lastOrientation, state.orientation);
+    collider->poseTick = atomic_load(&collider->world->poseTick);
+  }
+
+  world->interpolation = 0.f;
+  return true;
+}
+
 typedef struct {
   World* world;
   float* start;
@@ -725,7 +1216,121 @@ bool lovrWorldQuerySphere(World* world, float position[3], float radius, uint32_
   return JPH_BroadPhaseQuery_CollideSphere(query, vec3_toJolt(position), radius, queryCallback, &context, layerFilter, tagFilter);
 }
 
+typedef struct {
+  World* world;
+  Shape* shape;
+  uint32_t filter;
+  float* points;
+  float* ends;
+  CastResult* hits;
+  uint32_t* counts;
+  Collider** colliders;
+  uint32_t maxColliders;
+  uint32_t start;
+  uint32_t count;
+} QueryBatch;
+
+static float castClosest(void* userdata, CastResult* hit) {
+  *((CastResult*) userdata) = *hit;
+  return hit->fraction;
+}
+
+static void raycastJob(void* arg) {
+  QueryBatch* batch = arg;
+  for (uint32_t i = batch->start; i < batch->start + batch->count; i++) {
+    batch->hits[i].collider = NULL;
+    lovrWorldRaycast(batch->world, batch->points + 3 * i, batch->ends + 3 * i, batch->filter, castClosest, &batch->hits[i]);
+  }
+}
+
+static void shapecastJob(void* arg) {
+  QueryBatch* batch = arg;
+  for (uint32_t i = batch->start; i < batch->start + batch->count; i++) {
+    float* p = batch->points + 3 * i;
+    float pose[7] = { p[0], p[1], p[2], 0.f, 0.f, 0.f, 1.f };
+    batch->hits[i].collider = NULL;
+    lovrWorldShapecast(batch->world, batch->shape, pose, batch->ends + 3 * i, batch->filter, castClosest, &batch->hits[i]);
+  }
+}
+
+typedef struct {
+  uint32_t* count;
+  Collider** colliders;
+  uint32_t maxColliders;
+} SphereQuery;
+
+static void querySphereCollect(void* userdata, Collider* collider) {
+  SphereQuery* query = userdata;
+  if (query->colliders && *query->count < query->maxColliders) {
+    query->colliders[*query->count] = collider;
+  }
+  (*query->count)++;
+}
+
+static void querySphereJob(void* arg) {
+  QueryBatch* batch = arg;
+  for (uint32_t i = batch->start; i < batch->start + batch->count; i++) {
+    float* sphere = batch->points + 4 * i;
+    SphereQuery query = {
+      .count = &batch->counts[i],
+      .colliders = batch->colliders ? batch->colliders + (size_t) i * batch->maxColliders : NULL,
+      .maxColliders = batch->maxColliders
+    };
+    batch->counts[i] = 0;
+    lovrWorldQuerySphere(batch->world, sphere, sphere[3], batch->filter, querySphereCollect, &query);
+  }
+}
+
+// Splits queries into batches and runs them on the job system, waiting for all of them to finish
+static void runQueryBatches(QueryBatch* info, uint32_t count, fn_job* fn) {
+  QueryBatch batches[32];
+  job* jobs[COUNTOF(batches)];
+  uint32_t batchCount = MIN(count, COUNTOF(batches));
+  uint32_t batchSize = batchCount > 0 ? (count + batchCount - 1) / batchCount : 0;
+
+  for (uint32_t i = 0; i < batchCount; i++) {
+    uint32_t start = i * batchSize;
+    batches[i] = *info;
+    batches[i].start = start;
+    batches[i].count = start < count ? MIN(batchSize, count - start) : 0;
+    jobs[i] = job_start(fn, &batches[i]);
+  }
+
+  for (uint32_t i = 0; i < batchCount; i++) {
+    job_wait(jobs[i]);
+  }
+}
+
+bool lovrWorldRaycastBatch(World* world, float* starts, float* ends, uint32_t count, uint32_t filter, CastResult* hits) {
+  lovrCheckIdle(world);
+  QueryBatch info = { .world = world, .filter = filter, .points = starts, .ends = ends, .hits = hits };
+  runQueryBatches(&info, count, raycastJob);
+  return true;
+}
+
+bool lovrWorldShapecastBatch(World* world, Shape* shape, float* starts, float* ends, uint32_t count, uint32_t filter, CastResult* hits) {
+  lovrCheckIdle(world);
+  QueryBatch info = { .world = world, .shape = shape, .filter = filter, .points = starts, .ends = ends, .hits = hits };
+  runQueryBatches(&info, count, shapecastJob);
+  return true;
+}
+
+bool lovrWorldQuerySphereBatch(World* world, float* spheres, uint32_t count, uint32_t filter, uint32_t* counts, Collider** colliders, uint32_t maxColliders) {
+  lovrCheckIdle(world);
+  QueryBatch info = {
+    .world = world,
+    .filter = filter,
+    .points = spheres,
+    .counts = counts,
+    .colliders = colliders,
+    .maxColliders = maxColliders
+  };
+  runQueryBatches(&info, count, querySphereJob);
+  return true;
+}
+
 bool lovrWorldDisableCollisionBetween(World* world, const char* tag1, const char* tag2) {
+  lovrCheckIdle(world);
   uint8_t i = findTag(world, tag1, strlen(tag1));
   uint8_t j = findTag(world, tag2, strlen(tag2));
   lovrCheck(i != 0xff, "Unknown tag '%s'", tag1);
@@ -735,6 +1340,7 @@ bool lovrWorldDisableCollisionBetween(World* world, const char* tag1, const char
 }
 
 bool lovrWorldEnableCollisionBetween(World* world, const char* tag1, const char* tag2) {
+  lovrCheckIdle(world);
   uint8_t i = findTag(world, tag1, strlen(tag1));
   uint8_t j = findTag(world, tag2, strlen(tag2));
   lovrCheck(i != 0xff, "Unknown tag '%s'", tag1);
@@ -753,27 +1359,68 @@ bool lovrWorldIsCollisionEnabledBetween(World* world, const char* tag1, const ch
   return true;
 }
 
-void lovrWorldSetCallbacks(World* world, WorldCallbacks* callbacks) {
+static void updateContactListener(World* world) {
   if (world->listener) {
     JPH_ContactListener_Destroy(world->listener);
     world->listener = NULL;
   }
 
-  if (!callbacks || (!callbacks->filter && !callbacks->enter && !callbacks->exit && !callbacks->contact)) {
+  WorldCallbacks* callbacks = &world->callbacks;
+  bool buffer = !!world->contacts;
+
+  if (!buffer && !callbacks->filter && !callbacks->enter && !callbacks->exit && !callbacks->contact) {
     JPH_PhysicsSystem_SetContactListener(world->system, NULL);
   } else {
-    world->callbacks = *callbacks;
     world->listener = JPH_ContactListener_Create((JPH_ContactListener_Procs) {
       .OnContactValidate = callbacks->filter ? onContactValidate : NULL,
-      .OnContactAdded = (callbacks->enter || callbacks->contact) ? onContactAdded : NULL,
-      .OnContactPersisted = callbacks->contact ? onContactPersisted : NULL,
-      .OnContactRemoved = callbacks->exit ? onContactRemoved : NULL
+      .OnContactAdded = (buffer || callbacks->enter || callbacks->contact) ? onContactAdded : NULL,
+      .OnContactPersisted = (buffer || callbacks->contact) ? onContactPersisted : NULL,
+      .OnContactRemoved = (buffer || callbacks->exit) ? onContactRemoved : NULL
     }, world);
 
     JPH_PhysicsSystem_SetContactListener(world->system, world->listener);
   }
 }
 
+bool lovrWorldSetCallbacks(World* world, WorldCallbacks* callbacks) {
+  lovrCheckIdle(world);
+  world->callbacks = callbacks ? *callbacks : (WorldCallbacks) { 0 };
+  updateContactListener(world);
+  return true;
+}
+
+bool lovrWorldIsContactBufferEnabled(World* world) {
+  return !!world->contacts;
+}
+
+bool lovrWorldSetContactBufferEnabled(World* world, bool enable) {
+  lovrCheckIdle(world);
+
+  if (enable == !!world->contacts) {
+    return true;
+  }
+
+  if (enable) {
+    world->contactCapacity = 256;
+    world->contacts = lovrMalloc(world->contactCapacity * sizeof(ContactRecord));
+  } else {
+    lovrFree(world->contacts);
+    world->contacts = NULL;
+    world->contactCapacity = 0;
+  }
+
+  world->contactCount = 0;
+  world->contactsDropped = 0;
+  updateContactListener(world);
+  return true;
+}
+
+ContactRecord* lovrWorldGetContacts(World* world, uint32_t* count, uint32_t* dropped) {
+  *count = world->contacts ? world->contactCount : 0;
+  if (dropped) *dropped = world->contactsDropped;
+  return world->contacts;
+}
+
 // Deprecated
 int lovrWorldGetStepCount(World* world) { return 1; }
 void lovrWorldSetStepCount(World* world, int iterations) {}
@@ -800,6 +1447,7 @@ static void adjustJoints(Collider* collider, JPH_Vec3* oldCenter, JPH_Vec3* newC
 }
 
 Collider* lovrColliderCreate(World* world, float position[3], Shape* shape) {
+  lovrCheckIdle(world);
   uint32_t count = JPH_PhysicsSystem_GetNumBodies(world->system);
   uint32_t limit = JPH_PhysicsSystem_GetMaxBodies(world->system);
   lovrCheck(count < limit, "Too many colliders!");
@@ -811,6 +1459,7 @@ Collider* lovrColliderCreate(World* world, float position[3], Shape* shape) {
   collider->tag = 0xff;
   collider->enabled = true;
   collider->automaticMass = true;
+  collider->serial = ++world->colliderSerial;
 
   if (shape) {
     collider->shapes = shape;
@@ -833,6 +1482,7 @@ Collider* lovrColliderCreate(World* world, float position[3], Shape* shape) {
 
   vec3_init(collider->lastPosition, position);
   quat_identity(collider->lastOrientation);
+  collider->poseTick = atomic_load(&collider->world->poseTick);
 
   if (type == JPH_MotionType_Dynamic) {
     lovrColliderSetLinearDamping(collider, world->defaultLinearDamping);
@@ -908,6 +1558,13 @@ void lovrColliderDestruct(Collider* collider) {
   // Body
 
   World* world = collider->world;
+
+  for (uint32_t i = 0; i < world->contactCount && world->contacts; i++) {
+    ContactRecord* record = &world->contacts[i];
+    if (record->colliderA == collider || record->colliderB == collider) {
+      record->colliderA = record->colliderB = NULL;
+    }
+  }
   bool added = JPH_BodyInterface_IsAdded(world->bodyInterfaceLocked, collider->id);
   if (added) JPH_BodyInterface_RemoveBody(world->bodyInterfaceLocked, collider->id);
   JPH_BodyInterface_DestroyBody(world->bodyInterfaceLocked, collider->id);
@@ -949,6 +1606,7 @@ bool lovrColliderSetEnabled(Collider* collider, bool enable) {
     JPH_BodyInterface_RemoveBody(interface, collider->id);
   }
   collider->enabled = enable;
+  collider->poseTick = atomic_load(&collider->world->poseTick);
   return true;
 }
 
@@ -1355,8 +2013,10 @@ bool lovrColliderIsSensor(Collider* collider) {
   return JPH_Body_IsSensor(collider->body);
 }
 
-void lovrColliderSetSensor(Collider* collider, bool sensor) {
+bool lovrColliderSetSensor(Collider* collider, bool sensor) {
+  if (!getBodyInterface(collider, WRITE)) return false;
   JPH_Body_SetIsSensor(collider->body, sensor);
+  return true;
 }
 
 bool lovrColliderIsContinuous(Collider* collider) {
@@ -1384,11 +2044,21 @@ bool lovrColliderIsSleepingAllowed(Collider* collider) {
   return JPH_Body_GetAllowSleeping(collider->body);
 }
 
-void lovrColliderSetSleepingAllowed(Collider* collider, bool allowed) {
+bool lovrColliderSetSleepingAllowed(Collider* collider, bool allowed) {
+  if (!getBodyInterface(collider, WRITE)) return false;
   JPH_Body_SetAllowSleeping(collider->body, allowed);
+  return true;
+}
+
+bool lovrColliderIsPoseDirty(Collider* collider, uint32_t since) {
+  return collider->activeIndex != ~0u || collider->poseTick >= since;
 }
 
 bool lovrColliderIsAwake(Collider* collider) {
+  if (collider->world->updating) {
+    return collider->snapshotAwake;
+  }
+
   return JPH_BodyInterface_IsActive(getBodyInterface(collider, READ), collider->id);
 }
 
@@ -1420,6 +2090,8 @@ float lovrColliderGetMass(Collider* collider) {
 }
 
 bool lovrColliderSetMass(Collider* collider, float mass) {
+  if (!getBodyInterface(collider, WRITE)) return false;
+
   if (lovrColliderIsKinematic(collider)) {
     return true;
   }
@@ -1468,20 +2140,22 @@ void lovrColliderGetInertia(Collider* collider, float diagonal[3], float rotatio
   quat_fromJolt(rotation, &q);
 }
 
-void lovrColliderSetInertia(Collider* collider, float diagonal[3], float rotation[4]) {
+bool lovrColliderSetInertia(Collider* collider, float diagonal[3], float rotation[4]) {
+  if (!getBodyInterface(collider, WRITE)) return false;
   if (lovrColliderIsKinematic(collider)) {
-    return;
+    return true;
   }
 
   JPH_MotionProperties* motion = JPH_Body_GetMotionProperties(collider->body);
 
   // If all degrees of freedom are restricted, inverse inertia is locked to zero
   if ((JPH_MotionProperties_GetAllowedDOFs(motion) & 0x38) == 0) {
-    return;
+    return true;
   }
 
   JPH_Vec3 idiagonal = { 1.f / diagonal[0], 1.f / diagonal[1], 1.f / diagonal[2] };
   JPH_MotionProperties_SetInverseInertia(motion, &idiagonal, quat_toJolt(rotation));
+  return true;
 }
 
 void lovrColliderGetCenterOfMass(Collider* collider, float center[3]) {
@@ -1523,7 +2197,8 @@ bool lovrColliderGetAutomaticMass(Collider* collider) {
   return collider->automaticMass;
 }
 
-void lovrColliderSetAutomaticMass(Collider* collider, bool enable) {
+bool lovrColliderSetAutomaticMass(Collider* collider, bool enable) {
+  if (!getBodyInterface(collider, WRITE)) return false;
   if (collider->automaticMass != enable) {
     collider->automaticMass = enable;
 
@@ -1537,6 +2212,7 @@ void lovrColliderSetAutomaticMass(Collider* collider, bool enable) {
       JPH_MutableCompoundShape_AdjustCenterOfMass((JPH_MutableCompoundShape*) shape);
     }
   }
+  return true;
 }
 
 bool lovrColliderResetMassData(Collider* collider) {
@@ -1582,7 +2258,8 @@ void lovrColliderGetDegreesOfFreedom(Collider* collider, bool translation[3], bo
   rotation[2] = dofs & JPH_AllowedDOFs_RotationZ;
 }
 
-void lovrColliderSetDegreesOfFreedom(Collider* collider, bool translation[3], bool rotation[3]) {
+bool lovrColliderSetDegreesOfFreedom(Collider* collider, bool translation[3], bool rotation[3]) {
+  if (!getBodyInterface(collider, WRITE)) return false;
   JPH_AllowedDOFs dofs = 0;
 
   if (translation[0]) dofs |= JPH_AllowedDOFs_TranslationX;
@@ -1597,9 +2274,15 @@ void lovrColliderSetDegreesOfFreedom(Collider* collider, bool translation[3], bo
   const JPH_Shape* shape = JPH_BodyInterface_GetShape(getBodyInterface(collider, READ), collider->id);
   JPH_Shape_GetMassProperties(shape, &mass);
   JPH_MotionProperties_SetMassProperties(motion, dofs, &mass);
+  return true;
 }
 
 void lovrColliderGetPosition(Collider* collider, float position[3]) {
+  if (collider->world->updating) {
+    vec3_init(position, collider->lastPosition);
+    return;
+  }
+
   JPH_RVec3 p;
   JPH_BodyInterface_GetPosition(getBodyInterface(collider, READ), collider->id, &p);
   vec3_fromJolt(position, &p);
@@ -1614,16 +2297,27 @@ bool lovrColliderSetPosition(Collider* collider, float position[3]) {
   lovrCheck(collider->enabled, "Collider must be enabled");
   JPH_BodyInterface_SetPosition(interface, collider->id, vec3_toJolt(position), JPH_Activation_Activate);
   vec3_init(collider->lastPosition, position);
+  collider->poseTick = atomic_load(&collider->world->poseTick);
   return true;
 }
 
 void lovrColliderGetRawPosition(Collider* collider, float position[3]) {
+  if (collider->world->updating) {
+    vec3_init(position, collider->lastPosition);
+    return;
+  }
+
   JPH_RVec3 p;
   JPH_BodyInterface_GetPosition(getBodyInterface(collider, READ), collider->id, &p);
   vec3_fromJolt(position, &p);
 }
 
 void lovrColliderGetOrientation(Collider* collider, float orientation[4]) {
+  if (collider->world->updating) {
+    quat_init(orientation, collider->lastOrientation);
+    return;
+  }
+
   JPH_Quat q;
   JPH_BodyInterface_GetRotation(getBodyInterface(collider, READ), collider->id, &q);
   quat_fromJolt(orientation, &q);
@@ -1638,10 +2332,17 @@ bool lovrColliderSetOrientation(Collider* collider, float orientation[4]) {
   lovrCheck(collider->enabled, "Collider must be enabled");
   JPH_BodyInterface_SetRotation(interface, collider->id, quat_toJolt(orientation), JPH_Activation_Activate);
   quat_init(collider->lastOrientation, orientation);
+  collider->poseTick = atomic_load(&collider->world->poseTick);
   return true;
 }
 
 void lovrColliderGetPose(Collider* collider, float position[3], float orientation[4]) {
+  if (collider->world->updating) {
+    vec3_init(position, collider->lastPosition);
+    quat_init(orientation, collider->lastOrientation);
+    return;
+  }
+
   JPH_RVec3 p;
   JPH_Quat q;
   JPH_BodyInterface_GetPositionAndRotation(getBodyInterface(collider, READ), collider->id, &p, &q);
@@ -1660,6 +2361,7 @@ bool lovrColliderSetPose(Collider* collider, float position[3], float orientatio
   JPH_BodyInterface_SetPositionAndRotation(interface, collider->id, vec3_toJolt(position), quat_toJolt(orientation), JPH_Activation_Activate);
   vec3_init(collider->lastPosition, position);
   quat_init(collider->lastOrientation, orientation);
+  collider->poseTick = atomic_load(&collider->world->poseTick);
   return true;
 }
 
@@ -1672,6 +2374,11 @@ bool lovrColliderMoveKinematic(Collider* collider, float position[3], float orie
 }
 
 void lovrColliderGetLinearVelocity(Collider* collider, float velocity[3]) {
+  if (collider->world->updating) {
+    vec3_init(velocity, collider->lastLinearVelocity);
+    return;
+  }
+
   JPH_Vec3 v;
   JPH_BodyInterface_GetLinearVelocity(getBodyInterface(collider, READ), collider->id, &v);
   vec3_fromJolt(velocity, &v);
@@ -1685,6 +2392,11 @@ bool lovrColliderSetLinearVelocity(Collider* collider, float velocity[3]) {
 }
 
 void lovrColliderGetAngularVelocity(Collider* collider, float velocity[3]) {
+  if (collider->world->updating) {
+    vec3_init(velocity, collider->lastAngularVelocity);
+    return;
+  }
+
   JPH_Vec3 v;
   JPH_BodyInterface_GetAngularVelocity(getBodyInterface(collider, READ), collider->id, &v);
   vec3_fromJolt(velocity, &v);
@@ -1702,9 +2414,11 @@ float lovrColliderGetLinearDamping(Collider* collider) {
   return JPH_MotionProperties_GetLinearDamping(properties);
 }
 
-void lovrColliderSetLinearDamping(Collider* collider, float damping) {
+bool lovrColliderSetLinearDamping(Collider* collider, float damping) {
+  if (!getBodyInterface(collider, WRITE)) return false;
   JPH_MotionProperties* properties = JPH_Body_GetMotionProperties(collider->body);
   JPH_MotionProperties_SetLinearDamping(properties, MAX(damping, 0.f));
+  return true;
 }
 
 float lovrColliderGetAngularDamping(Collider* collider) {
@@ -1712,9 +2426,11 @@ float lovrColliderGetAngularDamping(Collider* collider) {
   return JPH_MotionProperties_GetAngularDamping(properties);
 }
 
-void lovrColliderSetAngularDamping(Collider* collider, float damping) {
+bool lovrColliderSetAngularDamping(Collider* collider, float damping) {
+  if (!getBodyInterface(collider, WRITE)) return false;
   JPH_MotionProperties* properties = JPH_Body_GetMotionProperties(collider->body);
   JPH_MotionProperties_SetAngularDamping(properties, MAX(damping, 0.f));
+  return true;
 }
 
 bool lovrColliderApplyForce(Collider* collider, float force[3]) {
@@ -1954,14 +2670,18 @@ float lovrShapeGetDensity(Shape* shape) {
   }
 }
 
-void lovrShapeSetDensity(Shape* shape, float density) {
+bool lovrShapeSetDensity(Shape* shape, float density) {
+  if (shape->collider && !getBodyInterface(shape->collider, WRITE)) return false;
+
   if (shape->type != SHAPE_MESH && shape->type != SHAPE_TERRAIN) {
     JPH_ConvexShape_SetDensity((JPH_ConvexShape*) shape->handle, density);
 
     if (shape->collider && shape->collider->automaticMass) {
-      lovrColliderResetMassData(shape->collider);
+      return lovrColliderResetMassData(shape->collider);
     }
   }
+
+  return true;
 }
 
 float lovrShapeGetMass(Shape* shape) {
@@ -2132,7 +2852,11 @@ bool lovrShapeRaycast(Shape* shape, float start[3], float end[3], CastResult* hi
 }
 
 static bool lovrShapeReplace(Shape* shape, JPH_Shape* new) {
-  if (shape->collider && !lovrColliderReplaceShape(shape->collider, shape, new)) return false;
+  if (shape->collider && (!getBodyInterface(shape->collider, WRITE) || !lovrColliderReplaceShape(shape->collider, shape, new))) {
+    JPH_Shape_Destroy(new);
+    return false;
+  }
+
   JPH_Shape_SetUserData(new, (uint64_t) (uintptr_t) shape);
   JPH_Shape_Destroy(shape->handle);
   shape->handle = new;
@@ -2269,14 +2993,21 @@ ConvexShape* lovrConvexShapeCreate(float points[], uint32_t count, float scale)
   ConvexShape* shape = lovrCalloc(sizeof(ConvexShape));
   shape->ref = 1;
   shape->type = SHAPE_CONVEX;
-  JPH_ConvexHullShapeSettings* settings = JPH_ConvexHullShapeSettings_Create((const JPH_Vec3*) points, count, .05f);
-  JPH_Shape* hull = (JPH_Shape*) JPH_ConvexHullShapeSettings_CreateShape(settings);
-  JPH_ShapeSettings_Destroy((JPH_ShapeSettings*) settings);
-  float scale3[3] = { scale, scale, scale };
-  shape->handle = (JPH_Shape*) JPH_ScaledShape_Create(hull, vec3_toJolt(scale3));
+
+  uint64_t hash = hashGeometry(points, count, NULL, 0);
+  shape->handle = createCachedShape(SHAPE_CONVEX, hash, count, 0, scale);
+
+  if (!shape->handle) {
+    JPH_ConvexHullShapeSettings* settings = JPH_ConvexHullShapeSettings_Create((const JPH_Vec3*) points, count, .05f);
+    JPH_Shape* hull = (JPH_Shape*) JPH_ConvexHullShapeSettings_CreateShape(settings);
+    JPH_ShapeSettings_Destroy((JPH_ShapeSettings*) settings);
+    float scale3[3] = { scale, scale, scale };
+    shape->handle = (JPH_Shape*) JPH_ScaledShape_Create(hull, vec3_toJolt(scale3));
+    cacheShape(SHAPE_CONVEX, hash, count, 0, hull);
+  }
+
   JPH_Shape_SetUserData(shape->handle, (uint64_t) (uintptr_t) shape);
   quat_identity(shape->rotation);
-  JPH_Shape_Destroy(hull);
   return shape;
 }
 
@@ -2334,6 +3065,16 @@ MeshShape* lovrMeshShapeCreate(uint32_t vertexCount, float* vertices, uint32_t i
   shape->ref = 1;
   shape->type = SHAPE_MESH;
 
+  // We wrap MeshShapes in ScaledShapes so that clones can have unique userdata
+  uint64_t hash = hashGeometry(vertices, vertexCount, indices, indexCount);
+  shape->handle = createCachedShape(SHAPE_MESH, hash, vertexCount, indexCount, scale);
+
+  if (shape->handle) {
+    JPH_Shape_SetUserData(shape->handle, (uint64_t) (uintptr_t) shape);
+    quat_identity(shape->rotation);
+    return shape;
+  }
+
   uint32_t triangleCount = indexCount / 3;
   JPH_IndexedTriangle* triangles = lovrMalloc(triangleCount * sizeof(JPH_IndexedTriangle));
   for (uint32_t i = 0; i < triangleCount; i++) {
@@ -2350,12 +3091,11 @@ MeshShape* lovrMeshShapeCreate(uint32_t vertexCount, float* vertices, uint32_t i
   JPH_ShapeSettings_Destroy((JPH_ShapeSettings*) settings);
   lovrFree(triangles);
 
-  // We wrap MeshShapes in ScaledShapes so that clones can have unique userdata
   float scale3[3] = { scale, scale, scale };
   shape->handle = (JPH_Shape*) JPH_ScaledShape_Create(mesh, vec3_toJolt(scale3));
   JPH_Shape_SetUserData(shape->handle, (uint64_t) (uintptr_t) shape);
   quat_identity(shape->rotation);
-  JPH_Shape_Destroy(mesh);
+  cacheShape(SHAPE_MESH, hash, vertexCount, indexCount, mesh);
   return shape;
 }
 
@@ -2538,16 +3278,20 @@ uint32_t lovrJointGetPriority(Joint* joint) {
   return JPH_Constraint_GetConstraintPriority(joint->constraint);
 }
 
-void lovrJointSetPriority(Joint* joint, uint32_t priority) {
+bool lovrJointSetPriority(Joint* joint, uint32_t priority) {
+  lovrCheckJointIdle(joint);
   JPH_Constraint_SetConstraintPriority(joint->constraint, priority);
+  return true;
 }
 
 bool lovrJointIsEnabled(Joint* joint) {
   return JPH_Constraint_GetEnabled(joint->constraint);
 }
 
-void lovrJointSetEnabled(Joint* joint, bool enable) {
+bool lovrJointSetEnabled(Joint* joint, bool enable) {
+  lovrCheckJointIdle(joint);
   JPH_Constraint_SetEnabled(joint->constraint, enable);
+  return true;
 }
 
 float lovrJointGetForce(Joint* joint) {
@@ -2612,6 +3356,7 @@ float lovrJointGetTorque(Joint* joint) {
 
 WeldJoint* lovrWeldJointCreate(Collider* a, Collider* b) {
   lovrCheck(!a || a->world == b->world, "Joint bodies must exist in same World");
+  lovrCheckIdle(b->world);
   JPH_Body* parent = a ? a->body : JPH_Body_GetFixedToWorldBody();
 
   WeldJoint* joint = lovrCalloc(sizeof(WeldJoint));
@@ -2632,6 +3377,7 @@ WeldJoint* lovrWeldJointCreate(Collider* a, Collider* b) {
 
 BallJoint* lovrBallJointCreate(Collider* a, Collider* b, float anchor[3]) {
   lovrCheck(!a || a->world == b->world, "Joint bodies must exist in same World");
+  lovrCheckIdle(b->world);
   JPH_Body* parent = a ? a->body : JPH_Body_GetFixedToWorldBody();
 
   BallJoint* joint = lovrCalloc(sizeof(BallJoint));
@@ -2653,6 +3399,7 @@ BallJoint* lovrBallJointCreate(Collider* a, Collider* b, float anchor[3]) {
 
 ConeJoint* lovrConeJointCreate(Collider* a, Collider* b, float anchor[3], float axis[3]) {
   lovrCheck(!a || a->world == b->world, "Joint bodies must exist in same World");
+  lovrCheckIdle(b->world);
   JPH_Body* parent = a ? a->body : JPH_Body_GetFixedToWorldBody();
 
   lovrCheck(vec3_length(axis) > 0.f, "Cone axis can not be zero");
@@ -2699,6 +3446,7 @@ float lovrConeJointGetLimit(ConeJoint* joint) {
 }
 
 bool lovrConeJointSetLimit(ConeJoint* joint, float angle) {
+  lovrCheckJointIdle(joint);
   lovrCheck(angle >= 0.f && angle <= (float) M_PI, "Cone joint angle limit must be between 0 and PI");
   JPH_ConeConstraint_SetHalfConeAngle((JPH_ConeConstraint*) joint->constraint, angle);
   return true;
@@ -2708,6 +3456,7 @@ bool lovrConeJointSetLimit(ConeJoint* joint, float angle) {
 
 DistanceJoint* lovrDistanceJointCreate(Collider* a, Collider* b, float anchor1[3], float anchor2[3]) {
   lovrCheck(!a || a->world == b->world, "Joint bodies must exist in same World");
+  lovrCheckIdle(b->world);
   JPH_Body* parent = a ? a->body : JPH_Body_GetFixedToWorldBody();
 
   DistanceJoint* joint = lovrCalloc(sizeof(DistanceJoint));
@@ -2731,6 +3480,7 @@ void lovrDistanceJointGetLimits(DistanceJoint* joint, float* min, float* max) {
 }
 
 bool lovrDistanceJointSetLimits(DistanceJoint* joint, float min, float max) {
+  lovrCheckJointIdle(joint);
   lovrCheck(min <= max, "Distance joint lower limit can not exceed the upper limit");
   lovrCheck(max >= 0.f, "Distance joint upper limit can not be negative");
   JPH_DistanceConstraint_SetDistance((JPH_DistanceConstraint*) joint->constraint, min, max);
@@ -2744,17 +3494,20 @@ void lovrDistanceJointGetSpring(DistanceJoint* joint, float* frequency, float* d
   *damping = settings.damping;
 }
 
-void lovrDistanceJointSetSpring(DistanceJoint* joint, float frequency, float damping) {
+bool lovrDistanceJointSetSpring(DistanceJoint* joint, float frequency, float damping) {
+  lovrCheckJointIdle(joint);
   JPH_DistanceConstraint_SetLimitsSpringSettings((JPH_DistanceConstraint*) joint->constraint, &(JPH_SpringSettings) {
     .frequencyOrStiffness = frequency,
     .damping = damping
   });
+  return true;
 }
 
 // HingeJoint
 
 HingeJoint* lovrHingeJointCreate(Collider* a, Collider* b, float anchor[3], float axis[3]) {
   lovrCheck(!a || a->world == b->world, "Joint bodies must exist in same World");
+  lovrCheckIdle(b->world);
   JPH_Body* parent = a ? a->body : JPH_Body_GetFixedToWorldBody();
 
   lovrCheck(vec3_length(axis) > 0.f, "Hinge axis can not be zero");
@@ -2806,6 +3559,7 @@ void lovrHingeJointGetLimits(HingeJoint* joint, float* min, float* max) {
 }
 
 bool lovrHingeJointSetLimits(HingeJoint* joint, float min, float max) {
+  lovrCheckJointIdle(joint);
   lovrCheck(min <= 0.f && min >= -(float) M_PI, "Hinge joint lower angle limit must be between -PI and 0");
   lovrCheck(max >= 0.f && max <= (float) M_PI, "Hinge joint upper angle limit must be between 0 and PI");
   JPH_HingeConstraint_SetLimits((JPH_HingeConstraint*) joint->constraint, min, max);
@@ -2816,8 +3570,10 @@ float lovrHingeJointGetFriction(HingeJoint* joint) {
   return JPH_HingeConstraint_GetMaxFrictionTorque((JPH_HingeConstraint*) joint->constraint);
 }
 
-void lovrHingeJointSetFriction(HingeJoint* joint, float friction) {
+bool lovrHingeJointSetFriction(HingeJoint* joint, float friction) {
+  lovrCheckJointIdle(joint);
   JPH_HingeConstraint_SetMaxFrictionTorque((JPH_HingeConstraint*) joint->constraint, friction);
+  return true;
 }
 
 MotorMode lovrHingeJointGetMotorMode(HingeJoint* joint) {
@@ -2825,9 +3581,11 @@ MotorMode lovrHingeJointGetMotorMode(HingeJoint* joint) {
   return (MotorMode) JPH_HingeConstraint_GetMotorState(constraint);
 }
 
-void lovrHingeJointSetMotorMode(HingeJoint* joint, MotorMode mode) {
+bool lovrHingeJointSetMotorMode(HingeJoint* joint, MotorMode mode) {
+  lovrCheckJointIdle(joint);
   JPH_HingeConstraint* constraint = (JPH_HingeConstraint*) joint->constraint;
   JPH_HingeConstraint_SetMotorState(constraint, (JPH_MotorState) mode);
+  return true;
 }
 
 float lovrHingeJointGetMotorTarget(HingeJoint* joint) {
@@ -2838,10 +3596,12 @@ float lovrHingeJointGetMotorTarget(HingeJoint* joint) {
     JPH_HingeConstraint_GetTargetAngularVelocity(constraint);
 }
 
-void lovrHingeJointSetMotorTarget(HingeJoint* joint, float target) {
+bool lovrHingeJointSetMotorTarget(HingeJoint* joint, float target) {
+  lovrCheckJointIdle(joint);
   JPH_HingeConstraint* constraint = (JPH_HingeConstraint*) joint->constraint;
   JPH_HingeConstraint_SetTargetAngle(constraint, target);
   JPH_HingeConstraint_SetTargetAngularVelocity(constraint, target);
+  return true;
 }
 
 void lovrHingeJointGetMotorSpring(HingeJoint* joint, float* frequency, float* damping) {
@@ -2851,12 +3611,14 @@ void lovrHingeJointGetMotorSpring(HingeJoint* joint, float* frequency, float* da
   *damping = settings.springSettings.damping;
 }
 
-void lovrHingeJointSetMotorSpring(HingeJoint* joint, float frequency, float damping) {
+bool lovrHingeJointSetMotorSpring(HingeJoint* joint, float frequency, float damping) {
+  lovrCheckJointIdle(joint);
   JPH_MotorSettings settings;
   JPH_HingeConstraint_GetMotorSettings((JPH_HingeConstraint*) joint->constraint, &settings);
   settings.springSettings.frequencyOrStiffness = frequency;
   settings.springSettings.damping = damping;
   JPH_HingeConstraint_SetMotorSettings((JPH_HingeConstraint*) joint->constraint, &settings);
+  return true;
 }
 
 void lovrHingeJointGetMaxMotorTorque(HingeJoint* joint, float* positive, float* negative) {
@@ -2866,12 +3628,14 @@ void lovrHingeJointGetMaxMotorTorque(HingeJoint* joint, float* positive, float*
   *negative = -settings.minTorqueLimit;
 }
 
-void lovrHingeJointSetMaxMotorTorque(HingeJoint* joint, float positive, float negative) {
+bool lovrHingeJointSetMaxMotorTorque(HingeJoint* joint, float positive, float negative) {
+  lovrCheckJointIdle(joint);
   JPH_MotorSettings settings;
   JPH_HingeConstraint_GetMotorSettings((JPH_HingeConstraint*) joint->constraint, &settings);
   settings.minTorqueLimit = -negative;
   settings.maxTorqueLimit = positive;
   JPH_HingeConstraint_SetMotorSettings((JPH_HingeConstraint*) joint->constraint, &settings);
+  return true;
 }
 
 float lovrHingeJointGetMotorTorque(HingeJoint* joint) {
@@ -2887,17 +3651,20 @@ void lovrHingeJointGetSpring(HingeJoint* joint, float* frequency, float* damping
   *damping = settings.damping;
 }
 
-void lovrHingeJointSetSpring(HingeJoint* joint, float frequency, float damping) {
+bool lovrHingeJointSetSpring(HingeJoint* joint, float frequency, float damping) {
+  lovrCheckJointIdle(joint);
   JPH_HingeConstraint_SetLimitsSpringSettings((JPH_HingeConstraint*) joint->constraint, &(JPH_SpringSettings) {
     .frequencyOrStiffness = frequency,
     .damping = damping
   });
+  return true;
 }
 
 // SliderJoint
 
 SliderJoint* lovrSliderJointCreate(Collider* a, Collider* b, float axis[3]) {
   lovrCheck(!a || a->world == b->world, "Joint bodies must exist in same World");
+  lovrCheckIdle(b->world);
   JPH_Body* parent = a ? a->body : JPH_Body_GetFixedToWorldBody();
 
   SliderJoint* joint = lovrCalloc(sizeof(SliderJoint));
@@ -2945,6 +3712,7 @@ void lovrSliderJointGetLimits(SliderJoint* joint, float* min, float* max) {
 }
 
 bool lovrSliderJointSetLimits(SliderJoint* joint, float min, float max) {
+  lovrCheckJointIdle(joint);
   lovrCheck(min <= 0.f, "Slider joint lower distance limit can not be positive");
   lovrCheck(max >= 0.f, "Slider joint upper distance limit can not be negative");
   JPH_SliderConstraint_SetLimits((JPH_SliderConstraint*) joint->constraint, min, max);
@@ -2955,8 +3723,10 @@ float lovrSliderJointGetFriction(SliderJoint* joint) {
   return JPH_SliderConstraint_GetMaxFrictionForce((JPH_SliderConstraint*) joint->constraint);
 }
 
-void lovrSliderJointSetFriction(SliderJoint* joint, float friction) {
+bool lovrSliderJointSetFriction(SliderJoint* joint, float friction) {
+  lovrCheckJointIdle(joint);
   JPH_SliderConstraint_SetMaxFrictionForce((JPH_SliderConstraint*) joint->constraint, friction);
+  return true;
 }
 
 MotorMode lovrSliderJointGetMotorMode(SliderJoint* joint) {
@@ -2964,9 +3734,11 @@ MotorMode lovrSliderJointGetMotorMode(SliderJoint* joint) {
   return (MotorMode) JPH_SliderConstraint_GetMotorState(constraint);
 }
 
-void lovrSliderJointSetMotorMode(SliderJoint* joint, MotorMode mode) {
+bool lovrSliderJointSetMotorMode(SliderJoint* joint, MotorMode mode) {
+  lovrCheckJointIdle(joint);
   JPH_SliderConstraint* constraint = (JPH_SliderConstraint*) joint->constraint;
   JPH_SliderConstraint_SetMotorState(constraint, (JPH_MotorState) mode);
+  return true;
 }
 
 float lovrSliderJointGetMotorTarget(SliderJoint* joint) {
@@ -2977,10 +3749,12 @@ float lovrSliderJointGetMotorTarget(SliderJoint* joint) {
     JPH_SliderConstraint_GetTargetVelocity(constraint);
 }
 
-void lovrSliderJointSetMotorTarget(SliderJoint* joint, float target) {
+bool lovrSliderJointSetMotorTarget(SliderJoint* joint, float target) {
+  lovrCheckJointIdle(joint);
   JPH_SliderConstraint* constraint = (JPH_SliderConstraint*) joint->constraint;
   JPH_SliderConstraint_SetTargetPosition(constraint, target);
   JPH_SliderConstraint_SetTargetVelocity(constraint, target);
+  return true;
 }
 
 void lovrSliderJointGetMotorSpring(SliderJoint* joint, float* frequency, float* damping) {
@@ -2990,12 +3764,14 @@ void lovrSliderJointGetMotorSpring(SliderJoint* joint, float* frequency, float*
   *damping = settings.springSettings.damping;
 }
 
-void lovrSliderJointSetMotorSpring(SliderJoint* joint, float frequency, float damping) {
+bool lovrSliderJointSetMotorSpring(SliderJoint* joint, float frequency, float damping) {
+  lovrCheckJointIdle(joint);
   JPH_MotorSettings settings;
   JPH_SliderConstraint_GetMotorSettings((JPH_SliderConstraint*) joint->constraint, &settings);
   settings.springSettings.frequencyOrStiffness = frequency;
   settings.springSettings.damping = damping;
   JPH_SliderConstraint_SetMotorSettings((JPH_SliderConstraint*) joint->constraint, &settings);
+  return true;
 }
 
 void lovrSliderJointGetMaxMotorForce(SliderJoint* joint, float* positive, float* negative) {
@@ -3005,12 +3781,14 @@ void lovrSliderJointGetMaxMotorForce(SliderJoint* joint, float* positive, float*
   *negative = -settings.minForceLimit;
 }
 
-void lovrSliderJointSetMaxMotorForce(SliderJoint* joint, float positive, float negative) {
+bool lovrSliderJointSetMaxMotorForce(SliderJoint* joint, float positive, float negative) {
+  lovrCheckJointIdle(joint);
   JPH_MotorSettings settings;
   JPH_SliderConstraint_GetMotorSettings((JPH_SliderConstraint*) joint->constraint, &settings);
   settings.minForceLimit = -negative;
   settings.maxForceLimit = positive;
   JPH_SliderConstraint_SetMotorSettings((JPH_SliderConstraint*) joint->constraint, &settings);
+  return true;
 }
 
 float lovrSliderJointGetMotorForce(SliderJoint* joint) {
@@ -3026,9 +3804,11 @@ void lovrSliderJointGetSpring(SliderJoint* joint, float* frequency, float* dampi
   *damping = settings.damping;
 }
 
-void lovrSliderJointSetSpring(SliderJoint* joint, float frequency, float damping) {
+bool lovrSliderJointSetSpring(SliderJoint* joint, float frequency, float damping) {
+  lovrCheckJointIdle(joint);
   JPH_SliderConstraint_SetLimitsSpringSettings((JPH_SliderConstraint*) joint->constraint, &(JPH_SpringSettings) {
     .frequencyOrStiffness = frequency,
     .damping = damping
   });
+  return true;
 }
@@ -29,6 +29,10 @@ typedef Joint SliderJoint;
 
 bool lovrPhysicsInit(void (*freeUserdata)(void* object, uintptr_t userdata));
 void lovrPhysicsDestroy(void);
+bool lovrPhysicsIsShapeCacheEnabled(void);
+void lovrPhysicsSetShapeCacheEnabled(bool enable);
+void lovrPhysicsClearShapeCache(void);
+void lovrPhysicsGetShapeCacheStats(uint32_t* count, uint32_t* hits);
 
 // World
 
@@ -65,6 +69,21 @@ typedef struct {
 
 typedef CastResult OverlapResult;
 
+typedef enum {
+  CONTACT_ENTER,
+  CONTACT_PERSIST,
+  CONTACT_EXIT
+} ContactEvent;
+
+typedef struct {
+  Collider* colliderA;
+  Collider* colliderB;
+  ContactEvent event;
+  float position[3];
+  float normal[3];
+  float overlap;
+} ContactRecord;
+
 typedef float CastCallback(void* userdata, CastResult* hit);
 typedef float OverlapCallback(void* userdata, OverlapResult* hit);
 typedef void QueryCallback(void* userdata, Collider* collider);
@@ -80,18 +99,32 @@ uint32_t lovrWorldGetJointCount(World* world);
 Collider* lovrWorldGetColliders(World* world, Collider* collider);
 Joint* lovrWorldGetJoints(World* world, Joint* joint);
 void lovrWorldGetGravity(World* world, float gravity[3]);
-void lovrWorldSetGravity(World* world, float gravity[3]);
-void lovrWorldUpdate(World* world, float dt);
+bool lovrWorldSetGravity(World* world, float gravity[3]);
+bool lovrWorldUpdate(World* world, float dt);
+bool lovrWorldUpdateAsync(World* world, float dt);
+void lovrWorldSync(World* world);
+bool lovrWorldIsUpdating(World* world);
 void lovrWorldInterpolate(World* world, float alpha);
+void lovrWorldGetPoses(World* world, Collider** colliders, uint32_t count, float* data, bool matrices);
+uint32_t lovrWorldAdvancePoseTick(World* world);
+size_t lovrWorldGetStateSize(World* world);
+bool lovrWorldSaveState(World* world, void* data, size_t* size, const void* base, size_t baseSize);
+bool lovrWorldRestoreState(World* world, const void* data, size_t size, const void* base, size_t baseSize);
 bool lovrWorldRaycast(World* world, float start[3], float end[3], uint32_t filter, CastCallback* callback, void* userdata);
 bool lovrWorldShapecast(World* world, Shape* shape, float pose[7], float end[3], uint32_t filter, CastCallback* callback, void* userdata);
 bool lovrWorldOverlapShape(World* world, Shape* shape, float pose[7], float maxDistance, uint32_t filter, OverlapCallback* callback, void* userdata);
 bool lovrWorldQueryBox(World* world, float position[3], float size[3], uint32_t filter, QueryCallback* callback, void* userdata);
 bool lovrWorldQuerySphere(World* world, float position[3], float radius, uint32_t filter, QueryCallback* callback, void* userdata);
+bool lovrWorldRaycastBatch(World* world, float* starts, float* ends, uint32_t count, uint32_t filter, CastResult* hits);
+bool lovrWorldShapecastBatch(World* world, Shape* shape, float* starts, float* ends, uint32_t count, uint32_t filter, CastResult* hits);
+bool lovrWorldQuerySphereBatch(World* world, float* spheres, uint32_t count, uint32_t filter, uint32_t* counts, Collider** colliders, uint32_t maxColliders);
 bool lovrWorldDisableCollisionBetween(World* world, const char* tag1, const char* tag2);
 bool lovrWorldEnableCollisionBetween(World* world, const char* tag1, const char* tag2);
 bool lovrWorldIsCollisionEnabledBetween(World* world, const char* tag1, const char* tag2, bool* enabled);
-void lovrWorldSetCallbacks(World* world, WorldCallbacks* callbacks);
+bool lovrWorldSetCallbacks(World* world, WorldCallbacks* callbacks);
+bool lovrWorldIsContactBufferEnabled(World* world);
+bool lovrWorldSetContactBufferEnabled(World* world, bool enable);
+ContactRecord* lovrWorldGetContacts(World* world, uint32_t* count, uint32_t* dropped);
 
 // Deprecated
 int lovrWorldGetStepCount(World* world);
@@ -131,26 +164,27 @@ bool lovrColliderSetRestitution(Collider* collider, float restitution);
 bool lovrColliderIsKinematic(Collider* collider);
 bool lovrColliderSetKinematic(Collider* collider, bool kinematic);
 bool lovrColliderIsSensor(Collider* collider);
-void lovrColliderSetSensor(Collider* collider, bool sensor);
+bool lovrColliderSetSensor(Collider* collider, bool sensor);
 bool lovrColliderIsContinuous(Collider* collider);
 bool lovrColliderSetContinuous(Collider* collider, bool continuous);
 float lovrColliderGetGravityScale(Collider* collider);
 bool lovrColliderSetGravityScale(Collider* collider, float scale);
 bool lovrColliderIsSleepingAllowed(Collider* collider);
-void lovrColliderSetSleepingAllowed(Collider* collider, bool allowed);
+bool lovrColliderSetSleepingAllowed(Collider* collider, bool allowed);
+bool lovrColliderIsPoseDirty(Collider* collider, uint32_t since);
 bool lovrColliderIsAwake(Collider* collider);
 bool lovrColliderSetAwake(Collider* collider, bool awake);
 float lovrColliderGetMass(Collider* collider);
 bool lovrColliderSetMass(Collider* collider, float mass);
 void lovrColliderGetInertia(Collider* collider, float diagonal[3], float rotation[4]);
-void lovrColliderSetInertia(Collider* collider, float diagonal[3], float rotation[4]);
+bool lovrColliderSetInertia(Collider* collider, float diagonal[3], float rotation[4]);
 void lovrColliderGetCenterOfMass(Collider* collider, float center[3]);
 bool lovrColliderSetCenterOfMass(Collider* collider, float center[3]);
 bool lovrColliderGetAutomaticMass(Collider* collider);
-void lovrColliderSetAutomaticMass(Collider* collider, bool enable);
+bool lovrColliderSetAutomaticMass(Collider* collider, bool enable);
 bool lovrColliderResetMassData(Collider* collider);
 void lovrColliderGetDegreesOfFreedom(Collider* collider, bool translation[3], bool rotation[3]);
-void lovrColliderSetDegreesOfFreedom(Collider* collider, bool translation[3], bool rotation[3]);
+bool lovrColliderSetDegreesOfFreedom(Collider* collider, bool translation[3], bool rotation[3]);
 void lovrColliderGetPosition(Collider* collider, float position[3]);
 bool lovrColliderSetPosition(Collider* collider, float position[3]);
 void lovrColliderGetRawPosition(Collider* collider, float position[3]);
@@ -164,9 +198,9 @@ bool lovrColliderSetLinearVelocity(Collider* collider, float velocity[3]);
 void lovrColliderGetAngularVelocity(Collider* collider, float velocity[3]);
 bool lovrColliderSetAngularVelocity(Collider* collider, float velocity[3]);
 float lovrColliderGetLinearDamping(Collider* collider);
-void lovrColliderSetLinearDamping(Collider* collider, float damping);
+bool lovrColliderSetLinearDamping(Collider* collider, float damping);
 float lovrColliderGetAngularDamping(Collider* collider);
-void lovrColliderSetAngularDamping(Collider* collider, float damping);
+bool lovrColliderSetAngularDamping(Collider* collider, float damping);
 bool lovrColliderApplyForce(Collider* collider, float force[3]);
 bool lovrColliderApplyForceAtPosition(Collider* collider, float force[3], float position[3]);
 bool lovrColliderApplyTorque(Collider* collider, float torque[3]);
@@ -223,7 +257,7 @@ uintptr_t lovrShapeGetUserData(Shape* shape);
 void lovrShapeSetUserData(Shape* shape, uintptr_t userdata);
 float lovrShapeGetVolume(Shape* shape);
 float lovrShapeGetDensity(Shape* shape);
-void lovrShapeSetDensity(Shape* shape, float density);
+bool lovrShapeSetDensity(Shape* shape, float density);
 float lovrShapeGetMass(Shape* shape);
 void lovrShapeGetInertia(Shape* shape, float diagonal[3], float rotation[4]);
 void lovrShapeGetCenterOfMass(Shape* shape, float center[3]);
@@ -305,9 +339,9 @@ uintptr_t lovrJointGetUserData(Joint* joint);
 void lovrJointSetUserData(Joint* joint, uintptr_t userdata);
 void lovrJointGetAnchors(Joint* joint, float anchor1[3], float anchor2[3]);
 uint32_t lovrJointGetPriority(Joint* joint);
-void lovrJointSetPriority(Joint* joint, uint32_t priority);
+bool lovrJointSetPriority(Joint* joint, uint32_t priority);
 bool lovrJointIsEnabled(Joint* joint);
-void lovrJointSetEnabled(Joint* joint, bool enable);
+bool lovrJointSetEnabled(Joint* joint, bool enable);
 float lovrJointGetForce(Joint* joint);
 float lovrJointGetTorque(Joint* joint);
 
@@ -324,7 +358,7 @@ DistanceJoint* lovrDistanceJointCreate(Collider* a, Collider* b, float anchor1[3
 void lovrDistanceJointGetLimits(DistanceJoint* joint, float* min, float* max);
 bool lovrDistanceJointSetLimits(DistanceJoint* joint, float min, float max);
 void lovrDistanceJointGetSpring(DistanceJoint* joint, float* frequency, float* damping);
-void lovrDistanceJointSetSpring(DistanceJoint* joint, float frequency, float damping);
+bool lovrDistanceJointSetSpring(DistanceJoint* joint, float frequency, float damping);
 
 HingeJoint* lovrHingeJointCreate(Collider* a, Collider* b, float anchor[3], float axis[3]);
 void lovrHingeJointGetAxis(HingeJoint* joint, float axis[3]);
@@ -332,18 +366,18 @@ float lovrHingeJointGetAngle(HingeJoint* joint);
 void lovrHingeJointGetLimits(HingeJoint* joint, float* min, float* max);
 bool lovrHingeJointSetLimits(HingeJoint* joint, float min, float max);
 float lovrHingeJointGetFriction(HingeJoint* joint);
-void lovrHingeJointSetFriction(HingeJoint* joint, float friction);
+bool lovrHingeJointSetFriction(HingeJoint* joint, float friction);
 MotorMode lovrHingeJointGetMotorMode(HingeJoint* joint);
-void lovrHingeJointSetMotorMode(HingeJoint* joint, MotorMode mode);
+bool lovrHingeJointSetMotorMode(HingeJoint* joint, MotorMode mode);
 float lovrHingeJointGetMotorTarget(HingeJoint* joint);
-void lovrHingeJointSetMotorTarget(HingeJoint* joint, float target);
+bool lovrHingeJointSetMotorTarget(HingeJoint* joint, float target);
 void lovrHingeJointGetMotorSpring(HingeJoint* joint, float* frequency, float* damping);
-void lovrHingeJointSetMotorSpring(HingeJoint* joint, float frequency, float damping);
+bool lovrHingeJointSetMotorSpring(HingeJoint* joint, float frequency, float damping);
 void lovrHingeJointGetMaxMotorTorque(HingeJoint* joint, float* positive, float* negative);
-void lovrHingeJointSetMaxMotorTorque(HingeJoint* joint, float positive, float negative);
+bool lovrHingeJointSetMaxMotorTorque(HingeJoint* joint, float positive, float negative);
 float lovrHingeJointGetMotorTorque(HingeJoint* joint);
 void lovrHingeJointGetSpring(HingeJoint* joint, float* frequency, float* damping);
-void lovrHingeJointSetSpring(HingeJoint* joint, float frequency, float damping);
+bool lovrHingeJointSetSpring(HingeJoint* joint, float frequency, float damping);
 
 SliderJoint* lovrSliderJointCreate(Collider* a, Collider* b, float axis[3]);
 void lovrSliderJointGetAxis(SliderJoint* joint, float axis[3]);
@@ -351,18 +385,18 @@ float lovrSliderJointGetPosition(SliderJoint* joint);
 void lovrSliderJointGetLimits(SliderJoint* joint, float* min, float* max);
 bool lovrSliderJointSetLimits(SliderJoint* joint, float min, float max);
 float lovrSliderJointGetFriction(SliderJoint* joint);
-void lovrSliderJointSetFriction(SliderJoint* joint, float friction);
+bool lovrSliderJointSetFriction(SliderJoint* joint, float friction);
 MotorMode lovrSliderJointGetMotorMode(SliderJoint* joint);
-void lovrSliderJointSetMotorMode(SliderJoint* joint, MotorMode mode);
+bool lovrSliderJointSetMotorMode(SliderJoint* joint, MotorMode mode);
 float lovrSliderJointGetMotorTarget(SliderJoint* joint);
-void lovrSliderJointSetMotorTarget(SliderJoint* joint, float target);
+bool lovrSliderJointSetMotorTarget(SliderJoint* joint, float target);
 void lovrSliderJointGetMotorSpring(SliderJoint* joint, float* frequency, float* damping);
-void lovrSliderJointSetMotorSpring(SliderJoint* joint, float frequency, float damping);
+bool lovrSliderJointSetMotorSpring(SliderJoint* joint, float frequency, float damping);
 void lovrSliderJointGetMaxMotorForce(SliderJoint* joint, float* positive, float* negative);
-void lovrSliderJointSetMaxMotorForce(SliderJoint* joint, float positive, float negative);
+bool lovrSliderJointSetMaxMotorForce(SliderJoint* joint, float positive, float negative);
 float lovrSliderJointGetMotorForce(SliderJoint* joint);
 void lovrSliderJointGetSpring(SliderJoint* joint, float* frequency, float* damping);
-void lovrSliderJointSetSpring(SliderJoint* joint, float frequency, float damping);
+bool lovrSliderJointSetSpring(SliderJoint* joint, float frequency, float damping);
 
 // These tokens need to exist for Lua bindings
 #define lovrWeldJointDestroy lovrJointDestroy
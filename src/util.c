@@ -69,6 +69,10 @@ int lovrSetError(const char* format, ...) {
   return false;
 }
 
+void lovrClearError(void) {
+  error[0] = '\0';
+}
+
 // Logging
 
 static fn_log* lovrLogCallback;
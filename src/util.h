@@ -37,6 +37,7 @@ void lovrRelease(void* ref, void (*destructor)(void*));
 
 const char* lovrGetError(void);
 int lovrSetError(const char* format, ...);
+void lovrClearError(void);
 
 #define lovrUnreachable() abort()
 #define lovrAssert(c, ...) do { if (!(c)) { lovrSetError(__VA_ARGS__); return 0; } } while (0)
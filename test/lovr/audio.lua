@@ -0,0 +1,206 @@
+group('audio', function()
+  group('lovr.audio', function()
+    test('.render', function()
+      local started = lovr.audio.isStarted()
+      lovr.audio.stop()
+
+      local samples = {}
+      for i = 1, 1024 do samples[i] = .5 end
+      local sound = lovr.data.newSound(512, 'f32', 'stereo', lovr.audio.getSampleRate())
+      sound:setFrames(samples)
+
+      local source = lovr.audio.newSource(sound, { spatial = false, pitchable = false })
+      source:setVolume(.5)
+      source:play()
+
+      local output, average, peak = lovr.audio.render(768)
+      expect(output:getFrameCount()).to.equal(768)
+      expect(output:getChannelLayout()).to.equal('stereo')
+      expect(average >= 0 and peak >= average).to.equal(true)
+
+      local frames = output:getFrames()
+      expect(frames[1]).to.equal(.25)
+      expect(frames[1024]).to.equal(.25)
+      expect(frames[1025]).to.equal(0)
+      expect(frames[1536]).to.equal(0)
+      expect(source:isPlaying()).to.equal(false)
+
+      -- Rendering a partial buffer only advances Sources by the frames that were rendered
+      local long = lovr.data.newSound(1024, 'f32', 'stereo', lovr.audio.getSampleRate())
+      source = lovr.audio.newSource(long, { spatial = false, pitchable = false })
+      source:play()
+      lovr.audio.render(300)
+      expect(source:tell('frames')).to.equal(300)
+
+      if started then lovr.audio.start() end
+    end)
+
+    test('.setResampler', function()
+      local sound = lovr.data.newSound(64, 'f32', 'mono', 44100)
+      local default = lovr.audio.getResampler()
+      expect(default).to.equal('linear')
+
+      lovr.audio.setResampler('sinc')
+      expect(lovr.audio.newSource(sound):getResampler()).to.equal('sinc')
+      expect(lovr.audio.newSource(sound, { resampler = 'cubic' }):getResampler()).to.equal('cubic')
+      lovr.audio.setResampler(default)
+
+      local stats = lovr.audio.getResamplerStats()
+      expect(type(stats.sinc.frames)).to.equal('number')
+      expect(type(stats.cubic.time)).to.equal('number')
+    end)
+
+    test('.setSampleCache', function()
+      local duration, budget = lovr.audio.getSampleCache()
+      lovr.audio.setSampleCache(duration, 0)
+      lovr.audio.setSampleCache(duration)
+      expect(select(2, lovr.audio.getSampleCache())).to.equal(0)
+      lovr.audio.setSampleCache(duration, budget)
+
+      -- Silent 128 kbps mono MP3 frames
+      local frame = '\255\251\144\192' .. string.rep('\0', 413)
+      local function mp3(frames, name)
+        return lovr.data.newSound(lovr.data.newBlob(string.rep(frame, frames), name))
+      end
+
+      local a = lovr.audio.newSource(mp3(20, 'a.mp3'))
+      expect(select(4, lovr.audio.getSampleCache())).to.equal(1)
+
+      -- The same contents from another file share the entry, different contents don't
+      local b = lovr.audio.newSource(mp3(20, 'b.mp3'))
+      expect(select(4, lovr.audio.getSampleCache())).to.equal(1)
+      local c = lovr.audio.newSource(mp3(21, 'c.mp3'))
+      expect(select(4, lovr.audio.getSampleCache())).to.equal(2)
+
+      lovr.audio.setSampleCache(duration, 0)
+      expect({ select(3, lovr.audio.getSampleCache()) }).to.equal({ 0, 0 })
+      lovr.audio.setSampleCache(duration, budget)
+    end)
+  end)
+
+  group('Source', function()
+    test('commands', function()
+      local started = lovr.audio.isStarted()
+      lovr.audio.stop()
+
+      local samples = {}
+      for i = 0, 511 do
+        samples[2 * i + 1] = i / 512
+        samples[2 * i + 2] = i / 512
+      end
+      local sound = lovr.data.newSound(512, 'f32', 'stereo', lovr.audio.getSampleRate())
+      sound:setFrames(samples)
+
+      -- Setters update the game thread's copy right away, the mixer applies them in order
+      local source = lovr.audio.newSource(sound, { spatial = false, pitchable = false })
+      source:setVolume(.25)
+      source:setVolume(1)
+      expect(source:getVolume()).to.equal(1)
+      source:seek(256, 'frames')
+      expect(source:tell('frames')).to.equal(256)
+      source:play()
+
+      local frames = lovr.audio.render(256):getFrames()
+      expect(frames[1]).to.equal(.5)
+      expect(frames[511]).to.equal(511 / 512)
+
+      lovr.audio.setPose(1, 2, 3)
+      local x, y, z = lovr.audio.getPose()
+      expect({ x, y, z }).to.equal({ 1, 2, 3 })
+
+      if started then lovr.audio.start() end
+    end)
+
+    test('virtual', function()
+      local started = lovr.audio.isStarted()
+      lovr.audio.stop()
+      local maxVoices = lovr.audio.getMaxVoices()
+      lovr.audio.setMaxVoices(1)
+
+      local function constant(value, frames)
+        local samples = {}
+        for i = 1, 2 * frames do samples[i] = value end
+        local sound = lovr.data.newSound(frames, 'f32', 'stereo', lovr.audio.getSampleRate())
+        sound:setFrames(samples)
+        return sound
+      end
+
+      local a = lovr.audio.newSource(constant(.5, 4096), { spatial = false, pitchable = false })
+      local b = lovr.audio.newSource(constant(.25, 4096), { spatial = false, pitchable = false })
+      b:setPriority(1)
+      a:play()
+      expect(lovr.audio.render(256):getFrames()[1]).to.equal(.5)
+
+      -- The Source that loses its voice fades out over a buffer instead of cutting off
+      b:play()
+      local frames = lovr.audio.render(256):getFrames()
+      expect(frames[1]).to.equal(.75)
+      expect(frames[512]).to.equal(.25, .01)
+      expect(a:isVirtual()).to.equal(false)
+
+      -- Virtual Sources are silent but keep their place
+      frames = lovr.audio.render(256):getFrames()
+      expect(frames[1]).to.equal(.25)
+      expect(a:isVirtual()).to.equal(true)
+      expect(b:isVirtual()).to.equal(false)
+      expect(a:tell('frames')).to.equal(768)
+
+      -- A Source that gets its voice back fades in
+      b:stop()
+      frames = lovr.audio.render(256):getFrames()
+      expect(frames[1]).to.equal(0)
+      expect(frames[512]).to.equal(.5, .01)
+      expect(a:isVirtual()).to.equal(false)
+      expect(a:tell('frames')).to.equal(1024)
+      a:stop()
+
+      -- Virtual streams drop the frames they would have played
+      local stream = lovr.data.newSound(1024, 'f32', 'stereo', lovr.audio.getSampleRate(), 'stream')
+      stream:setFrames(constant(0, 1024))
+      local c = lovr.audio.newSource(stream, { spatial = false, pitchable = false })
+      b:play()
+      c:play()
+      lovr.audio.render(256)
+      expect(c:isVirtual()).to.equal(true)
+      expect(stream:getFrameCount()).to.equal(768)
+      b:stop()
+      c:stop()
+
+      lovr.audio.setMaxVoices(maxVoices)
+      if started then lovr.audio.start() end
+    end)
+  end)
+
+  group('Bus', function()
+    test(':setVolume', function()
+      local started = lovr.audio.isStarted()
+      lovr.audio.stop()
+
+      local samples = {}
+      for i = 1, 1024 do samples[i] = .5 end
+      local sound = lovr.data.newSound(512, 'f32', 'stereo', lovr.audio.getSampleRate())
+      sound:setFrames(samples)
+
+      local bus = lovr.audio.newBus()
+      bus:setVolume(.5)
+      expect(bus:getVolume()).to.equal(.5)
+
+      local source = lovr.audio.newSource(sound, { spatial = false, pitchable = false })
+      source:setVolume(.5)
+      source:setBus(bus)
+      expect(source:getBus()).to.equal(bus)
+      source:play()
+
+      -- The first buffer ramps from the Bus's initial volume
+      local frames = lovr.audio.render(768):getFrames()
+      expect(frames[513]).to.equal(.125)
+      expect(frames[1024]).to.equal(.125)
+      expect(frames[1025]).to.equal(0)
+
+      source:setBus(nil)
+      expect(source:getBus()).to.equal(nil)
+
+      if started then lovr.audio.start() end
+    end)
+  end)
+end)
@@ -363,6 +363,25 @@ group('graphics', function()
       local lines = font:getLines({ 0xff0000, 'hello ', 0x0000ff, 'world' }, 0)
       expect(lines).to.equal({ 'hello ', 'world' })
     end)
+
+    test(':getVertices', function()
+      local font = lovr.graphics.newFont(lovr.data.newRasterizer(20))
+      local first = font:getVertices('cached text', 0, 'left', 'top')
+      for i = 1, 3 do
+        expect(font:getVertices('cached text', 0, 'left', 'top')).to.equal(first)
+      end
+      expect(#font:getVertices('cached text', 0, 'right', 'top')).to.equal(#first)
+      expect(font:getVertices('cached text', 0, 'right', 'top')).to_not.equal(first)
+    end)
+
+    test(':getCache', function()
+      local font = lovr.graphics.newFont(lovr.data.newRasterizer(24))
+      font:prewarm('hello world', { 0x30, 0x39 }, 0x263a)
+      local cache = font:getCache()
+      expect(lovr.graphics.newFont(lovr.data.newRasterizer(24)):loadCache(cache)).to.equal(true)
+      expect(lovr.graphics.newFont(lovr.data.newRasterizer(25)):loadCache(cache)).to.equal(false)
+      expect(function() font:prewarm({ 10, 1 }) end).to.fail()
+    end)
   end)
 
   group('Mesh', function()
@@ -480,6 +499,55 @@ group('graphics', function()
       image = texture:getPixels()
       expect({ image:getPixel(0, 0) }).to.equal({ 0, 0, 1, 1 })
     end)
+
+    test(':beginTimer', function()
+      lovr.graphics.setTimingEnabled(true)
+      pass = lovr.graphics.newPass(lovr.graphics.newTexture(1, 1))
+      pass:beginTimer('outer')
+      pass:fill()
+      pass:beginTimer('inner')
+      pass:fill()
+      pass:endTimer()
+      pass:endTimer()
+      expect(function() pass:endTimer() end).to.fail()
+      lovr.graphics.submit(pass)
+      lovr.graphics.wait()
+      lovr.graphics.setTimingEnabled(false)
+      timings = lovr.graphics.getTimings()
+      expect(#timings).to.equal(1)
+      expect(timings[1].children[1].label).to.equal('outer')
+      expect(timings[1].children[1].children[1].label).to.equal('inner')
+      expect(timings[1].children[1].gpuTime).to.be.a('number')
+    end)
+
+    test(':cullDraws', function()
+      local depth = lovr.graphics.newTexture(64, 64, { format = 'd32f', usage = { 'render', 'sample' }, mipmaps = false })
+      pass = lovr.graphics.newPass({ lovr.graphics.newTexture(64, 64), depth = depth })
+      pass:plane(0, 0, -2, 10, 10)
+      lovr.graphics.submit(pass)
+
+      local bounds = lovr.graphics.newBuffer('float', { 0, 0, -10, 1, 1, 1, 0, 0, -1, .1, .1, .1 })
+      local draws = lovr.graphics.newBuffer('uint', { 36, 1, 0, 0, 0, 36, 1, 0, 0, 0 })
+      local output = lovr.graphics.newBuffer('uint', 10)
+      pass:reset()
+      expect(function() pass:cullDraws(bounds, draws, output, 2) end).to.fail()
+      pass:buildDepthPyramid(depth)
+      pass:cullDraws(bounds, draws, output, 2)
+      lovr.graphics.submit(pass)
+      expect(output:getData()).to.equal({ 36, 1, 0, 0, 0, 36, 0, 0, 0, 0 })
+    end)
+
+    test(':cullInstances', function()
+      pass = lovr.graphics.newPass(lovr.graphics.newTexture(16, 16))
+      local bounds = lovr.graphics.newBuffer('vec4', { vec4(0, 0, -5, 1), vec4(0, 0, 5, 1), vec4(100, 0, -5, 1), vec4(0, 1, -3, 1) })
+      local output = lovr.graphics.newBuffer('uint', 4)
+      local draws = lovr.graphics.newBuffer('uint', { 36, 7, 0, 0, 0 })
+      pass:cullInstances(bounds, output, draws, 4)
+      lovr.graphics.submit(pass)
+      expect(draws:getData()).to.equal({ 36, 2, 0, 0, 0 })
+      local visible = output:getData()
+      expect(visible[1] + visible[2]).to.equal(0 + 3)
+    end)
   end)
 
   group('Shader', function()
@@ -15,6 +15,160 @@ group('math', function()
         expect({ curve:getPoint(i) }).to.equal({ slice:getPoint(i) })
       end
     end)
+
+    -- Reference evaluation with de Casteljau's algorithm
+    local function casteljau(points, t)
+      local p = {}
+      for i = 1, #points do p[i] = { points[i]:unpack() } end
+      for k = #p - 1, 1, -1 do
+        for i = 1, k do
+          for c = 1, 3 do
+            p[i][c] = p[i][c] * (1 - t) + p[i + 1][c] * t
+          end
+        end
+      end
+      return p[1]
+    end
+
+    local function makePoints(count)
+      local points = {}
+      for i = 1, count do
+        points[i] = vec3(i * .5, math.sin(i), math.cos(i * .7) * 2)
+      end
+      return points
+    end
+
+    test(':evaluate', function()
+      for count = 2, 8 do
+        local points = makePoints(count)
+        local curve = lovr.math.newCurve(points)
+        for _, t in ipairs({ 0, .1, .25, .5, .8, 1 }) do
+          expect({ curve:evaluate(t) }).to.equal(casteljau(points, t), 1e-5)
+        end
+      end
+
+      local points = makePoints(200)
+      local curve = lovr.math.newCurve(points)
+      for _, t in ipairs({ 0, .1, .25, .5, .8, 1 }) do
+        expect({ curve:evaluate(t) }).to.equal(casteljau(points, t), 1e-4)
+      end
+    end)
+
+    test(':getTangent', function()
+      for count = 3, 8 do
+        local points = makePoints(count)
+        local curve = lovr.math.newCurve(points)
+        local differences = {}
+        for i = 1, count - 1 do
+          differences[i] = points[i + 1] - points[i]
+        end
+        for _, t in ipairs({ 0, .1, .25, .5, .8, 1 }) do
+          local d = casteljau(differences, t)
+          local expected = vec3(d[1], d[2], d[3]):normalize()
+          expect({ curve:getTangent(t) }).to.equal({ expected:unpack() }, 1e-5)
+        end
+      end
+    end)
+
+    test(':slice interval', function()
+      for count = 3, 6 do
+        local points = makePoints(count)
+        local slice = lovr.math.newCurve(points):slice(.2, .7)
+        for _, u in ipairs({ 0, .3, .5, 1 }) do
+          expect({ slice:evaluate(u) }).to.equal(casteljau(points, .2 + .5 * u), 1e-5)
+        end
+      end
+    end)
+
+    test(':evaluateMany', function()
+      local curve = lovr.math.newCurve(vec3(0, 0, 0), vec3(4, 0, 0))
+      expect(curve:getLength()).to.equal(4, 1e-5)
+      expect(select(1, curve:evaluateDistance(1))).to.equal(1, 1e-5)
+      local points = lovr.math.newVec3Array(5)
+      curve:evaluateMany(0, 1, 5, points, true)
+      for i = 1, 5 do
+        expect(points:get(i).x).to.equal(i - 1, 1e-5)
+      end
+      curve:setPoint(2, 8, 0, 0)
+      expect(curve:getLength()).to.equal(8, 1e-5)
+    end)
+  end)
+
+  group('noise', function()
+    test('noiseField', function()
+      local blob = lovr.data.newBlob(4 * 4 * 4)
+      lovr.math.noiseField(blob, { 4, 4 }, .25)
+      local values = { blob:getF32(0, 16) }
+      expect(values[6]).to.equal(lovr.math.noise(.25, .25), 1e-6)
+      expect(values[16]).to.equal(lovr.math.noise(.75, .75), 1e-6)
+      expect(function() lovr.math.noiseField(blob, { 8, 8 }) end).to.fail()
+    end)
+  end)
+
+  group('RandomGenerator', function()
+    test(':fill', function()
+      local generator = lovr.math.newRandomGenerator(7, { algorithm = 'xoshiro' })
+      expect(generator:getAlgorithm()).to.equal('xoshiro')
+      local points = lovr.math.newVec3Array(64)
+      generator:fill(points, nil, 'onsphere')
+      for i = 1, 64 do
+        expect(points:get(i):length()).to.equal(1, 1e-5)
+      end
+      local state = generator:getState()
+      local x = generator:random()
+      generator:setState(state)
+      expect(generator:random()).to.equal(x)
+      expect(function() generator:setState(('0'):rep(64)) end).to.fail.with('xoshiro random state can not be all zeros')
+    end)
+
+    test('seeds', function()
+      local a = lovr.math.newRandomGenerator('12345')
+      local b = lovr.math.newRandomGenerator(12345)
+      expect(a:getAlgorithm()).to.equal('xorshift')
+      expect(a:random()).to.equal(b:random())
+    end)
+
+    test(':jump', function()
+      local a = lovr.math.newRandomGenerator(7, { algorithm = 'xoshiro' })
+      local b = lovr.math.newRandomGenerator(7, { algorithm = 'xoshiro' })
+      b:jump()
+      expect(a:random()).to_not.equal(b:random())
+      expect(function() lovr.math.newRandomGenerator():jump() end).to.fail()
+    end)
+  end)
+
+  group('VectorArray', function()
+    test(':transform', function()
+      local points = lovr.math.newVec3Array(2)
+      expect(#points).to.equal(2)
+      points:set(1, 1, 2, 3)
+      points:set(2, vec3(-1, 0, 1))
+      points:transform(mat4():translate(1, 1, 1))
+      expect({ points:get(1):unpack() }).to.equal({ 2, 3, 4 })
+      expect({ points:get(2):unpack() }).to.equal({ 0, 1, 2 })
+      expect({ points:getBounds() }).to.equal({ 0, 2, 1, 3, 2, 4 })
+      expect(points:getBlob():getSize()).to.equal(24)
+      expect(function() points:get(3) end).to.fail()
+      expect(function() points:get(0) end).to.fail()
+      expect(function() points:get(-1) end).to.fail.with('Invalid VectorArray index: %-1')
+
+      local matrices = lovr.math.newMat4Array(2)
+      matrices:set(1, mat4():translate(1, 2, 3))
+      matrices:set(2, mat4():scale(2))
+      matrices:transform(mat4():translate(1, 0, 0))
+      expect({ matrices:get(1):getPosition() }).to.equal({ 2, 2, 3 })
+      expect({ matrices:get(2):getPosition() }).to.equal({ 1, 0, 0 })
+    end)
+
+    test(':add', function()
+      local points = lovr.math.newVec2Array(2)
+      points:set(1, 1, 2)
+      points:sub(vec2(1, 1))
+      expect({ points:get(1):unpack() }).to.equal({ 0, 1 })
+      expect({ points:get(2):unpack() }).to.equal({ -1, -1 })
+      local matrices = lovr.math.newMat4Array(1)
+      expect(function() matrices:add(mat4()) end).to.fail.with('mat4 arrays can only be added to other VectorArrays')
+    end)
   end)
 
   group('vectors', function()
@@ -23,5 +177,16 @@ group('math', function()
       lovr.math.drain()
       expect(function() v:length() end).to.fail.with('Attempt to use a temporary vector from a previous frame')
     end)
+
+    test(':madd', function()
+      local v = vec3(1, 2, 3)
+      expect(v:madd(vec3(1, 1, 1), 2)).to.equal(v)
+      expect({ v:unpack() }).to.equal({ 3, 4, 5 })
+    end)
+
+    test(':composeTRS', function()
+      local m = mat4():composeTRS(vec3(1, 2, 3), quat(), vec3(2, 3, 4))
+      expect({ m:unpack(true) }).to.equal({ mat4(vec3(1, 2, 3), vec3(2, 3, 4), quat()):unpack(true) })
+    end)
   end)
 end)
@@ -15,6 +15,169 @@ group('physics', function()
         world:raycast(0, 10, 0, 0, -10, 0)
       end)
     end)
+
+    test(':raycastBatch', function()
+      local box = world:newBoxCollider(0, 0, 0, 2)
+      local starts = lovr.math.newVec3Array(2)
+      local ends = lovr.math.newVec3Array(2)
+      starts:set(1, 0, 10, 0)
+      ends:set(1, 0, -10, 0)
+      starts:set(2, 10, 10, 0)
+      ends:set(2, 10, -10, 0)
+      local output = lovr.data.newBlob(2 * 8 * 4)
+      local colliders = {}
+      world:raycastBatch(starts, ends, output, nil, colliders)
+      expect({ output:getF32(0, 8) }).to.equal({ 0, 1, 0, .45, 0, 1, 0, 1 }, 1e-4)
+      expect(output:getF32(28)).to.equal(0)
+      expect(colliders).to.equal({ box, false })
+      expect(function() world:raycastBatch(starts, ends, lovr.data.newBlob(15 * 4)) end).to.fail()
+      expect(function() world:raycastBatch(starts, ends, output, nil, 7) end).to.fail()
+    end)
+
+    test(':getPoses', function()
+      local a = world:newBoxCollider(1, 2, 3)
+      local b = world:newSphereCollider(4, 5, 6)
+      local poses = lovr.math.newVec4Array(4)
+      expect(world:getPoses(poses, { a, b })).to.equal(2)
+      expect({ poses:get(1):unpack() }).to.equal({ 1, 2, 3, 1 }, 1e-6)
+      expect({ poses:get(2):unpack() }).to.equal({ 0, 0, 0, 1 }, 1e-6)
+      expect({ poses:get(3):unpack() }).to.equal({ 4, 5, 6, 1 }, 1e-6)
+
+      local matrices = lovr.math.newMat4Array(1)
+      world:getPoses(matrices, { b })
+      expect({ matrices:get(1):unpack(true) }).to.equal({ mat4(4, 5, 6):unpack(true) }, 1e-6)
+
+      -- Incremental exports track changes separately for each target
+      a:setAwake(false)
+      b:setAwake(false)
+      local first = lovr.math.newVec4Array(4)
+      local second = lovr.math.newVec4Array(4)
+      local _, firstTick = world:getPoses(first, { a, b })
+      local _, secondTick = world:getPoses(second, { a, b })
+      a:setPosition(7, 8, 9)
+      a:setAwake(false)
+      second:set(3, 0, 0, 0, 0)
+      world:getPoses(first, { a, b }, false, firstTick)
+      world:getPoses(second, { a, b }, false, secondTick)
+      expect({ first:get(1):unpack() }).to.equal({ 7, 8, 9, 1 }, 1e-6)
+      expect({ second:get(1):unpack() }).to.equal({ 7, 8, 9, 1 }, 1e-6)
+      expect({ second:get(3):unpack() }).to.equal({ 0, 0, 0, 0 })
+    end)
+
+    test(':saveState', function()
+      local ball = world:newSphereCollider(0, 10, 0, 1)
+      local box = world:newBoxCollider(5, 0, 0)
+      local full = world:saveState()
+      box:setLinearVelocity(1, 2, 3)
+      local delta = world:saveState(full)
+      expect(delta:getSize() < full:getSize()).to.equal(true)
+
+      world:update(1 / 60)
+      expect(select(2, ball:getPosition()) < 10).to.equal(true)
+
+      world:restoreState(full)
+      expect({ ball:getPosition() }).to.equal({ 0, 10, 0 }, 1e-6)
+      expect({ box:getLinearVelocity() }).to.equal({ 0, 0, 0 }, 1e-6)
+
+      world:restoreState(delta, full)
+      expect({ box:getLinearVelocity() }).to.equal({ 1, 2, 3 }, 1e-6)
+      expect(function() world:restoreState(delta) end).to.fail()
+
+      -- Joint state isn't saved, so Worlds with joints are rejected
+      local joint = lovr.physics.newBallJoint(ball, box, 0, 5, 0)
+      expect(function() world:saveState() end).to.fail()
+      expect(function() world:restoreState(full) end).to.fail()
+      joint:destroy()
+      world:restoreState(full)
+
+      -- States only restore onto the colliders they were saved from
+      box:destroy()
+      world:newBoxCollider(5, 0, 0)
+      expect(function() world:restoreState(full) end).to.fail.with('World state does not match the World\'s colliders')
+    end)
+
+    test(':getContacts', function()
+      world:setContactBufferEnabled(true)
+      local ground = world:newBoxCollider(0, 0, 0, 10, 1, 10)
+      ground:setKinematic(true)
+      local ball = world:newSphereCollider(0, .9, 0, .5)
+
+      world:update(1 / 60)
+
+      local events = {}
+      for event, a, b, x, y, z, nx, ny, nz, overlap in world:getContacts() do
+        events[event] = true
+        expect(a == ball or b == ball).to.equal(true)
+        expect(overlap > 0).to.equal(true)
+      end
+      expect(events.enter).to.equal(true)
+      expect(events.persist).to.equal(true)
+      expect(world:getContactCount()).to.equal(2)
+    end)
+
+    test(':updateAsync', function()
+      local w = lovr.physics.newWorld()
+      local ball = w:newSphereCollider(0, 10, 0, 1)
+      w:updateAsync(1 / 60)
+      expect(w:isUpdating()).to.equal(true)
+      expect({ ball:getPosition() }).to.equal({ 0, 10, 0 })
+      expect(function() ball:setPosition(0, 0, 0) end).to.fail()
+      expect(function() w:updateAsync(1 / 60) end).to.fail()
+      w:sync()
+      expect(w:isUpdating()).to.equal(false)
+      expect(select(2, ball:getPosition()) < 10).to.equal(true)
+      w:destroy()
+    end)
+
+    test(':updateAsync rejects mutation', function()
+      local w = lovr.physics.newWorld()
+      local a = w:newBoxCollider(0, 10, 0)
+      local b = w:newBoxCollider(0, 12, 0)
+      local joint = lovr.physics.newHingeJoint(a, b, 0, 11, 0, 1, 0, 0)
+      b:setLinearVelocity(1, 0, 0)
+      w:updateAsync(1 / 60)
+      expect({ b:getLinearVelocity() }).to.equal({ 1, 0, 0 })
+      expect(b:isAwake()).to.equal(true)
+      expect(function() w:setGravity(0, 0, 0) end).to.fail()
+      expect(function() a:setLinearDamping(1) end).to.fail()
+      expect(function() a:setMass(5) end).to.fail()
+      expect(function() a:setSleepingAllowed(false) end).to.fail()
+      expect(function() a:getShape():setDensity(2) end).to.fail()
+      expect(function() joint:setEnabled(false) end).to.fail()
+      expect(function() joint:setMotorTarget(1) end).to.fail()
+      w:sync()
+      w:setGravity(0, 0, 0)
+      joint:setEnabled(false)
+      expect(joint:isEnabled()).to.equal(false)
+      w:destroy()
+    end)
+  end)
+
+  group('Shape', function()
+    test('cached MeshShape', function()
+      local vertices = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 0, 1 }, { 1, 0, 1 } }
+      local indices = { 1, 2, 3, 2, 4, 3 }
+      lovr.physics.setShapeCacheEnabled(true)
+      lovr.physics.clearShapeCache()
+
+      local a = lovr.physics.newMeshShape(vertices, indices)
+      local b = lovr.physics.newMeshShape(vertices, indices, 2)
+      expect(b:getScale()).to.equal(2)
+      expect({ lovr.physics.getShapeCacheStats() }).to.equal({ 1, 1 })
+
+      -- Different geometry gets its own entry instead of reusing the first one
+      local c = lovr.physics.newMeshShape(vertices, { 1, 2, 3 })
+      expect({ lovr.physics.getShapeCacheStats() }).to.equal({ 2, 1 })
+      local d = lovr.physics.newConvexShape(vertices)
+      expect({ lovr.physics.getShapeCacheStats() }).to.equal({ 3, 1 })
+
+      -- Shapes outlive the cache
+      lovr.physics.setShapeCacheEnabled(false)
+      expect({ lovr.physics.getShapeCacheStats() }).to.equal({ 0, 0 })
+      expect(a:getScale()).to.equal(1)
+      expect(c:getScale()).to.equal(1)
+      expect(d:getPointCount()).to.equal(4)
+    end)
   end)
 
   group('Collider', function()
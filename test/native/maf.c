@@ -0,0 +1,171 @@
+#include "core/maf.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Checks the SIMD matrix kernels in maf.h against the scalar math they replace, including the batched
+// point transform with packed, padded, and unaligned arrays.  Pass --bench to time them as well.
+
+#define COUNT 37
+#define BENCH_COUNT 4096
+#define BENCH_ITERATIONS 2000
+
+static int failures;
+
+static float randomFloat(void) {
+  return (float) rand() / RAND_MAX * 4.f - 2.f;
+}
+
+static void fill(float* data, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    data[i] = randomFloat();
+  }
+}
+
+// A random affine transform, so points keep a w of 1 and nothing divides by ~0
+static void randomTransform(float* m) {
+  float q[4];
+  mat4_identity(m);
+  mat4_translate(m, randomFloat(), randomFloat(), randomFloat());
+  quat_fromAngleAxis(q, randomFloat() * (float) M_PI, randomFloat(), randomFloat(), 1.f);
+  mat4_rotateQuat(m, q);
+  mat4_scale(m, 1.f + randomFloat() * .25f, 1.f, 1.f - randomFloat() * .25f);
+}
+
+// FP contraction can fuse the scalar references on some targets, so results only match closely
+static void compare(const char* name, const float* a, const float* b, size_t count, size_t index) {
+  for (size_t i = 0; i < count; i++) {
+    float scale = fabsf(b[i]) > 1.f ? fabsf(b[i]) : 1.f;
+    if (!(fabsf(a[i] - b[i]) <= 1e-5f * scale)) {
+      printf("%s: element %zu, index %zu: %g != %g\n", name, index, i, a[i], b[i]);
+      failures++;
+      return;
+    }
+  }
+}
+
+// Reference versions, the scalar code maf.h uses with MAF_NO_SIMD
+
+static void ref_mul(float* m, const float* n) {
+  float r[16];
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      r[4 * i + j] = n[4 * i + 0] * m[j] + n[4 * i + 1] * m[4 + j] + n[4 * i + 2] * m[8 + j] + n[4 * i + 3] * m[12 + j];
+    }
+  }
+  memcpy(m, r, sizeof(r));
+}
+
+static void ref_mulVec4(const float* m, float* v) {
+  float r[4];
+  for (int j = 0; j < 4; j++) {
+    r[j] = v[0] * m[j] + v[1] * m[4 + j] + v[2] * m[8 + j] + v[3] * m[12 + j];
+  }
+  memcpy(v, r, sizeof(r));
+}
+
+static void ref_mulPoint(const float* m, float* v) {
+  float r[4];
+  for (int j = 0; j < 4; j++) {
+    r[j] = v[0] * m[j] + v[1] * m[4 + j] + v[2] * m[8 + j] + m[12 + j];
+  }
+  v[0] = r[0] / r[3];
+  v[1] = r[1] / r[3];
+  v[2] = r[2] / r[3];
+}
+
+static void test(void) {
+  float m[16], n[16], expected[16], actual[16];
+  float v[4], w[4];
+
+  for (size_t i = 0; i < COUNT; i++) {
+    fill(m, 16);
+    fill(n, 16);
+    memcpy(expected, m, sizeof(m));
+    memcpy(actual, m, sizeof(m));
+    ref_mul(expected, n);
+    mat4_mul(actual, n);
+    compare("mat4_mul", actual, expected, 16, i);
+
+    fill(v, 4);
+    memcpy(w, v, sizeof(v));
+    ref_mulVec4(m, v);
+    mat4_mulVec4(m, w);
+    compare("mat4_mulVec4", w, v, 4, i);
+
+    randomTransform(m);
+    fill(v, 3);
+    memcpy(w, v, sizeof(v));
+    ref_mulPoint(m, v);
+    mat4_mulPoint(m, w);
+    compare("mat4_mulPoint", w, v, 3, i);
+  }
+
+  // Batches are offset by a float so nothing is 16 byte aligned
+  static float points[5 * COUNT + 1], expectedPoints[5 * COUNT + 1];
+  for (size_t stride = 3; stride <= 5; stride++) {
+    randomTransform(m);
+    fill(points, 5 * COUNT + 1);
+    memcpy(expectedPoints, points, sizeof(points));
+    for (size_t i = 0; i < COUNT; i++) {
+      ref_mulPoint(m, expectedPoints + 1 + stride * i);
+    }
+    mat4_mulPoint_n(m, points + 1, COUNT, stride);
+    compare("mat4_mulPoint_n", points, expectedPoints, 5 * COUNT + 1, stride);
+  }
+}
+
+static double now(void) {
+  struct timespec t;
+  timespec_get(&t, TIME_UTC);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Times per element, the sink keeps the compiler from dropping the loops
+#define BENCH(name, reference, simd) do {\
+    reference;\
+    simd;\
+    double start = now();\
+    for (size_t k = 0; k < BENCH_ITERATIONS; k++) { reference; sink += data[k % BENCH_COUNT]; }\
+    double scalar = now() - start;\
+    start = now();\
+    for (size_t k = 0; k < BENCH_ITERATIONS; k++) { simd; sink += data[k % BENCH_COUNT]; }\
+    double vector = now() - start;\
+    double scale = 1e9 / ((double) BENCH_ITERATIONS * BENCH_COUNT);\
+    printf("%-16s %6.2f ns scalar %6.2f ns simd %5.2fx\n", name, scalar * scale, vector * scale, scalar / vector);\
+  } while (0)
+
+static void bench(void) {
+  static float data[16 * BENCH_COUNT];
+  static float out[16 * BENCH_COUNT];
+  float m[16];
+  volatile float sink = 0.f;
+
+  randomTransform(m);
+  fill(data, 16 * BENCH_COUNT);
+
+  printf("Per element, %d elements:\n", BENCH_COUNT);
+  BENCH("mat4_mul",
+    for (size_t i = 0; i < BENCH_COUNT; i++) { memcpy(out + 16 * i, m, sizeof(m)); ref_mul(out + 16 * i, data + 16 * i); },
+    for (size_t i = 0; i < BENCH_COUNT; i++) { memcpy(out + 16 * i, m, sizeof(m)); mat4_mul(out + 16 * i, data + 16 * i); });
+  BENCH("mat4_mulVec4",
+    for (size_t i = 0; i < BENCH_COUNT; i++) ref_mulVec4(m, data + 4 * i),
+    for (size_t i = 0; i < BENCH_COUNT; i++) mat4_mulVec4(m, data + 4 * i));
+  fill(data, 16 * BENCH_COUNT);
+  BENCH("mat4_mulPoint_n",
+    for (size_t i = 0; i < BENCH_COUNT; i++) ref_mulPoint(m, data + 3 * i),
+    mat4_mulPoint_n(m, data, BENCH_COUNT, 3));
+  (void) out;
+}
+
+int main(int argc, char** argv) {
+  srand(1);
+  test();
+
+  if (argc > 1 && !strcmp(argv[1], "--bench")) {
+    bench();
+  }
+
+  printf(failures ? "maf: %d failures\n" : "maf: ok\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,213 @@
+#include "audio/mix.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Checks the mixing kernels against plain scalar loops.  Every length up to a few vectors is tried so
+// the scalar tails run, and buffers start at an offset into their allocation so loads are unaligned.
+// Pass --bench to time each kernel against its scalar loop as well.
+
+#define MAX_COUNT 67
+#define MAX_OFFSET 3
+#define BENCH_COUNT 256
+#define BENCH_ITERATIONS 200000
+
+static int failures;
+
+static float randomSample(void) {
+  return (float) rand() / RAND_MAX * 2.5f - 1.25f;
+}
+
+static void fill(float* data, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    data[i] = randomSample();
+  }
+}
+
+static void compare(const char* name, const float* a, const float* b, uint32_t count, uint32_t length, uint32_t offset, float tolerance) {
+  for (uint32_t i = 0; i < count; i++) {
+    float scale = fabsf(b[i]) > 1.f ? fabsf(b[i]) : 1.f;
+    if (!(fabsf(a[i] - b[i]) <= tolerance * scale)) {
+      printf("%s: count %u, offset %u, index %u: %g != %g\n", name, length, offset, i, a[i], b[i]);
+      failures++;
+      return;
+    }
+  }
+}
+
+// Reference versions, written the way mix.h's scalar fallbacks are
+
+static void ref_add(float* dst, const float* src, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    dst[i] += src[i];
+  }
+}
+
+static void ref_addRamp(float* dst, const float* src, float from, float to, uint32_t count) {
+  float step = (to - from) / count;
+  for (uint32_t i = 0; i < count; i++) {
+    float gain = from + step * i;
+    dst[2 * i + 0] += src[2 * i + 0] * gain;
+    dst[2 * i + 1] += src[2 * i + 1] * gain;
+  }
+}
+
+static void ref_spread(float* dst, const float* src, float left, float right, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    dst[2 * i + 0] = src[i] * left;
+    dst[2 * i + 1] = src[i] * right;
+  }
+}
+
+static void ref_i16ToF32(float* dst, const int16_t* src, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    dst[i] = src[i] * (1.f / 32768.f);
+  }
+}
+
+static void ref_f32ToI16(int16_t* dst, const float* src, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    float x = src[i] < -1.f ? -1.f : (src[i] > 1.f ? 1.f : src[i]);
+    dst[i] = (int16_t) lrintf(x * 32767.f);
+  }
+}
+
+static void ref_lerp(float* dst, const float* a, const float* b, float t, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    dst[i] = a[i] + (b[i] - a[i]) * t;
+  }
+}
+
+static void ref_convolve(float* dst, const float* src, const float* kernel, uint32_t taps, uint32_t channels) {
+  for (uint32_t c = 0; c < channels; c++) {
+    float sum = 0.f;
+    for (uint32_t k = 0; k < taps; k++) {
+      sum += src[k * channels + c] * kernel[k];
+    }
+    dst[c] = sum;
+  }
+}
+
+static void test(void) {
+  float src[2 * MAX_COUNT + MAX_OFFSET];
+  float other[2 * MAX_COUNT + MAX_OFFSET];
+  float expected[2 * MAX_COUNT + MAX_OFFSET];
+  float actual[2 * MAX_COUNT + MAX_OFFSET];
+  int16_t samples[MAX_COUNT + MAX_OFFSET];
+  int16_t expectedSamples[MAX_COUNT];
+  int16_t actualSamples[MAX_COUNT + MAX_OFFSET];
+
+  for (uint32_t offset = 0; offset <= MAX_OFFSET; offset++) {
+    for (uint32_t count = 0; count <= MAX_COUNT; count++) {
+      float* s = src + offset;
+      float* o = other + offset;
+      float* a = actual + offset;
+      fill(src, 2 * MAX_COUNT + MAX_OFFSET);
+      fill(other, 2 * MAX_COUNT + MAX_OFFSET);
+
+      fill(expected, 2 * count);
+      memcpy(a, expected, 2 * count * sizeof(float));
+      ref_add(expected, s, 2 * count);
+      mix_add(a, s, 2 * count);
+      compare("mix_add", a, expected, 2 * count, count, offset, 0.f);
+
+      // Ramps accumulate the step in SIMD registers, so they only match to within rounding
+      if (count > 0) {
+        float ramps[][2] = { { .25f, .25f }, { 0.f, 1.f }, { 1.f, 0.f } };
+        for (uint32_t r = 0; r < sizeof(ramps) / sizeof(ramps[0]); r++) {
+          fill(expected, 2 * count);
+          memcpy(a, expected, 2 * count * sizeof(float));
+          ref_addRamp(expected, s, ramps[r][0], ramps[r][1], count);
+          mix_addRamp(a, s, ramps[r][0], ramps[r][1], count);
+          compare("mix_addRamp", a, expected, 2 * count, count, offset, 1e-5f);
+        }
+      }
+
+      ref_spread(expected, s, .3f, -.7f, count);
+      mix_spread(a, s, .3f, -.7f, count);
+      compare("mix_spread", a, expected, 2 * count, count, offset, 0.f);
+
+      ref_lerp(expected, s, o, .375f, count);
+      mix_lerp(a, s, o, .375f, count);
+      compare("mix_lerp", a, expected, count, count, offset, 1e-6f);
+
+      for (uint32_t i = 0; i < count + MAX_OFFSET; i++) {
+        samples[i] = (int16_t) (rand() % 65536 - 32768);
+      }
+
+      ref_i16ToF32(expected, samples + offset, count);
+      mix_i16ToF32(a, samples + offset, count);
+      compare("mix_i16ToF32", a, expected, count, count, offset, 0.f);
+
+      ref_f32ToI16(expectedSamples, s, count);
+      mix_f32ToI16(actualSamples + offset, s, count);
+      for (uint32_t i = 0; i < count; i++) {
+        if (actualSamples[offset + i] != expectedSamples[i]) {
+          printf("mix_f32ToI16: count %u, offset %u, index %u: %d != %d\n", count, offset, i, actualSamples[offset + i], expectedSamples[i]);
+          failures++;
+          break;
+        }
+      }
+
+      // Summation order differs between the SIMD and scalar convolutions
+      for (uint32_t channels = 1; channels <= 2; channels++) {
+        for (uint32_t taps = 4; taps * channels <= count; taps += 4) {
+          ref_convolve(expected, s, o, taps, channels);
+          mix_convolve(a, s, o, taps, channels);
+          compare("mix_convolve", a, expected, channels, taps, offset, 1e-5f);
+        }
+      }
+    }
+  }
+}
+
+static double now(void) {
+  struct timespec t;
+  timespec_get(&t, TIME_UTC);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// The sink keeps the compiler from dropping the loops
+#define BENCH(name, reference, simd) do {\
+    double start = now();\
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) { reference; sink += dst[i % BENCH_COUNT]; }\
+    double scalar = now() - start;\
+    start = now();\
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) { simd; sink += dst[i % BENCH_COUNT]; }\
+    double vector = now() - start;\
+    printf("%-14s %8.2f ns scalar %8.2f ns simd %6.2fx\n", name, scalar / BENCH_ITERATIONS * 1e9, vector / BENCH_ITERATIONS * 1e9, scalar / vector);\
+  } while (0)
+
+static void bench(void) {
+  static float src[2 * BENCH_COUNT];
+  static float other[2 * BENCH_COUNT];
+  static float dst[2 * BENCH_COUNT];
+  static int16_t samples[2 * BENCH_COUNT];
+  volatile float sink = 0.f;
+
+  fill(src, 2 * BENCH_COUNT);
+  fill(other, 2 * BENCH_COUNT);
+  fill(dst, 2 * BENCH_COUNT);
+
+  printf("Per buffer of %d stereo frames:\n", BENCH_COUNT);
+  BENCH("add", ref_add(dst, src, 2 * BENCH_COUNT), mix_add(dst, src, 2 * BENCH_COUNT));
+  BENCH("addRamp", ref_addRamp(dst, src, 0.f, 1e-3f, BENCH_COUNT), mix_addRamp(dst, src, 0.f, 1e-3f, BENCH_COUNT));
+  BENCH("spread", ref_spread(dst, src, .3f, .7f, BENCH_COUNT), mix_spread(dst, src, .3f, .7f, BENCH_COUNT));
+  BENCH("lerp", ref_lerp(dst, src, other, .5f, 2 * BENCH_COUNT), mix_lerp(dst, src, other, .5f, 2 * BENCH_COUNT));
+  BENCH("i16ToF32", ref_i16ToF32(dst, samples, 2 * BENCH_COUNT), mix_i16ToF32(dst, samples, 2 * BENCH_COUNT));
+  BENCH("f32ToI16", ref_f32ToI16(samples, src, 2 * BENCH_COUNT), mix_f32ToI16(samples, src, 2 * BENCH_COUNT));
+  BENCH("convolve", ref_convolve(dst, src, other, 32, 2), mix_convolve(dst, src, other, 32, 2));
+}
+
+int main(int argc, char** argv) {
+  srand(1);
+  test();
+
+  if (argc > 1 && !strcmp(argv[1], "--bench")) {
+    bench();
+  }
+
+  printf(failures ? "mix: %d failures\n" : "mix: ok\n", failures);
+  return failures ? 1 : 0;
+}